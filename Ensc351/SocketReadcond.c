@@ -1,139 +1,144 @@
-/* Additional QNX-like functions.  Simon Fraser University -- Copyright (C) 2008-2020, By
- *  - Craig Scratchley
- *  - Zhenwang Yao.
- */
-
-#ifdef __QNXNTO__
-#include <sys/neutrino.h>
-#else
-#include "readcond.h"
-#endif
-
-#include <sys/socket.h>
-#include <sys/time.h>   // for timeval ???
-#include <stdio.h>      // fprintf()
-#include <fcntl.h>
-#include <errno.h>
-#include "VNPE.h"
-
-// a general version of readcond() that also works with socket(pair)s
-int wcsReadcond( int fd,
-              void * buf,
-              int n,
-              int min,
-              int time,
-              int timeout )
-{
-    struct timeval tv, tvHold;
-    int minHold;
-    socklen_t minLenHold=sizeof(minHold);
-    socklen_t tvLenHold=sizeof(tvHold);
-    int bytesRead = 0;
-    int bytesSoFar = 0;
-    int errnoHold = errno;
-
-    if (-1 == getsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tvHold, &tvLenHold)) {
-        if (errno == ENOTSOCK) /* Socket operation on non-socket - documented? */
-            // the fd is not a socket, just try readcond
-            return readcond( fd, buf, n, min, time, timeout);
-        else
-        {
-            // some errors, like bad descriptor, should just be returned.
-            //VNS_errorReporter ("1st getsockopt() in wcsReadcond()", __FILE__, __func__, __LINE__, errno, NULL);
-            return -1;
-        };
-    }
-    if (time != timeout) {
-        fprintf(stderr, "wcsReadcond() requires for sockets that time == timeout\n");
-        errno = EINVAL;
-        return -1;
-    };
-
-    // move below
-    PE(getsockopt(fd, SOL_SOCKET, SO_RCVLOWAT, &minHold, &minLenHold)); // should we return if -1?
-
-    if (min != 0) {
-        if (time != 0) {
-            // add timeout to read() call
-            tv.tv_sec = time/10;
-            tv.tv_usec = time%10 *100000;
-            PE(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)));
-        }
-        else
-            if (min == minHold)
-                return read(fd, buf, n);
-
-        // set socket to grab min bytes before unblocking
-        PE(setsockopt(fd, SOL_SOCKET, SO_RCVLOWAT, &min, sizeof(min)));
-
-        do {
-            do {
-                // need to update timeout
-                bytesRead = read(fd, ((char*) buf) + bytesSoFar, n - bytesSoFar);
-            }
-            while ((bytesRead == -1 && errno == EINTR));
-            if (bytesRead == -1) { // or use switch statement with -1, 0, and default
-                errnoHold = errno;
-                break;
-            }
-            else if (bytesRead)
-                bytesSoFar += bytesRead;
-            else // bytesRead == 0
-                break;
-        }
-        while (bytesSoFar < min);
-        if (bytesRead != -1) // what if errno indicates "Connection Reset by Peer",
-                                // shouldn't we set bytesRead to bytesSoFar (and try to
-                                // remember somehow the error somehow).
-            bytesRead = bytesSoFar;
-    }
-    if( min == 0 || (bytesRead == -1 && errnoHold == EWOULDBLOCK) ) {
-        //(min == 0) or timeout occurred, attempt to read everything off
-        // the socket with a non-blocking read().  If nothing is in the socket,
-        // immediate timeout will trigger and set bytesRead to -1
-
-        int lowat=1;
-        int flags;
-        PE(setsockopt(fd, SOL_SOCKET, SO_RCVLOWAT, &lowat, sizeof(lowat))); // should we return if -1?
-
-        //set non-blocking
-        if( -1==(flags=PE(fcntl(fd, F_GETFL, 0))) ) {
-            return -1;  // if PE doesn't exit()
-        }
-        if( -1 == PE(fcntl(fd, F_SETFL, flags | O_NONBLOCK)) ) {
-            return -1;  // if PE doesn't exit()
-        }
-
-        bytesRead = read(fd, ((char*) buf) + bytesSoFar, n - bytesSoFar);
-        if( bytesRead == -1) {
-            if (errno == EWOULDBLOCK || errno == EAGAIN) {
-                // check with readcond to verify this is the behaviour we want.
-                bytesRead = bytesSoFar;
-            }
-            else
-                errnoHold = errno;
-        }
-        else
-            bytesRead += bytesSoFar;
-        //set blocking
-        if( -1 == PE(fcntl(fd, F_SETFL, flags)) ) {
-            return -1;  // if PE doesn't exit()
-        }
-    }
-
-    //reset the socket
-    if (-1 == setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tvHold, sizeof(tvHold))) {
-        if (errno != EBADF) { // Bad file descriptor (9).  Socket was closed
-            VNS_errorReporter ("setsockopt() resetting the socket", __FILE__, __func__, __LINE__, errno, NULL);
-            // should we do the other setsockopt here?
-            return -1; // if errorReporter doesn't exit()
-        };
-    }
-    else
-        PE(setsockopt(fd, SOL_SOCKET, SO_RCVLOWAT, &minHold, sizeof(minHold)));
-
-    if (bytesRead == -1)
-        errno = errnoHold;   // does this work?  I saw in debugger on QNX after this line executed errno = 0, errnoHold = 11
-    return bytesRead;
-}
-
+/* Additional QNX-like functions.  Simon Fraser University -- Copyright (C) 2008-2020, By
+ *  - Craig Scratchley
+ *  - Zhenwang Yao.
+ */
+
+#ifdef __QNXNTO__
+#include <sys/neutrino.h>
+#else
+#include "readcond.h"
+#endif
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <time.h>       // for clock_gettime()
+#include <stdio.h>      // fprintf()
+#include <errno.h>
+
+// the milliseconds from now until deadline, but not less than 0
+static int msUntil(const struct timespec *deadline)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long ms = (deadline->tv_sec - now.tv_sec) * 1000 + (deadline->tv_nsec - now.tv_nsec) / 1000000;
+    return (ms > 0) ? (int) ms : 0;
+}
+
+// set deadline to time deciseconds from now
+static void restartTimer(struct timespec *deadline, int time)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += time / 10;
+    deadline->tv_nsec += (time % 10) * 100000000L;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_nsec -= 1000000000L;
+        ++deadline->tv_sec;
+    }
+}
+
+// recv() without blocking, treating "nothing there" as 0 bytes.
+//  Return -1 (with errno set) for an error, including when fd is not a socket.
+static int recvNow(int fd, char *buf, int n)
+{
+    int bytesRead;
+    int errnoHold = errno;
+    do
+        bytesRead = recv(fd, buf, n, MSG_DONTWAIT);
+    while (bytesRead == -1 && errno == EINTR);
+    if (bytesRead == -1 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
+        errno = errnoHold;
+        return 0;
+    }
+    return bytesRead;
+}
+
+/* A general version of readcond() that also works with socket(pair)s.
+ *
+ * For sockets, the socket options and flags are left alone.  Each recv() says
+ *  itself whether it may block (MSG_DONTWAIT or MSG_WAITALL), and timeouts are
+ *  waited for with poll(), so a call whose data is already waiting takes a
+ *  single system call. */
+int wcsReadcond( int fd,
+              void * buf,
+              int n,
+              int min,
+              int time,
+              int timeout )
+{
+    char *cbuf = (char*) buf;
+    int bytesSoFar;
+    int errnoHold = errno;
+
+    if (time != timeout) {
+        int type;
+        socklen_t typeLen = sizeof(type);
+        if (-1 == getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &typeLen)) {
+            if (errno == ENOTSOCK) /* Socket operation on non-socket */
+                // the fd is not a socket, just try readcond
+                return readcond( fd, buf, n, min, time, timeout);
+            return -1; // some errors, like bad descriptor, should just be returned.
+        }
+        fprintf(stderr, "wcsReadcond() requires for sockets that time == timeout\n");
+        errno = EINVAL;
+        return -1;
+    };
+
+    // take whatever is already there.  This also finds out whether fd is a socket.
+    bytesSoFar = recvNow(fd, cbuf, n);
+    if (bytesSoFar == -1) {
+        if (errno == ENOTSOCK) { /* Socket operation on non-socket */
+            // the fd is not a socket, just try readcond
+            errno = errnoHold;
+            return readcond( fd, buf, n, min, time, timeout);
+        }
+        return -1;
+    }
+    if (min == 0 || bytesSoFar >= min || bytesSoFar == n)
+        return bytesSoFar;
+
+    if (time == 0) {
+        // wait as long as it takes for min bytes, then take anything else there
+        int bytesRead;
+        do
+            bytesRead = recv(fd, cbuf + bytesSoFar, min - bytesSoFar, MSG_WAITALL);
+        while (bytesRead == -1 && errno == EINTR);
+        if (bytesRead == -1)
+            return -1;
+        bytesSoFar += bytesRead;
+        if (bytesSoFar < min) // the other end has been closed
+            return bytesSoFar;
+    }
+    else {
+        // wait for min bytes, but no more than time deciseconds for the first
+        //  or between any two.  time is an inter-character timer, as with QNX
+        //  (and as SO_RCVTIMEO, which this used to set, gave).
+        struct timespec deadline;
+        struct pollfd pfd = {fd, POLLIN, 0};
+        restartTimer(&deadline, time);
+        while (bytesSoFar < min) {
+            int ready = poll(&pfd, 1, msUntil(&deadline));
+            if (ready == -1) {
+                if (errno == EINTR)
+                    continue;
+                return -1;
+            }
+            if (ready == 0) // timed out
+                return bytesSoFar;
+            int bytesRead = recvNow(fd, cbuf + bytesSoFar, n - bytesSoFar);
+            if (bytesRead == -1)
+                return -1;
+            if (bytesRead == 0) // readable, but nothing to read:  the other end has been closed
+                return bytesSoFar;
+            bytesSoFar += bytesRead;
+            restartTimer(&deadline, time);
+        }
+        return bytesSoFar;
+    }
+
+    if (bytesSoFar < n) {
+        int bytesRead = recvNow(fd, cbuf + bytesSoFar, n - bytesSoFar);
+        if (bytesRead > 0)
+            bytesSoFar += bytesRead;
+    }
+    return bytesSoFar;
+}
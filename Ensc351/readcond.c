@@ -22,7 +22,130 @@ min, time, timeout
 
 #include <termios.h>
 #include <stdio.h>      // fprintf()
+#include <poll.h>
+#include <time.h>       // for clock_gettime()
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>     // for LLONG_MAX
+#include <stdatomic.h>
+#include <pthread.h>
 #include "VNPE.h"
+#include "readcond.h"
+
+/* Devices switched to raw mode by readcondBegin(), so that readcond() can use
+ *  them without changing their termios settings.  rawFd is fd + 1, or 0 if the
+ *  entry is free.  Changed only while holding rawMutex. */
+#define RAW_MAX 16
+static _Atomic int rawFd[RAW_MAX];
+static struct termios rawSaved[RAW_MAX];
+static pthread_mutex_t rawMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int rawIndex(int fd)
+{
+    for (int i = 0; i < RAW_MAX; ++i)
+        if (atomic_load_explicit(&rawFd[i], memory_order_acquire) == fd + 1)
+            return i;
+    return -1;
+}
+
+int readcondBegin(int fd)
+{
+    struct termios termio;
+    int returnVal = -1;
+    pthread_mutex_lock(&rawMutex);
+    if (rawIndex(fd) != -1)
+        returnVal = 0; // already begun
+    else if (0 == tcgetattr(fd, &termio)) {
+        int i = rawIndex(-1); // a free entry
+        if (i == -1)
+            errno = EMFILE;
+        else {
+            rawSaved[i] = termio;
+            cfmakeraw(&termio);
+            // read() never waits, as poll() does the waiting
+            termio.c_cc[VMIN] = 0;
+            termio.c_cc[VTIME] = 0;
+            if (0 == tcsetattr(fd, TCSANOW, &termio)) {
+                atomic_store_explicit(&rawFd[i], fd + 1, memory_order_release);
+                returnVal = 0;
+            }
+        }
+    }
+    pthread_mutex_unlock(&rawMutex);
+    return returnVal;
+}
+
+int readcondEnd(int fd)
+{
+    int returnVal = 0;
+    pthread_mutex_lock(&rawMutex);
+    int i = rawIndex(fd);
+    if (i != -1) {
+        atomic_store_explicit(&rawFd[i], 0, memory_order_release);
+        returnVal = tcsetattr(fd, TCSANOW, &rawSaved[i]);
+    }
+    pthread_mutex_unlock(&rawMutex);
+    return returnVal;
+}
+
+static long long msNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000LL + now.tv_nsec / 1000000;
+}
+
+/* readcond() for a terminal device whose VMIN and VTIME are both 0, so that read()
+ *  never waits.  The waiting is done with poll():  time is an inter-character
+ *  timer, started when the first character arrives (or at once if min is 0),
+ *  and timeout limits the whole call.  Either can end the call before min
+ *  characters have arrived. */
+static int pollReadcond( int fd,
+              char * buf,
+              int n,
+              int min,
+              int time,
+              int timeout )
+{
+    const long long start = msNow();
+    long long lastChar = start;     // when the inter-character timer was (re)started
+    int bytesSoFar = 0;
+    struct pollfd pfd = {fd, POLLIN, 0};
+
+    while (1) {
+        int bytesRead = read(fd, buf + bytesSoFar, n - bytesSoFar);
+        if (bytesRead == -1) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN)
+                return -1;
+            bytesRead = 0;
+        }
+        if (bytesRead > 0) {
+            bytesSoFar += bytesRead;
+            lastChar = msNow();
+        }
+        if (bytesSoFar == n || (min > 0 && bytesSoFar >= min) || (min == 0 && bytesSoFar > 0))
+            return bytesSoFar;
+        if (min == 0 && time == 0 && timeout == 0)
+            return bytesSoFar;
+
+        // wait for the earlier of the two timers, or for ever if neither runs
+        long long wait = LLONG_MAX;
+        long long now = msNow();
+        if (time != 0 && (min == 0 || bytesSoFar > 0))
+            wait = lastChar + time * 100LL - now;
+        if (timeout != 0 && start + timeout * 100LL - now < wait)
+            wait = start + timeout * 100LL - now;
+        if (wait <= 0)
+            return bytesSoFar;
+        int ready = poll(&pfd, 1, (wait == LLONG_MAX) ? -1 : (int) wait);
+        if (ready == -1 && errno != EINTR)
+            return -1;
+        if (ready == 1 && (pfd.revents & (POLLHUP | POLLERR)) && !(pfd.revents & POLLIN))
+            return bytesSoFar; // hung up
+    }
+}
 
 int readcond( int fd,
               void * buf,
@@ -33,6 +156,14 @@ int readcond( int fd,
 {
     int bytesRead;
     int errnoHold = errno;
+            if (rawIndex(fd) != -1) {
+                // switched to raw mode by readcondBegin(), so no need to change the settings
+                bytesRead = pollReadcond(fd, buf, n, min, time, timeout);
+                if (bytesRead != -1)
+                    errno = errnoHold;
+                return bytesRead;
+            }
+
             // fd not a socket, treating it as terminal devices
             struct termios termio;
             struct termios resetTermio;
@@ -58,13 +189,13 @@ int readcond( int fd,
                 bytesRead = read(fd, buf, n);
             }
             else if (time == 0) {
-                // timeout is not zero
-                // do we use select here?
-                // set timeval using timeout
-                // *** not yet implemented ***
-                fprintf(stderr, "Error -- unimplemented part of readcond()\n");
-                errno = EINVAL;
-                return -1;
+                // timeout is not zero, so wait with poll() for min characters or the timeout
+                termio.c_cc[VMIN] = 0;
+                termio.c_cc[VTIME] = 0;
+                PE(tcsetattr(fd, TCSANOW, &termio)); //Apply the new setting instantly
+                bytesRead = pollReadcond(fd, buf, n, min, time, timeout);
+                if (bytesRead == -1)
+                    errnoHold = errno;
             }
             else { // both time and timeout are not zero.
                 int bytesSoFar = 0;
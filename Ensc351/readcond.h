@@ -35,6 +35,13 @@ int readcond( int fd,
               int timeout )
 ;
 
+/* Switch the terminal device fd to raw mode for a session of readcond() calls,
+ *  which then need not change (and restore) its termios settings each time.
+ *  readcondEnd() restores the settings from before readcondBegin().
+ *  Return 0, or -1 with errno set. */
+int readcondBegin(int fd);
+int readcondEnd(int fd);
+
 #ifdef __cplusplus
 }
 #endif
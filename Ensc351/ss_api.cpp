@@ -1,684 +1,1291 @@
-/*********************************************************************
-	SmartState State Machine Code. Do not Distribute. DO NOT EDIT.
-	(c) ApeSoft [www.SmartStateStudio.com]
-**********************************************************************/
-
-//#pragma warning(disable: 4786)
-//#pragma warning(disable: 4290)
-
-#include <iostream>
-
-#include "ss_api.hxx"
-
-#define SS_SERIALISE_BEG_TAG "SS_BEG"
-#define SS_SERIALISE_END_TAG "SS_END"
-
-/***************************************************************************/
-namespace smartstate
-{
-
-using namespace std;
-
-/***************************************************************************/
-Mesg::Mesg()
-{
-	message = 0;
-	wParam  = 0;
-	lParam  = 0;
-}
-
-Mesg::Mesg(unsigned int m, int w, int l)
-{
-	message = m;
-	wParam  = w;
-	lParam  = l;
-}
-
-
-/***************************************************************************/
-StateMgr::StateMgr(const string& name)
-: myStatus(false),
-  myName(name),
-  myBusyStatus(false)
-{
-	myDebugLogStream = &cout;
-}
-
-StateMgr::~StateMgr()
-{
-	//destroy all conc machines.
-	BaseStateList::iterator it = myConcStateList.begin();
-	BaseStateList::iterator end = myConcStateList.end();
-
-	for(; it != end; it++)
-	{
-		delete (*it);
-	}
-}
-
-/***************************************************************************/
-void StateMgr::start()
-{
-	myActiveStatesList.clear();
-
-	//fill all initial active states.
-	BaseStateList::iterator it = myConcStateList.begin();
-	BaseStateList::iterator end = myConcStateList.end();
-	for(; it != end; it++)
-	{
-		(*it)->getInitialStates(myActiveStatesList);
-	}
-
-	//call onEntry on initial states and its links
-	BaseStateList tree;
-	constructInitialTree(tree);
-
-	it = tree.begin();
-	end = tree.end();
-	for(; it != end; it++)
-	{
-		(*it)->onEntry();
-	}
-
-	//if any posted internal message (from onEntry of initial state) fire now
-	sendPostedMessages();
-
-	myStatus = true; //running
-}
-
-/***************************************************************************/
-void StateMgr::postEvent(unsigned int message, int wParam, int lParam)
-// throw (std::string) // removed as no longer allowed in C++17
-{
-	if(myStatus == false)
-	{
-		throw std::string("Not Running");
-	}
-
-	if(myBusyStatus)
-	{
-		PostedMesg postmesg;
-		postmesg.stateName = "*"; //to all
-		postmesg.mesg.message = message;
-		postmesg.mesg.wParam = wParam;
-		postmesg.mesg.lParam = lParam;
-
-		myPostedMesgList.push_back(postmesg); 
-		return;
-	}
-	
-	myBusyStatus = true;
-
-	myPostedMesgList.clear(); //empty the q
-
-	Mesg aMesg(message, wParam, lParam);
-
-	fireMessage(aMesg);
-
-	//if any posted internal message fire now
-	sendPostedMessages();
-
-	myBusyStatus = false;
-}
-
-/***************************************************************************/
-void StateMgr::sendPostedMessages()
-{
-	PostedMesgList::iterator pIt = myPostedMesgList.begin();
-	for(; pIt != myPostedMesgList.end(); pIt++)
-	{
-		if((*pIt).stateName == "*")
-		{
-			fireMessage((*pIt).mesg, 0); //to all
-			continue;
-		}
-
-		BaseStateMap::iterator itM = myStateMap.find((*pIt).stateName);
-		if(itM == myStateMap.end())
-		{	//not found.
-			myBusyStatus = false;
-			throw std::string("Unable to deliver message to " + (*pIt).stateName + " , state not found.");
-		}
-
-		BaseState* pState = (*itM).second;
-
-		fireMessage((*pIt).mesg, pState); 
-	}
-}
-
-/***************************************************************************/
-void StateMgr::reInit()
-{
-	start();
-}
-
-/***************************************************************************/
-bool StateMgr::isRunning() const
-{
-	return myStatus;
-}
-
-/***************************************************************************/
-void StateMgr::serialise(ostream& outStream) const
-{
-	//Save all active states
-	outStream << SS_SERIALISE_BEG_TAG << " " 
-		<< myActiveStatesList.size() << " ";
-
-	BaseStateList::const_iterator it = myActiveStatesList.begin();
-	BaseStateList::const_iterator end = myActiveStatesList.end();
-	for(; it != end; it++)
-	{
-		const BaseState* pState = (*it);
-
-		outStream << pState->getName().c_str() << " ";
-	}
-
-	outStream << SS_SERIALISE_END_TAG << " ";
-}
-
-/***************************************************************************/
-void StateMgr::serialise(istream& inStream)
-{
-	//Load all active states
-	string item;
-
-	inStream >> item;
-	if(item != SS_SERIALISE_BEG_TAG)
-		throw std::string("Not a valid input stream. Cannot serialise");
-
-	myStatus = false; //not running
-	myActiveStatesList.clear();
-
-	int nbActiveStates = 0;
-	inStream >> nbActiveStates;
-	if(nbActiveStates <= 0)
-	{
-		throw std::string("No active states found in input stream. Cannot serialise");
-	}
-
-	for(int i=0; i<nbActiveStates; i++)
-	{
-		inStream >> item;
-
-		//find the state
-		BaseStateMap::iterator it = myStateMap.find(item);
-		if(it == myStateMap.end())
-		{
-			myActiveStatesList.clear();
-			throw std::string("Invalid state found in input stream : " + item);
-		}
-
-		BaseState* pState = (*it).second;
-
-		myActiveStatesList.push_back(pState);
-	}
-
-	inStream >> item;
-	if(item != SS_SERIALISE_END_TAG)
-	{
-		myActiveStatesList.clear();
-		throw std::string("Not a valid input stream. Cannot serialise");
-	}
-
-	myStatus = true; //running
-}
-
-/***************************************************************************/
-void StateMgr::setDebugLog(ostream* logStream)
-{
-	myDebugLogStream = logStream;
-}
-
-/***************************************************************************/
-void StateMgr::fireMessage(const Mesg& mesg, BaseState* target)
-{
-	try
-	{
-		BaseStateList tempList = myActiveStatesList;
-		BaseState* pState;
-
-		BaseStateList::iterator it = tempList.begin();
-		BaseStateList::iterator end = tempList.end();
-		for(; it != end; it++)
-		{
-			pState = (*it);
-
-			//onMessage may change the contents of activestatelist.
-			//so send only if the state is still in active list
-			if(BaseState::isInList(pState, myActiveStatesList))
-			{
-				if(target == 0)
-				{
-					pState->onMessage(mesg);
-				}
-				else
-				{
-					if(pState->isParent(target))
-					{
-						pState->onMessage(mesg);
-					}
-				}
-			}
-		}
-	}
-	catch(std::string&)
-	{
-		throw;
-	}
-	catch(...)
-	{
-		throw std::string("Internal Error, Unexpected");
-	}
-}
-
-/***************************************************************************/
-void StateMgr::registerState(const string& stateName, BaseState* stateRef)
-{
-	myStateMap[stateName] = stateRef;
-}
-
-/***************************************************************************/
-const BaseState* StateMgr::executeExit(const string& currState, const string& nextState)
-{
-	BaseStateMap::iterator it = myStateMap.find(currState);
-	if(it == myStateMap.end())
-	{
-		throw std::string("Invalid current state : " + currState);
-	}
-
-	BaseState* caller = (*it).second;
-
-	//FinalState
-	if(nextState == "FinalState")
-	{
-		//finished
-		myActiveStatesList.clear();
-		caller->onExit();
-		return 0; //so that executeEntry wont call any thing
-	}
-
-	it = myStateMap.find(nextState);
-	if(it == myStateMap.end())
-	{
-		throw std::string("Invalid next state : " + nextState);
-	}
-
-	BaseState* nextStateRef = (*it).second;
-
-	const BaseState* root = getRoot(caller, nextStateRef);
-
-	//remove this state (and its children if any) from active list
-	removeActiveStates(caller, root);
-
-	BaseState* pState = caller;
-	while(pState != root)
-	{
-		pState->onExit();
-		pState = pState->getParent();
-
-		if(pState == 0)
-		{
-			throw std::string("Internal Logic Error");
-		}
-	}
-	
-	return root;
-}
-
-/***************************************************************************/
-void StateMgr::executeEntry(const BaseState* root, const string& nextState)
-{
-	if(root == 0 || nextState == "FinalState")
-	{
-		myStatus = false; //not running
-		return;
-	}
-
-	BaseStateMap::iterator it = myStateMap.find(nextState);
-	if(it == myStateMap.end())
-	{
-		throw std::string("Invalid next state : " + nextState);
-	}
-
-	BaseState* nextStateRef = (*it).second;
-
-	//Fill from root to nextStateRef including the links in between
-	//if the nextState is not a leaf.. get all its initial states including
-	//the links in between in the tree. Duplication handled by this method.
-	BaseStateList tree;
-	constructTree(root, nextStateRef, tree);
-
-	//Add the new State (if leaf or its kids) to active list
-	nextStateRef->getInitialStates(myActiveStatesList);
-
-	//Call onEntry on each one in the list.
-	BaseStateList::iterator lit = tree.begin();
-	BaseStateList::iterator end = tree.end();
-	for(; lit != end; lit++)
-	{
-		(*lit)->onEntry();
-	}
-}
-
-/***************************************************************************/
-const BaseState* StateMgr::getRoot(const BaseState* leaf1, const BaseState* leaf2)
-{
-	const BaseState* pState = leaf1;
-	const BaseState* aState;
-	
-	while(pState) //when it reaches top it will be 0
-	{
-		aState = leaf2;
-		while(aState)//when it reaches top it will be 0
-		{
-			if(pState == aState) 
-			{	//common root
-				return pState;
-			}
-
-			aState = aState->getParent();
-		}
-
-		pState = pState->getParent();
-	}
-
-	//no common root
-	std::string err = "Invalid transition from ";
-	err += leaf1->getName(); 
-	err += " to ";
-	err += leaf1->getName();
-	err += ", no common super state.";
-	throw err;
-
-	return 0; 
-}
-
-/***************************************************************************/
-void StateMgr::constructTree(const BaseState* root, const BaseState* state, BaseStateList& tree)
-{
-	//if the state passed is not a leaf.. get all its initial states including
-	//the links in between in the tree. Duplication handled here.
-	const BaseState* pState = state;
-	while(pState != root)
-	{
-		tree.push_front(const_cast<BaseState*>(pState)); //store at top
-		pState = pState->getParent();
-
-		if(pState == 0)
-		{
-			throw std::string("Internal Logic Error");
-		}
-	}
-
-	BaseStateList iniStatesList;
-	state->getInitialStates(iniStatesList);
-	
-	BaseStateList::iterator it = iniStatesList.begin();
-	BaseStateList::iterator end = iniStatesList.end();
-
-	for(; it != end; it++)
-	{
-		pState = (*it); //the initial state
-		BaseStateList aTree;
-
-		while(pState != state) //till state
-		{
-			if(!BaseState::isInList(pState, tree)) //avoid duplication
-			{
-				aTree.push_front(const_cast<BaseState*>(pState)); //store at top
-			}
-			
-			pState = pState->getParent();
-		}
-
-		//add to original tree
-		tree.insert(tree.end(), aTree.begin(), aTree.end());
-	}
-}
-
-/***************************************************************************/
-void StateMgr::constructInitialTree(BaseStateList& tree)
-{	//should be called only from start
-
-	BaseStateList::iterator it = myActiveStatesList.begin();
-	BaseStateList::iterator end = myActiveStatesList.end();
-
-	BaseState* pState;
-	for(; it != end; it++)
-	{
-		pState = (*it); //the initial state
-		BaseStateList aTree;
-
-		while(pState != 0) //till top
-		{
-			if(!BaseState::isInList(pState, tree)) //avoid duplication
-			{
-				aTree.push_front(const_cast<BaseState*>(pState)); //store at top
-			}
-			
-			pState = pState->getParent();
-		}
-
-		tree.insert(tree.end(), aTree.begin(), aTree.end());
-	}
-}
-
-/***************************************************************************/
-void StateMgr::removeActiveStates(const BaseState* state, const BaseState* root)
-{
-	//remove caller first
-	BaseStateList::iterator it = myActiveStatesList.begin();
-	BaseStateList::iterator end = myActiveStatesList.end();
-	for(; it != end; it++)
-	{
-		if((*it) == state)
-		{
-			myActiveStatesList.erase(it);
-			break;
-		}
-	}
-
-	//remove all its sub states which are active now..
-	//remove its parents active state also till root.
-	const BaseState* pState = state;
-	while(pState != root)
-	{
-		it = myActiveStatesList.begin();
-		while(it != myActiveStatesList.end())
-		{
-			if((*it)->isParent(pState))
-			{
-				//Store history information (only if parent is a super state and history is set)
-				BaseState* pParentState = (*it)->getParent();
-				if((pParentState->getType() == eSuper) && (pParentState->myHistory == true))
-				{
-					pParentState->myHistoryState = (*it);
-				}
-
-				it = myActiveStatesList.erase(it);
-			}
-			else
-			{
-				it++;
-			}
-		}
-
-		pState = pState->getParent();
-
-		if(pState == 0)
-		{
-			throw std::string("Internal Logic Error 11");
-		}
-	}
-}
-
-/***************************************************************************/
-void StateMgr::queueMessage(PostedMesg postMsg)
-{
-	myPostedMesgList.push_back(postMsg);
-}
-
-/***************************************************************************/
-void StateMgr::debugLog(const string& str)
-{
-	if (myDebugLogStream)	// added by Craig Scratchley, Simon Fraser University, Canada
-							// set myDebugLogStream to NULL if you want to turn off the log
-		(*myDebugLogStream) << "[SMARTSTATE_DEBUG] " << str << endl;
-}
-
-/***************************************************************************/
-/***************************************************************************/
-/***************************************************************************/
-BaseState::BaseState(const string& name, BaseState* parent, StateMgr* mgr)
-: myName(name),
-  myParent(parent),
-  myType(eSub),
-  myMgr(mgr),
-  myHistory(false),
-  myHistoryState(0)
-{
-	myMgr->registerState(myName, this);
-}
-
-BaseState::BaseState()
-{
-}
-
-BaseState::~BaseState()
-{
-	//destroy all sub states.
-	BaseStateList::iterator it = mySubStates.begin();
-	BaseStateList::iterator end = mySubStates.end();
-
-	for(; it != end; it++)
-	{
-		delete (*it);
-	}
-}
-
-/***************************************************************************/
-bool BaseState::isParent(const BaseState* state) const
-{
-	if(myParent == state)
-	{
-		return true;
-	}
-
-	if(myParent == 0)
-	{	//top most
-		return false;
-	}
-
-	return myParent->isParent(state);
-}
-
-/***************************************************************************/
-void BaseState::getInitialStates(BaseStateList& iniList) const
-{
-	if(myType == eSuper)
-	{
-		//return history state if valid
-		if(myHistoryState)
-		{
-			myHistoryState->getInitialStates(iniList);
-		}
-		else
-		{
-			(*mySubStates.begin())->getInitialStates(iniList);
-		}
-	}
-	else if(myType == eConc)
-	{
-		BaseStateList::const_iterator it = mySubStates.begin();
-		BaseStateList::const_iterator end = mySubStates.end();
-		for(; it != end; it++)
-		{
-			(*it)->getInitialStates(iniList);
-		}
-	}
-	else //sub
-	{
-		iniList.push_back((BaseState*)this);
-	}
-}
-
-/***************************************************************************/
-void BaseState::onMessage(const Mesg& mesg)
-{
-	//does nothing
-}
-
-/***************************************************************************/
-void BaseState::setType(EStateType type)
-{
-	myType = type;
-}
-
-/***************************************************************************/
-void BaseState::onEntry()
-{
-	//does nothing
-}
-
-/***************************************************************************/
-void BaseState::onExit()
-{
-	//does nothing
-}
-
-/***************************************************************************/
-void BaseState::postMessage(unsigned int message, int wParam, int lParam)
-{
-	//find conc state name.
-	BaseState* pState = this;
-	BaseState* parent = this;
-	while(parent) //till root
-	{
-		pState = parent;
-		parent = pState->getParent();
-	}
-
-	const string& concName = pState->getName();
-
-	PostedMesg postmesg;
-	postmesg.stateName = concName;
-	postmesg.mesg.message = message;
-	postmesg.mesg.wParam = wParam;
-	postmesg.mesg.lParam = lParam;
-
-	myMgr->queueMessage(postmesg);
-}
-
-/***************************************************************************/
-void BaseState::postMessage(string targetState, unsigned int message, int wParam, int lParam)
-{
-	PostedMesg postmesg;
-	postmesg.stateName = targetState;
-
-	postmesg.mesg.message = message;
-	postmesg.mesg.wParam = wParam;
-	postmesg.mesg.lParam = lParam;
-
-	myMgr->queueMessage(postmesg);
-}
-
-/***************************************************************************/
-bool BaseState::isInList(const BaseState* state, const BaseStateList& aList)
-{
-	BaseStateList::const_iterator it = aList.begin();
-	BaseStateList::const_iterator end = aList.end();
-
-	for(; it != end; it++)
-	{
-		if((*it) == state)
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-
-}
+/*********************************************************************
+	SmartState State Machine Code. Do not Distribute. DO NOT EDIT.
+	(c) ApeSoft [www.SmartStateStudio.com]
+**********************************************************************/
+
+//#pragma warning(disable: 4786)
+//#pragma warning(disable: 4290)
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdlib.h>	// for atoi(), strtoull()
+#include <string.h>	// for strcmp()
+#include <cstddef>	// for std::max_align_t
+
+#include "ss_api.hxx"
+
+#define SS_SERIALISE_BEG_TAG "SS_BEG"
+#define SS_SERIALISE_END_TAG "SS_END"
+
+/***************************************************************************/
+namespace smartstate
+{
+
+using namespace std;
+
+/***************************************************************************/
+Mesg::Mesg()
+{
+	message = 0;
+	wParam  = 0;
+	lParam  = 0;
+}
+
+Mesg::Mesg(unsigned int m, int w, int l)
+{
+	message = m;
+	wParam  = w;
+	lParam  = l;
+}
+
+
+/***************************************************************************/
+StateMgr::StateMgr(const string& name)
+: myArenaUsed(SS_ARENA_BLOCK),
+  myStatus(false),
+  myPostedHead(0),
+  myPostedCount(0),
+  myName(name),
+  myBusyStatus(false),
+  myTraceRing(0),
+  myProfile(0),
+  myTraceFlags(0)
+{
+	myDebugLogStream = &cout;
+}
+
+StateMgr::~StateMgr()
+{
+	//destroy all conc machines.
+	BaseStateList::iterator it = myConcStateList.begin();
+	BaseStateList::iterator end = myConcStateList.end();
+
+	for(; it != end; it++)
+	{
+		delete (*it);
+	}
+
+	//and then the storage they were in.
+	for(vector<char*>::size_type i = 0; i < myArenaBlocks.size(); i++)
+	{
+		delete[] myArenaBlocks[i];
+	}
+}
+
+/***************************************************************************/
+void* StateMgr::allocateState(size_t size)
+{
+	const size_t align = alignof(std::max_align_t);
+	size = (size + align - 1) & ~(align - 1);
+
+	if(size > SS_ARENA_BLOCK)
+	{	//a block of its own, before the current one.
+		char* block = new char[size];
+		myArenaBlocks.insert(myArenaBlocks.end() - (myArenaBlocks.empty() ? 0 : 1), block);
+		return block;
+	}
+
+	if(myArenaUsed + size > SS_ARENA_BLOCK)
+	{
+		myArenaBlocks.push_back(new char[SS_ARENA_BLOCK]);
+		myArenaUsed = 0;
+	}
+
+	void* state = myArenaBlocks.back() + myArenaUsed;
+	myArenaUsed += size;
+	return state;
+}
+
+/***************************************************************************/
+void StateMgr::start()
+{
+	clearActiveStates();
+	myPostedHead = myPostedCount = 0; //empty the q
+
+	//fill all initial active states.
+	BaseStateList::iterator it = myConcStateList.begin();
+	BaseStateList::iterator end = myConcStateList.end();
+	for(; it != end; it++)
+	{
+		addInitialStates(*it);
+	}
+
+	//call onEntry on initial states and its links
+	BaseStateList& tree = myTreeList;
+	tree.clear();
+	constructInitialTree(tree);
+
+	it = tree.begin();
+	end = tree.end();
+	for(; it != end; it++)
+	{
+		(*it)->onEntry();
+	}
+
+	//if any posted internal message (from onEntry of initial state) fire now
+	sendPostedMessages();
+
+	myStatus = true; //running
+}
+
+/***************************************************************************/
+void StateMgr::postEvent(unsigned int message, int wParam, int lParam)
+// throw (std::string) // removed as no longer allowed in C++17
+{
+	if(myStatus == false)
+	{
+		throw std::string("Not Running");
+	}
+
+	if(myBusyStatus)
+	{
+		PostedMesg postmesg;
+		postmesg.stateId = eAllStates; //to all
+		postmesg.mesg.message = message;
+		postmesg.mesg.wParam = wParam;
+		postmesg.mesg.lParam = lParam;
+
+		queueMessage(postmesg);
+		return;
+	}
+	
+	myBusyStatus = true;
+
+	myPostedHead = myPostedCount = 0; //empty the q
+
+	Mesg aMesg(message, wParam, lParam);
+
+	try
+	{
+		fireMessage(aMesg);
+
+		//if any posted internal message fire now
+		sendPostedMessages();
+	}
+	catch(...)
+	{
+		myBusyStatus = false;
+		throw;
+	}
+
+	myBusyStatus = false;
+}
+
+/***************************************************************************/
+void StateMgr::sendPostedMessages()
+{
+	//messages may be posted while these are handled, so take each one
+	//out of the ring before it is fired.
+	while(myPostedCount > 0)
+	{
+		PostedMesg postmesg = myPostedMesgs[myPostedHead];
+		myPostedHead = (myPostedHead + 1) % SS_POSTED_MESG_MAX;
+		myPostedCount--;
+
+		if(postmesg.stateId == eAllStates)
+		{
+			fireMessage(postmesg.mesg, 0); //to all
+			continue;
+		}
+
+		if(postmesg.stateId < 0 || postmesg.stateId >= (int) myStates.size())
+		{	//not found.
+			myBusyStatus = false;
+			throw std::string("Unable to deliver message, state not found.");
+		}
+
+		fireMessage(postmesg.mesg, myStates[postmesg.stateId]);
+	}
+}
+
+/***************************************************************************/
+void StateMgr::reInit()
+{
+	//forget history, as a newly constructed machine would have none.
+	for(BaseStateList::size_type i = 0; i < myStates.size(); i++)
+	{
+		myStates[i]->myHistoryState = 0;
+	}
+
+	start();
+}
+
+/***************************************************************************/
+bool StateMgr::isRunning() const
+{
+	return myStatus;
+}
+
+/***************************************************************************/
+void StateMgr::serialise(ostream& outStream) const
+{
+	//Save all active states
+	outStream << SS_SERIALISE_BEG_TAG << " " 
+		<< myActiveStatesList.size() << " ";
+
+	BaseStateList::const_iterator it = myActiveStatesList.begin();
+	BaseStateList::const_iterator end = myActiveStatesList.end();
+	for(; it != end; it++)
+	{
+		const BaseState* pState = (*it);
+
+		outStream << pState->getName() << " ";
+	}
+
+	outStream << SS_SERIALISE_END_TAG << " ";
+}
+
+/***************************************************************************/
+void StateMgr::serialise(istream& inStream)
+{
+	//Load all active states
+	string item;
+
+	inStream >> item;
+	if(item != SS_SERIALISE_BEG_TAG)
+		throw std::string("Not a valid input stream. Cannot serialise");
+
+	myStatus = false; //not running
+	clearActiveStates();
+
+	int nbActiveStates = 0;
+	inStream >> nbActiveStates;
+	if(nbActiveStates <= 0)
+	{
+		throw std::string("No active states found in input stream. Cannot serialise");
+	}
+
+	for(int i=0; i<nbActiveStates; i++)
+	{
+		inStream >> item;
+
+		//find the state
+		BaseState* pState = findState(item);
+		if(pState == 0)
+		{
+			clearActiveStates();
+			throw std::string("Invalid state found in input stream : " + item);
+		}
+
+		myActiveStatesList.push_back(pState);
+		myActiveFlags[pState->getId()] = true;
+	}
+
+	inStream >> item;
+	if(item != SS_SERIALISE_END_TAG)
+	{
+		clearActiveStates();
+		throw std::string("Not a valid input stream. Cannot serialise");
+	}
+
+	myStatus = true; //running
+}
+
+/***************************************************************************/
+size_t StateMgr::snapshot(void* buf, size_t n) const
+{
+	//the number of states, the history of each, then the active states
+	size_t size = (1 + myStates.size() + 1 + myActiveStatesList.size()) * sizeof(int16_t);
+	if(size > n)
+		return 0;
+
+	int16_t* item = (int16_t*) buf;
+	*item++ = myStates.size();
+	for(BaseStateList::size_type i = 0; i < myStates.size(); i++)
+	{
+		const BaseState* history = myStates[i]->myHistoryState;
+		*item++ = history ? history->getId() : eNoState;
+	}
+
+	*item++ = myActiveStatesList.size();
+	BaseStateList::const_iterator it = myActiveStatesList.begin();
+	BaseStateList::const_iterator end = myActiveStatesList.end();
+	for(; it != end; it++)
+	{
+		*item++ = (*it)->getId();
+	}
+
+	return size;
+}
+
+/***************************************************************************/
+void StateMgr::restore(const void* buf, size_t n)
+{
+	const int16_t* first = (const int16_t*) buf;
+	const int16_t* last = first + n / sizeof(int16_t);
+	const int nbStates = myStates.size();
+
+	//check all of it before changing anything, so that a bad snapshot
+	//leaves the machine as it was.
+	if(n < 2 * sizeof(int16_t) || first[0] != nbStates || first + 1 + nbStates >= last)
+		throw std::string("Not a snapshot of this machine. Cannot restore");
+
+	const int16_t* history = first + 1;
+	for(int i = 0; i < nbStates; i++)
+	{
+		if(history[i] != eNoState && (history[i] < 0 || history[i] >= nbStates))
+			throw std::string("Invalid history found in snapshot. Cannot restore");
+	}
+
+	const int16_t* active = history + nbStates + 1;
+	int nbActiveStates = active[-1];
+	if(nbActiveStates <= 0 || active + nbActiveStates > last)
+		throw std::string("No active states found in snapshot. Cannot restore");
+
+	for(int i = 0; i < nbActiveStates; i++)
+	{
+		if(active[i] < 0 || active[i] >= nbStates)
+			throw std::string("Invalid state found in snapshot. Cannot restore");
+	}
+
+	myStatus = false; //not running
+	clearActiveStates();
+	myPostedCount = 0;
+	myBusyStatus = false;
+
+	for(int i = 0; i < nbStates; i++)
+	{
+		myStates[i]->myHistoryState = (history[i] == eNoState) ? 0 : myStates[history[i]];
+	}
+
+	for(int i = 0; i < nbActiveStates; i++)
+	{
+		myActiveStatesList.push_back(myStates[active[i]]);
+		myActiveFlags[active[i]] = true;
+	}
+
+	myStatus = true; //running
+}
+
+/***************************************************************************/
+void StateMgr::setDebugLog(ostream* logStream)
+{
+	myDebugLogStream = logStream;
+}
+
+/***************************************************************************/
+void StateMgr::setTrace(TraceRing* ring)
+{
+	myTraceRing = ring;
+	myTraceFlags = (myTraceFlags & ~eTraceToRing) | (ring ? eTraceToRing : 0);
+}
+
+/***************************************************************************/
+void StateMgr::traceRecord(int state, unsigned int message, ETracePoint point)
+{
+	if(myTraceFlags & eTraceToRing)
+	{
+		myTraceRing->put(state, message, point);
+	}
+	if(myTraceFlags & eTraceToProfile)
+	{
+		profilePoint(state, message, point);
+	}
+}
+
+/***************************************************************************/
+void StateMgr::setProfile(StateProfile* profile)
+{
+	myProfile = profile;
+	myTraceFlags = (myTraceFlags & ~eTraceToProfile) | (profile ? eTraceToProfile : 0);
+	if(profile)
+	{
+		profile->myDwells.resize(myStates.size());
+		profile->myTransitions.resize(StateProfile::eTransitionSlots);
+	}
+}
+
+/***************************************************************************/
+static long long nowUsecs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/***************************************************************************/
+void StateMgr::profilePoint(int state, unsigned int message, ETracePoint point)
+{
+	switch(point)
+	{
+		case eTraceOnEntry:
+			myProfile->myDwells[state].enteredUsecs = nowUsecs();
+			break;
+
+		case eTraceOnExit:
+		{
+			StateProfile::Dwell& dwell = myProfile->myDwells[state];
+			if(dwell.enteredUsecs < 0)
+				break;
+			unsigned long long usecs = nowUsecs() - dwell.enteredUsecs;
+			dwell.enteredUsecs = -1;
+			dwell.count++;
+			dwell.totalUsecs += usecs;
+			int bucket = 0;
+			while(usecs && bucket < StateProfile::eBuckets - 1)
+			{
+				usecs >>= 1;
+				bucket++;
+			}
+			dwell.buckets[bucket]++;
+			break;
+		}
+
+		case eTraceExecEffect:
+		{
+			//executeExit has set myTarget, unless the transition is internal
+			uint64_t key = ((uint64_t) (uint16_t) state << 32) | ((uint64_t) (message & 0xffff) << 16)
+				| (uint16_t) myProfile->myTarget;
+			myProfile->myTarget = eNoState;
+
+			//the slot of key, or the first empty one after its hash
+			const unsigned int mask = StateProfile::eTransitionSlots - 1;
+			unsigned int slot = (unsigned int) ((key * 0x9e3779b97f4a7c15ULL) >> 40) & mask;
+			for(unsigned int probes = 0; probes <= mask; probes++, slot = (slot + 1) & mask)
+			{
+				StateProfile::Transition& transition = myProfile->myTransitions[slot];
+				if(transition.count == 0)
+					transition.key = key;
+				if(transition.key == key)
+				{
+					transition.count++;
+					return;
+				}
+			}
+			myProfile->myLostTransitions++;
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+/***************************************************************************/
+void StateMgr::dumpProfile(ostream& outStream, const StateProfile& profile) const
+{
+	outStream << "profile " << myName << "\n";
+	for(BaseStateList::size_type i = 0; i < myStates.size() && i < profile.myDwells.size(); i++)
+	{
+		const StateProfile::Dwell& dwell = profile.myDwells[i];
+		if(dwell.count == 0)
+			continue;
+
+		outStream << "state " << myStates[i]->getName() << " " << dwell.count << " " << dwell.totalUsecs;
+		for(int b = 0; b < StateProfile::eBuckets; b++)
+		{
+			if(dwell.buckets[b])
+				outStream << " " << b << ":" << dwell.buckets[b];
+		}
+		outStream << "\n";
+	}
+
+	//in the order of their keys, as the slots are in no order
+	map<uint64_t, unsigned int> transitions;
+	for(vector<StateProfile::Transition>::size_type i = 0; i < profile.myTransitions.size(); i++)
+	{
+		if(profile.myTransitions[i].count)
+			transitions[profile.myTransitions[i].key] = profile.myTransitions[i].count;
+	}
+
+	map<uint64_t, unsigned int>::const_iterator it = transitions.begin();
+	map<uint64_t, unsigned int>::const_iterator end = transitions.end();
+	for(; it != end; it++)
+	{
+		int from = (int16_t) (it->first >> 32);
+		unsigned int message = (it->first >> 16) & 0xffff;
+		int to = (int16_t) it->first;
+
+		outStream << "transition " << myStates[from]->getName() << " " << message << " ";
+		if(to == eFinalState)
+			outStream << "FinalState";
+		else if(to == eNoState)
+			outStream << "internal";
+		else
+			outStream << myStates[to]->getName();
+		outStream << " " << it->second << "\n";
+	}
+	if(profile.myLostTransitions)
+	{
+		outStream << "lost " << profile.myLostTransitions << " transitions\n";
+	}
+	outStream.flush();
+}
+
+/***************************************************************************/
+//sum the lines of a file written by dumpProfile: "state name count usecs b:n ..."
+//and "transition from message to count".
+struct ProfileSums
+{
+	map<string, unsigned long long> stateCounts;
+	map<string, unsigned long long> stateUsecs;
+	map<string, map<int, unsigned long long> > stateBuckets;
+	map<string, unsigned long long> transitions;
+};
+
+static void readProfiles(istream& inStream, ProfileSums& sums)
+{
+	string line;
+	while(std::getline(inStream, line))
+	{
+		std::istringstream items(line);
+		string kind;
+		items >> kind;
+		if(kind == "state")
+		{
+			string name;
+			unsigned long long count = 0, usecs = 0;
+			items >> name >> count >> usecs;
+			sums.stateCounts[name] += count;
+			sums.stateUsecs[name] += usecs;
+			string bucket;
+			while(items >> bucket)
+			{
+				string::size_type colon = bucket.find(':');
+				if(colon != string::npos)
+					sums.stateBuckets[name][atoi(bucket.c_str())] += strtoull(bucket.c_str() + colon + 1, 0, 10);
+			}
+		}
+		else if(kind == "transition")
+		{
+			string from, message, to;
+			unsigned long long count = 0;
+			items >> from >> message >> to >> count;
+			sums.transitions[from + " " + message + " " + to] += count;
+		}
+	}
+}
+
+/***************************************************************************/
+void StateProfile::diff(istream& before, istream& after, ostream& outStream)
+{
+	ProfileSums sums[2];
+	readProfiles(before, sums[0]);
+	readProfiles(after, sums[1]);
+
+	//every state and transition in either
+	map<string, unsigned long long> states = sums[0].stateCounts;
+	states.insert(sums[1].stateCounts.begin(), sums[1].stateCounts.end());
+	map<string, unsigned long long> transitions = sums[0].transitions;
+	transitions.insert(sums[1].transitions.begin(), sums[1].transitions.end());
+
+	map<string, unsigned long long>::const_iterator it;
+	for(it = states.begin(); it != states.end(); it++)
+	{
+		const string& name = it->first;
+		unsigned long long count[2], usecs[2];
+		for(int i = 0; i < 2; i++)
+		{
+			count[i] = sums[i].stateCounts[name];
+			usecs[i] = sums[i].stateUsecs[name];
+		}
+		if(count[0] == count[1] && usecs[0] == usecs[1])
+			continue;
+
+		outStream << "state " << name << ": active " << count[0] << " -> " << count[1]
+			<< " times, " << usecs[0] << " -> " << usecs[1] << " usecs, mean "
+			<< (count[0] ? usecs[0] / count[0] : 0) << " -> " << (count[1] ? usecs[1] / count[1] : 0) << "\n";
+
+		//the buckets (powers of two of microseconds) that changed
+		map<int, unsigned long long> buckets = sums[0].stateBuckets[name];
+		buckets.insert(sums[1].stateBuckets[name].begin(), sums[1].stateBuckets[name].end());
+		map<int, unsigned long long>::const_iterator b;
+		for(b = buckets.begin(); b != buckets.end(); b++)
+		{
+			unsigned long long n0 = sums[0].stateBuckets[name][b->first];
+			unsigned long long n1 = sums[1].stateBuckets[name][b->first];
+			if(n0 != n1)
+				outStream << "    under " << (1ULL << b->first) << " usecs: " << n0 << " -> " << n1 << "\n";
+		}
+	}
+
+	for(it = transitions.begin(); it != transitions.end(); it++)
+	{
+		unsigned long long n0 = sums[0].transitions[it->first];
+		unsigned long long n1 = sums[1].transitions[it->first];
+		if(n0 != n1)
+			outStream << "transition " << it->first << ": " << n0 << " -> " << n1 << "\n";
+	}
+	outStream.flush();
+}
+
+/***************************************************************************/
+void StateMgr::dumpTrace(ostream& outStream, const TraceRing& ring) const
+{
+	static const char* const pointNames[] = {"<onEntry>", "<onExit>", "<message trapped>",
+		"<executing exit>", "<executing effect>", "<executing entry>"};
+
+	if(ring.count() > ring.size())
+	{
+		outStream << "[SMARTSTATE_TRACE] " << ring.count() - ring.size() << " earlier records lost" << endl;
+	}
+
+	for(unsigned int i = 0; i < ring.size(); i++)
+	{
+		const TraceRecord& record = ring[i];
+
+		outStream << "[SMARTSTATE_TRACE] ";
+		if(record.state < myStates.size())
+		{
+			outStream << myStates[record.state]->getName();
+		}
+		else
+		{
+			outStream << "state " << record.state;
+		}
+		if(record.point != eTraceOnEntry && record.point != eTraceOnExit)
+		{
+			outStream << " message " << (unsigned int) record.message;
+		}
+		outStream << " " << pointNames[record.point] << "\n";
+	}
+	outStream.flush();
+}
+
+/***************************************************************************/
+void StateMgr::fireMessage(const Mesg& mesg, BaseState* target)
+{
+	try
+	{
+		BaseStateList& tempList = myFireList;
+		tempList.assign(myActiveStatesList.begin(), myActiveStatesList.end());
+		BaseState* pState;
+
+		BaseStateList::iterator it = tempList.begin();
+		BaseStateList::iterator end = tempList.end();
+		for(; it != end; it++)
+		{
+			pState = (*it);
+
+			//onMessage may change the contents of activestatelist.
+			//so send only if the state is still in active list
+			if(isActive(pState))
+			{
+				if(target == 0)
+				{
+					pState->onMessage(mesg);
+				}
+				else
+				{
+					if(pState->isParent(target))
+					{
+						pState->onMessage(mesg);
+					}
+				}
+			}
+		}
+	}
+	catch(std::string&)
+	{
+		throw;
+	}
+	catch(...)
+	{
+		throw std::string("Internal Error, Unexpected");
+	}
+}
+
+/***************************************************************************/
+void StateMgr::registerState(BaseState* stateRef)
+{
+	stateRef->myId = myStates.size();
+	myStates.push_back(stateRef);
+	myActiveFlags.push_back(false);
+}
+
+/***************************************************************************/
+bool StateMgr::injectEvent(unsigned int message, int wParam)
+{
+	return myInbox.push(message, wParam);
+}
+
+/***************************************************************************/
+int StateMgr::drainInjected()
+{
+	int delivered = 0;
+	unsigned int message;
+	int wParam;
+	while(myInbox.pop(message, wParam))
+	{
+		postEvent(message, wParam);
+		delivered++;
+	}
+
+	return delivered;
+}
+
+/***************************************************************************/
+bool StateMgr::hasInjected() const
+{
+	return !myInbox.empty();
+}
+
+/***************************************************************************/
+BaseState* StateMgr::findState(const string& stateName) const
+{
+	if(myStateMap.empty())
+	{
+		for(BaseStateList::size_type i = 0; i < myStates.size(); i++)
+		{
+			myStateMap[myStates[i]->getName()] = myStates[i];
+		}
+	}
+
+	BaseStateMap::const_iterator it = myStateMap.find(stateName);
+	if(it == myStateMap.end())
+	{
+		return 0;
+	}
+
+	return (*it).second;
+}
+
+/***************************************************************************/
+int StateMgr::getStateId(const string& stateName) const
+{
+	if(stateName == "FinalState")
+	{
+		return eFinalState;
+	}
+
+	BaseState* pState = findState(stateName);
+	if(pState == 0)
+	{
+		return eNoState;
+	}
+
+	return pState->getId();
+}
+
+/***************************************************************************/
+void StateMgr::checkStateIds(const char* const stateNames[], int count) const
+{
+	for(int i = 0; i < count || i < (int) myStates.size(); i++)
+	{
+		if(i >= count || i >= (int) myStates.size() || myStates[i]->getId() != i ||
+		   strcmp(myStates[i]->getName(), stateNames[i]) != 0)
+		{
+			throw std::string("State number ") + std::to_string(i) + " is not " +
+				(i < count ? stateNames[i] : myStates[i]->getName());
+		}
+	}
+}
+
+/***************************************************************************/
+BaseState* StateMgr::getState(int stateId, const char* what) const
+{
+	if(stateId < 0 || stateId >= (int) myStates.size())
+	{
+		throw std::string("Invalid ") + what + " state : " + std::to_string(stateId);
+	}
+
+	return myStates[stateId];
+}
+
+/***************************************************************************/
+const BaseState* StateMgr::executeExit(const string& currState, const string& nextState)
+{
+	int currId = getStateId(currState);
+	if(currId < 0)
+	{
+		throw std::string("Invalid current state : " + currState);
+	}
+
+	int nextId = getStateId(nextState);
+	if(nextId == eNoState)
+	{
+		throw std::string("Invalid next state : " + nextState);
+	}
+
+	return executeExit(currId, nextId);
+}
+
+/***************************************************************************/
+const BaseState* StateMgr::executeExit(int currState, int nextState)
+{
+	BaseState* caller = getState(currState, "current");
+	if(myProfile)
+	{
+		myProfile->myTarget = nextState;
+	}
+
+	//FinalState
+	if(nextState == eFinalState)
+	{
+		//finished
+		clearActiveStates();
+		caller->onExit();
+		return 0; //so that executeEntry wont call any thing
+	}
+
+	BaseState* nextStateRef = getState(nextState, "next");
+
+	const BaseState* root = getRoot(caller, nextStateRef);
+
+	//remove this state (and its children if any) from active list
+	removeActiveStates(caller, root);
+
+	BaseState* pState = caller;
+	while(pState != root)
+	{
+		pState->onExit();
+		pState = pState->getParent();
+
+		if(pState == 0)
+		{
+			throw std::string("Internal Logic Error");
+		}
+	}
+	
+	return root;
+}
+
+/***************************************************************************/
+void StateMgr::executeEntry(const BaseState* root, const string& nextState)
+{
+	if(root == 0 || nextState == "FinalState")
+	{
+		myStatus = false; //not running
+		return;
+	}
+
+	int nextId = getStateId(nextState);
+	if(nextId == eNoState)
+	{
+		throw std::string("Invalid next state : " + nextState);
+	}
+
+	executeEntry(root, nextId);
+}
+
+/***************************************************************************/
+void StateMgr::executeEntry(const BaseState* root, int nextState)
+{
+	if(root == 0 || nextState == eFinalState)
+	{
+		myStatus = false; //not running
+		return;
+	}
+
+	BaseState* nextStateRef = getState(nextState, "next");
+
+	//Fill from root to nextStateRef including the links in between
+	//if the nextState is not a leaf.. get all its initial states including
+	//the links in between in the tree. Duplication handled by this method.
+	BaseStateList& tree = myTreeList;
+	tree.clear();
+	constructTree(root, nextStateRef, tree);
+
+	//Add the new State (if leaf or its kids) to active list
+	addInitialStates(nextStateRef);
+
+	//Call onEntry on each one in the list.
+	BaseStateList::iterator lit = tree.begin();
+	BaseStateList::iterator end = tree.end();
+	for(; lit != end; lit++)
+	{
+		(*lit)->onEntry();
+	}
+}
+
+/***************************************************************************/
+const BaseState* StateMgr::getRoot(const BaseState* leaf1, const BaseState* leaf2)
+{
+	const BaseState* pState = leaf1;
+	const BaseState* aState;
+	
+	while(pState) //when it reaches top it will be 0
+	{
+		aState = leaf2;
+		while(aState)//when it reaches top it will be 0
+		{
+			if(pState == aState) 
+			{	//common root
+				return pState;
+			}
+
+			aState = aState->getParent();
+		}
+
+		pState = pState->getParent();
+	}
+
+	//no common root
+	std::string err = "Invalid transition from ";
+	err += leaf1->getName(); 
+	err += " to ";
+	err += leaf1->getName();
+	err += ", no common super state.";
+	throw err;
+
+	return 0; 
+}
+
+/***************************************************************************/
+void StateMgr::constructTree(const BaseState* root, const BaseState* state, BaseStateList& tree)
+{
+	//if the state passed is not a leaf.. get all its initial states including
+	//the links in between in the tree. Duplication handled here.
+	//each branch is collected bottom up and then reversed, so that it is
+	//stored from the top down.
+	BaseStateList::size_type branch = tree.size();
+	const BaseState* pState = state;
+	while(pState != root)
+	{
+		tree.push_back(const_cast<BaseState*>(pState));
+		pState = pState->getParent();
+
+		if(pState == 0)
+		{
+			throw std::string("Internal Logic Error");
+		}
+	}
+	std::reverse(tree.begin() + branch, tree.end());
+
+	BaseStateList& iniStatesList = myScratchList;
+	iniStatesList.clear();
+	state->getInitialStates(iniStatesList);
+	
+	BaseStateList::iterator it = iniStatesList.begin();
+	BaseStateList::iterator end = iniStatesList.end();
+
+	for(; it != end; it++)
+	{
+		pState = (*it); //the initial state
+		branch = tree.size();
+
+		while(pState != state) //till state
+		{
+			if(!BaseState::isInList(pState, tree)) //avoid duplication
+			{
+				tree.push_back(const_cast<BaseState*>(pState));
+			}
+			
+			pState = pState->getParent();
+		}
+
+		//add to original tree
+		std::reverse(tree.begin() + branch, tree.end());
+	}
+}
+
+/***************************************************************************/
+void StateMgr::constructInitialTree(BaseStateList& tree)
+{	//should be called only from start
+
+	BaseStateList::iterator it = myActiveStatesList.begin();
+	BaseStateList::iterator end = myActiveStatesList.end();
+
+	BaseState* pState;
+	for(; it != end; it++)
+	{
+		pState = (*it); //the initial state
+		BaseStateList::size_type branch = tree.size();
+
+		while(pState != 0) //till top
+		{
+			if(!BaseState::isInList(pState, tree)) //avoid duplication
+			{
+				tree.push_back(const_cast<BaseState*>(pState));
+			}
+			
+			pState = pState->getParent();
+		}
+
+		//store the branch from the top down
+		std::reverse(tree.begin() + branch, tree.end());
+	}
+}
+
+/***************************************************************************/
+void StateMgr::removeActiveStates(const BaseState* state, const BaseState* root)
+{
+	//remove caller first
+	BaseStateList::iterator it = myActiveStatesList.begin();
+	BaseStateList::iterator end = myActiveStatesList.end();
+	for(; it != end; it++)
+	{
+		if((*it) == state)
+		{
+			myActiveFlags[state->getId()] = false;
+			myActiveStatesList.erase(it);
+			break;
+		}
+	}
+
+	//remove all its sub states which are active now..
+	//remove its parents active state also till root.
+	const BaseState* pState = state;
+	while(pState != root)
+	{
+		it = myActiveStatesList.begin();
+		while(it != myActiveStatesList.end())
+		{
+			if((*it)->isParent(pState))
+			{
+				//Store history information (only if parent is a super state and history is set)
+				BaseState* pParentState = (*it)->getParent();
+				if((pParentState->getType() == eSuper) && (pParentState->myHistory == true))
+				{
+					pParentState->myHistoryState = (*it);
+				}
+
+				myActiveFlags[(*it)->getId()] = false;
+				it = myActiveStatesList.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+
+		pState = pState->getParent();
+
+		if(pState == 0)
+		{
+			throw std::string("Internal Logic Error 11");
+		}
+	}
+}
+
+/***************************************************************************/
+void StateMgr::clearActiveStates()
+{
+	myActiveStatesList.clear();
+	myActiveFlags.assign(myStates.size(), false);
+}
+
+/***************************************************************************/
+void StateMgr::addInitialStates(const BaseState* state)
+{
+	BaseStateList& iniStatesList = myScratchList;
+	iniStatesList.clear();
+	state->getInitialStates(iniStatesList);
+
+	BaseStateList::iterator it = iniStatesList.begin();
+	BaseStateList::iterator end = iniStatesList.end();
+	for(; it != end; it++)
+	{
+		myActiveStatesList.push_back(*it);
+		myActiveFlags[(*it)->getId()] = true;
+	}
+}
+
+/***************************************************************************/
+bool StateMgr::isActive(const BaseState* state) const
+{
+	return myActiveFlags[state->getId()];
+}
+
+/***************************************************************************/
+void StateMgr::queueMessage(const PostedMesg& postMsg)
+{
+	if(myPostedCount == SS_POSTED_MESG_MAX)
+	{
+		throw std::string("Posted message queue of " + myName + " is full, message "
+			+ std::to_string(postMsg.mesg.message) + " dropped.");
+	}
+
+	myPostedMesgs[(myPostedHead + myPostedCount) % SS_POSTED_MESG_MAX] = postMsg;
+	myPostedCount++;
+}
+
+/***************************************************************************/
+void StateMgr::debugLog(const string& str)
+{
+	if (myDebugLogStream)	// added by Craig Scratchley, Simon Fraser University, Canada
+							// set myDebugLogStream to NULL if you want to turn off the log
+		(*myDebugLogStream) << "[SMARTSTATE_DEBUG] " << str << endl;
+}
+
+void StateMgr::debugLog(const char* str)
+{
+	if (myDebugLogStream)
+		(*myDebugLogStream) << "[SMARTSTATE_DEBUG] " << str << endl;
+}
+
+/***************************************************************************/
+/***************************************************************************/
+/***************************************************************************/
+BaseState::BaseState(const char* name, BaseState* parent, StateMgr* mgr)
+: myName(name),
+  myId(eNoState),
+  myParent(parent),
+  myType(eSub),
+  myMgr(mgr),
+  myHistory(false),
+  myHistoryState(0)
+{
+	myMgr->registerState(this);
+}
+
+BaseState::BaseState()
+: myName("")
+{
+}
+
+void* BaseState::operator new(size_t size, StateMgr* mgr)
+{
+	return mgr->allocateState(size);
+}
+
+void BaseState::operator delete(void* state, StateMgr* mgr)
+{
+	//the storage is freed with the StateMgr
+}
+
+void BaseState::operator delete(void* state)
+{
+	//the storage is freed with the StateMgr
+}
+
+BaseState::~BaseState()
+{
+	//destroy all sub states.
+	BaseStateList::iterator it = mySubStates.begin();
+	BaseStateList::iterator end = mySubStates.end();
+
+	for(; it != end; it++)
+	{
+		delete (*it);
+	}
+}
+
+/***************************************************************************/
+bool BaseState::isParent(const BaseState* state) const
+{
+	if(myParent == state)
+	{
+		return true;
+	}
+
+	if(myParent == 0)
+	{	//top most
+		return false;
+	}
+
+	return myParent->isParent(state);
+}
+
+/***************************************************************************/
+void BaseState::getInitialStates(BaseStateList& iniList) const
+{
+	if(myType == eSuper)
+	{
+		//return history state if valid
+		if(myHistoryState)
+		{
+			myHistoryState->getInitialStates(iniList);
+		}
+		else
+		{
+			(*mySubStates.begin())->getInitialStates(iniList);
+		}
+	}
+	else if(myType == eConc)
+	{
+		BaseStateList::const_iterator it = mySubStates.begin();
+		BaseStateList::const_iterator end = mySubStates.end();
+		for(; it != end; it++)
+		{
+			(*it)->getInitialStates(iniList);
+		}
+	}
+	else //sub
+	{
+		iniList.push_back((BaseState*)this);
+	}
+}
+
+/***************************************************************************/
+void BaseState::onMessage(const Mesg& mesg)
+{
+	//does nothing
+}
+
+/***************************************************************************/
+void BaseState::setType(EStateType type)
+{
+	myType = type;
+}
+
+/***************************************************************************/
+void BaseState::onEntry()
+{
+	//does nothing
+}
+
+/***************************************************************************/
+void BaseState::onExit()
+{
+	//does nothing
+}
+
+/***************************************************************************/
+void BaseState::postMessage(unsigned int message, int wParam, int lParam)
+{
+	//find conc state name.
+	BaseState* pState = this;
+	BaseState* parent = this;
+	while(parent) //till root
+	{
+		pState = parent;
+		parent = pState->getParent();
+	}
+
+	PostedMesg postmesg;
+	postmesg.stateId = pState->getId();
+	postmesg.mesg.message = message;
+	postmesg.mesg.wParam = wParam;
+	postmesg.mesg.lParam = lParam;
+
+	myMgr->queueMessage(postmesg);
+}
+
+/***************************************************************************/
+void BaseState::postMessage(string targetState, unsigned int message, int wParam, int lParam)
+{
+	PostedMesg postmesg;
+	//an unknown name is reported when the message is delivered
+	postmesg.stateId = (targetState == "*") ? (int) eAllStates : myMgr->getStateId(targetState);
+
+	postmesg.mesg.message = message;
+	postmesg.mesg.wParam = wParam;
+	postmesg.mesg.lParam = lParam;
+
+	myMgr->queueMessage(postmesg);
+}
+
+/***************************************************************************/
+void BaseState::postMessageToAll(unsigned int message, int wParam, int lParam)
+{
+	PostedMesg postmesg;
+	postmesg.stateId = eAllStates;
+
+	postmesg.mesg.message = message;
+	postmesg.mesg.wParam = wParam;
+	postmesg.mesg.lParam = lParam;
+
+	myMgr->queueMessage(postmesg);
+}
+
+/***************************************************************************/
+bool BaseState::isInList(const BaseState* state, const BaseStateList& aList)
+{
+	BaseStateList::const_iterator it = aList.begin();
+	BaseStateList::const_iterator end = aList.end();
+
+	for(; it != end; it++)
+	{
+		if((*it) == state)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+}
@@ -1,417 +1,918 @@
-/*******************************************************************
-	SmartState State Machine Code. Do not Distribute. DO NOT EDIT.
-	(c) ApeSoft [www.SmartStateStudio.com]
-*******************************************************************/
-
-#ifndef SS_API_H
-#define SS_API_H
-
-#pragma GCC diagnostic ignored "-Wdeprecated"
-
-/*STL Includes*/
-#include <list>
-#include <map>
-#include <string>
-
-using std::list;
-using std::map;
-using std::string;
-using std::ostream;
-using std::istream;
-
-namespace smartstate
-{
-	struct Mesg
-	{
-		Mesg();
-
-		Mesg(unsigned int m, int w, int l);
-
-		unsigned int message;
-		int wParam;
-		int lParam;
-	};
-
-	class BaseState;
-
-	typedef list<BaseState*> BaseStateList;
-	typedef map<string, BaseState*> BaseStateMap;
-
-	struct PostedMesg
-	{
-		string stateName;
-		Mesg mesg;
-	};
-
-	typedef list<PostedMesg> PostedMesgList;
-	enum EStateType {eSuper, eSub, eConc};
-
-
-	/*****************************************************************************/
-	/* STATEMGR BEGIN*/
-	/*****************************************************************************/
-	/* Class: StateMgr
-	 *Description: This is a base class for handling the state transitions.
-	 *The generated code will specialize this class.
-	 *Context should create an instance of the generated class.
-	 *This class defines the interface to be used by the Context class.
-	 */
-	class StateMgr
-	{
-		friend class BaseState;
-
-		protected:
-
-			/*Constructor
-			*
-			*Param: name - Name of the object.
-			*/
-			StateMgr(const string& name);
-
-		public:
-
-			/*Destructor
-			*/
-			virtual ~StateMgr();
-
-		private:
-
-			/*No copy & assignment allowed.
-			*/
-			StateMgr(const StateMgr& );
-			StateMgr& operator=(const StateMgr& );
-
-		/*METHODS - For Context
-		*/
-		public:
-
-			/*
-			*Method: start
-			*Description: Runs the StateMgr and initialize all initial states.
-			*Param: None
-			*Return: None.
-			*See: 'serialise' function for initialising to the last saved state.
-			*/
-			void start();
-
-			/*
-			*Method: getName
-			*Description: Returns the name of the StateMgr object.
-			*Param: None
-			*Return: Name of StateMgr object.
-			*/
-			const string& getName();
-
-			/*
-			*Method: postEvent
-			*Description: Interface used by Context to post events.
-			*Param: message - the event for state transition.
-			*Param: wParam - additional information with the event.
-			*				  [default = 0]
-			*Param: lparam - additional information with the event.
-			*				  [default = 0]
-			*Return: None
-			*Exception: std::string
-			*			 Possible reason:
-			*			 1) StateMgr is in FinalState or not running.
-			*			 2) Internal messaging (PostMessage) specifies an
-			*			 invalid target state name.
-			*			 3) Internal logic error (may be an invalid model)
-			*/
-			virtual void postEvent(unsigned int message, int wParam = 0,
-				int lParam = 0);
-			    // throw (std::string); // removed as no longer allowed in C++17
-
-			/*
-			*Method: reInit
-			*Description: Interface used by Context to reinitialize the
-			*			   state of StateMgr. It resets all active states
-			*			   and calls onEntry() of each state. Usually used
-			*			   to reInitialize when the state goes to FinalState.
-			*Param: none
-			*Return: None
-			*Exception: None
-			*/
-			void reInit();
-
-			/*
-			*Method: isRunning
-			*Description: Interface used by Context to check the status of
-			*			   StateMgr. Returns true when its active and false
-			*			   when its in FinalState.
-			*Param: none
-			*Return: Either
-			*		  true  - Running, can send messges
-			*		  false - In FinalState, need to be reinitialized.
-			*Exception: None
-			*/
-			virtual bool isRunning() const;
-
-			/*
-			*Method: serialise
-			*Description: Persist the state machine to the ostream object.
-			*			We can initialise the state machine to the same state later.
-			*Param: outStream - The output stream to serialise the machine
-			*		Can be a physical file opened (fstream) or an inmemory
-			*		string stream (ostringstream) or any other ostream.
-			*/
-			void serialise(ostream& outStream) const;
-
-			/*
-			*Method: serialise
-			*Description: Load the state machine from the istream object.
-			*			The machine will be running after this operation.
-			*			Calling start() or reInit() after serialise will
-			* 			reset the machine to initial states.
-			*
-			*Param: inStream - The input stream to serialise the machine
-			*		Can be a physical file opened (fstream) or an inmemory
-			*		string stream (istringstream) or any other istream.
-			*		Can serialise only a previously saved state machine.
-			*
-			*Return: None
-			*/
-			void serialise(istream& inStream);
-
-			/*
-			*Method: setDebugLog
-			*Description: To specify user defined output stream for logging
-			*debug messages. Effective ONLY if the code generation is done with
-			*-g flag while compiling. Else reduntant.
-			*Optional API only if needed to override the default (standard console)
-			*
-			*Param: logStream - Out stream for debug data logging.
-			*	Default to standard console (cout).
-			*
-			*Return: None
-			*/
-			void setDebugLog(ostream* logStream);
-
-		/*METHODS - For Internal Classes
-		*/
-		public:
-
-			/*
-			*Method: executeEntry
-			*Description: Interface used by generated classes for entering a state
-			*			   Should not be called from Context.
-			*Param: root - The common root state reference.
-			*Param: nextState - The name of next state.
-			*Return: None.
-			*/
-			void executeEntry(const BaseState* root, const string& nextState);
-
-			/*
-			*Method: executeExit
-			*Description: Interface used by generated classes for exiting a state.
-			*			   Should not be called from Context.
-			*Param: currState - The name of current state.
-			*Param: nextState - The name of next state.
-			*Return: The common root state reference.
-			*/
-			const BaseState* executeExit(const string& currState, const string& nextState);
-
-			/*Method: debugLog
-			*Description: Log the generated debug message using the out stream.
-			*See: setDebugLog for more information.
-			*Param: str - the message to log
-			*/
-			void debugLog(const string& str);
-
-		private:
-
-			/*
-			*Method: getRoot
-			*Description: Returns the common root object reference.
-			*Param: leaf1 - the first leaf
-			*Param: leaf2 - the second leaf
-			*Return: The common root object reference.
-			*/
-			const BaseState* getRoot(const BaseState* leaf1, const BaseState* leaf2);
-
-			/*
-			*Method: constructTree
-			*Description: Constructs the tree of object references.
-			*Param: root - The common root object reference
-			*Param: state - the leaf
-			*Param: tree - the tree as out param
-			*Return: None
-			*/
-			void constructTree(const BaseState* root, const BaseState* state,
-				BaseStateList& tree);
-
-			/*
-			*Method: constructInitialTree
-			*Description: Constructs the initial state tree.
-			*Param: tree - the tree as out param
-			*Return: None
-			*/
-			void constructInitialTree(BaseStateList& tree);
-
-			/*
-			*Method: registerState
-			*Description: Registers the state name with its object reference.
-			*Param: stateName - name of the state.
-			*Param: stateRef - object reference.
-			*Return: None
-			*/
-			void registerState(const string& stateName, BaseState* stateRef);
-
-			/*
-			*Method: removeActiveStates
-			*Description: Removes the active states in between the given state
-			*			   and the root and its child states.
-			*Param: state - the leaf state reference.
-			*Param: root - the root object reference.
-			*Return: None
-			*/
-			void removeActiveStates(const BaseState* state, const BaseState* root);
-
-			/*
-			*Method: fireMessage
-			*Description: Sends a message to the target if specified else to all
-			*Param: mesg - the message to send.
-			*Param: target - the target Conurrent state object ref.
-			*Return: None
-			*/
-			void fireMessage(const Mesg& mesg, BaseState* target=0);
-
-			/*
-			*Method: queueMessage
-			*Description: Queue the posted internal messages for delivery.
-			*Param: postMsg - the posted message.
-			*Return: None
-			*/
-			void queueMessage(PostedMesg postMsg);
-
-			/*
-			*Method sendPostedMessages
-			*Description: Process all internally posted messages
-			*Return: None
-			*/
-			void sendPostedMessages();
-
-
-		/*ATRIBUTES
-		*/
-		protected:
-
-			/*List of concurrent states.
-			*/
-			BaseStateList myConcStateList;
-
-		private:
-
-			/*Map of name Vs object of registerd states.
-			*/
-			BaseStateMap myStateMap;
-
-			/*Currently active states
-			*/
-			BaseStateList myActiveStatesList;
-
-			/*Current status
-			*/
-			bool myStatus;
-
-			/*Posted messages list.
-			*/
-			PostedMesgList myPostedMesgList;
-
-			/*name of the StateMgr object.
-			*/
-			string myName;
-
-			/*Processing a message or not.
-			*/
-			bool myBusyStatus;
-
-			/*out stream for debug logging if -g is specified while code generation
-			*/
-			ostream* myDebugLogStream;
-	};
-
-	/*INLINES
-	*/
-	inline const string& StateMgr::getName()
-	{
-		return myName;
-	}
-
-	/*****************************************************************************/
-	/* STATEMGR END*/
-	/*****************************************************************************/
-
-	/*****************************************************************************/
-	/* BASESTATE BEGIN*/
-	/*****************************************************************************/
-	class StateMgr;
-
-	class BaseState
-	{
-		friend class StateMgr;
-
-		protected:
-			BaseState();
-			BaseState(const string& name, BaseState* parent, StateMgr* mgr);
-		public:
-			virtual ~BaseState();
-
-		private:
-			BaseState(const BaseState& );
-			BaseState& operator=(const BaseState& );
-
-		public:
-			BaseState* getParent() const;
-			const string& getName() const;
-			EStateType getType() const;
-
-			bool isParent(const BaseState* state) const;
-			void getInitialStates(BaseStateList& iniList) const;
-
-		protected:
-			virtual void onMessage(const Mesg& mesg);
-			void setType(EStateType type);
-			void postMessage(unsigned int message, int wParam = 0, int lParam = 0);
-			void postMessage(string targetState, unsigned int message, int wParam = 0, int lParam = 0);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-			static bool isInList(const BaseState* state, const BaseStateList& aList);
-
-		protected:
-			const string myName;
-			BaseState* myParent;
-			BaseStateList mySubStates;
-			EStateType myType;
-			StateMgr* myMgr;
-
-			bool myHistory;
-			BaseState* myHistoryState;
-	};
-
-	#define POST postMessage
-
-	inline BaseState* BaseState::getParent() const
-	{
-		return myParent;
-	}
-
-	inline const string& BaseState::getName() const
-	{
-		return myName;
-	}
-
-	inline EStateType BaseState::getType() const
-	{
-		return myType;
-	}
-
-	/*****************************************************************************/
-	/* BASESTATE END*/
-	/*****************************************************************************/
-
-} /*end namespace smartstate*/
-
-#endif
+/*******************************************************************
+	SmartState State Machine Code. Do not Distribute. DO NOT EDIT.
+	(c) ApeSoft [www.SmartStateStudio.com]
+*******************************************************************/
+
+#ifndef SS_API_H
+#define SS_API_H
+
+#pragma GCC diagnostic ignored "-Wdeprecated"
+
+/*STL Includes*/
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+using std::list;
+using std::map;
+using std::string;
+using std::vector;
+using std::ostream;
+using std::istream;
+
+namespace smartstate
+{
+	struct Mesg
+	{
+		Mesg();
+
+		Mesg(unsigned int m, int w, int l);
+
+		unsigned int message;
+		int wParam;
+		int lParam;
+	};
+
+	class BaseState;
+
+	typedef vector<BaseState*> BaseStateList;
+	typedef map<string, BaseState*> BaseStateMap;
+
+	/*States are numbered 0, 1, 2 ... in the order in which they are
+	 *constructed. These special numbers are used as targets instead.
+	 */
+	enum EStateId {eFinalState = -1, eAllStates = -2, eNoState = -3};
+
+	struct PostedMesg
+	{
+		int stateId; //a state number or eAllStates
+		Mesg mesg;
+	};
+
+	/*The most internal messages that can be waiting for delivery at once.
+	 *Define SS_POSTED_MESG_MAX when compiling to change it.
+	 */
+	#ifndef SS_POSTED_MESG_MAX
+	#define SS_POSTED_MESG_MAX 16
+	#endif
+
+	enum EStateType {eSuper, eSub, eConc};
+
+	/*Where in the generated code a trace record was made.
+	 */
+	enum ETracePoint {eTraceOnEntry, eTraceOnExit, eTraceTrapped,
+					  eTraceExecExit, eTraceExecEffect, eTraceExecEntry};
+
+	/*A trace record: the state number, the message (0 for onEntry and
+	 *onExit) and the ETracePoint.
+	 */
+	struct TraceRecord
+	{
+		uint16_t state;
+		uint8_t message;
+		uint8_t point;
+	};
+
+	/*The size of the blocks the states of a StateMgr are stored in.
+	 */
+	#ifndef SS_ARENA_BLOCK
+	#define SS_ARENA_BLOCK 4096
+	#endif
+
+	/*The number of records a TraceRing keeps. A power of two.
+	 *Define SS_TRACE_RING_SIZE when compiling to change it.
+	 */
+	#ifndef SS_TRACE_RING_SIZE
+	#define SS_TRACE_RING_SIZE 1024
+	#endif
+
+	/*****************************************************************************/
+	/* Class: TraceRing
+	 *Description: Keeps the last SS_TRACE_RING_SIZE trace records of a
+	 *machine, overwriting the oldest. See StateMgr::setTrace.
+	 */
+	class TraceRing
+	{
+		public:
+			TraceRing() : myCount(0) {}
+
+			void put(int state, unsigned int message, ETracePoint point)
+			{
+				TraceRecord& record = myRecords[myCount++ & (SS_TRACE_RING_SIZE - 1)];
+				record.state = state;
+				record.message = message;
+				record.point = point;
+			}
+
+			/*The number of records kept, and the i'th oldest of them.
+			*/
+			unsigned int size() const
+			{
+				return myCount < SS_TRACE_RING_SIZE ? myCount : SS_TRACE_RING_SIZE;
+			}
+			const TraceRecord& operator[](unsigned int i) const
+			{
+				return myRecords[(myCount - size() + i) & (SS_TRACE_RING_SIZE - 1)];
+			}
+
+			/*The number of records ever put, including those overwritten.
+			*/
+			unsigned int count() const
+			{
+				return myCount;
+			}
+
+		private:
+			TraceRecord myRecords[SS_TRACE_RING_SIZE];
+			unsigned int myCount;
+	};
+
+	/*****************************************************************************/
+	/* Class: StateProfile
+	 *Description: Counts how long each state of a machine was active, as a
+	 *histogram of powers of two of microseconds, and how often each
+	 *transition was taken. It is fed by the trace points, so it is of no use
+	 *with SS_NO_TRACE. Only the thread running the machine touches it, so it
+	 *needs no locks. Its tables are sized by StateMgr::setProfile, so counting
+	 *never allocates.
+	 */
+	class StateProfile
+	{
+		public:
+			enum {eBuckets = 32};
+
+			/*The slots for the transitions, a power of two. A machine with more
+			 *transitions than this counts the rest in myLostTransitions.
+			 *Define SS_PROFILE_TRANSITIONS when compiling to change it.
+			 */
+			#ifndef SS_PROFILE_TRANSITIONS
+			#define SS_PROFILE_TRANSITIONS 256
+			#endif
+			enum {eTransitionSlots = SS_PROFILE_TRANSITIONS};
+
+			struct Dwell
+			{
+				Dwell() : count(0), totalUsecs(0), enteredUsecs(-1), buckets() {}
+
+				unsigned int count;
+				unsigned long long totalUsecs;
+				long long enteredUsecs; //or -1 when not active
+				unsigned int buckets[eBuckets]; //b: at least 2^(b-1), under 2^b usecs
+			};
+
+			struct Transition
+			{
+				Transition() : key(0), count(0) {}
+
+				uint64_t key;		//(from, message, to) packed as in StateMgr::profilePoint
+				unsigned int count; //or 0 for an empty slot
+			};
+
+			StateProfile() : myLostTransitions(0), myTarget(eNoState) {}
+
+			/*
+			*Method: diff
+			*Description: Compare two files of profiles written by
+			*			   StateMgr::dumpProfile, each summed over all the
+			*			   profiles in it, and write what changed.
+			*/
+			static void diff(istream& before, istream& after, ostream& outStream);
+
+			vector<Dwell> myDwells; //for each state number
+
+			/*The count of each transition, in eTransitionSlots slots found by
+			 *hashing the key and probing the slots after. to is eNoState for
+			 *an internal transition.
+			 */
+			vector<Transition> myTransitions;
+			unsigned int myLostTransitions; //taken after every slot was used
+
+			int myTarget; //of the transition being taken, see executeExit
+	};
+
+	/*The most events that can be waiting in an EventInbox. A power of two.
+	 *Define SS_INBOX_SIZE when compiling to change it.
+	 */
+	#ifndef SS_INBOX_SIZE
+	#define SS_INBOX_SIZE 64
+	#endif
+
+	/*****************************************************************************/
+	/* Class: EventInbox
+	 *Description: Events posted by any number of threads, for the one thread
+	 *that runs a machine to take. A fixed ring of cells, each with a sequence
+	 *number that says whose turn it is to use it, so neither side ever locks
+	 *or allocates. See StateMgr::injectEvent.
+	 */
+	class EventInbox
+	{
+		public:
+			EventInbox() : myPushPos(0), myPopPos(0)
+			{
+				for(unsigned int i = 0; i < SS_INBOX_SIZE; i++)
+				{
+					myCells[i].seq.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			/*Any thread. Returns false, dropping the event, if the inbox is full.
+			*/
+			bool push(unsigned int message, int wParam)
+			{
+				unsigned int pos = myPushPos.load(std::memory_order_relaxed);
+				Cell* cell;
+				for(;;)
+				{
+					cell = &myCells[pos & (SS_INBOX_SIZE - 1)];
+					int diff = (int) (cell->seq.load(std::memory_order_acquire) - pos);
+					if(diff == 0)
+					{
+						if(myPushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+							break;
+					}
+					else if(diff < 0)
+					{
+						return false;
+					}
+					else
+					{
+						pos = myPushPos.load(std::memory_order_relaxed);
+					}
+				}
+				cell->message = message;
+				cell->wParam = wParam;
+				cell->seq.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+
+			/*The owning thread only. Returns false if there is nothing to take.
+			*/
+			bool pop(unsigned int& message, int& wParam)
+			{
+				Cell& cell = myCells[myPopPos & (SS_INBOX_SIZE - 1)];
+				if(cell.seq.load(std::memory_order_acquire) != myPopPos + 1)
+					return false;
+				message = cell.message;
+				wParam = cell.wParam;
+				cell.seq.store(myPopPos + SS_INBOX_SIZE, std::memory_order_release);
+				myPopPos++;
+				return true;
+			}
+
+			/*The owning thread only.
+			*/
+			bool empty() const
+			{
+				return myCells[myPopPos & (SS_INBOX_SIZE - 1)].seq.load(std::memory_order_acquire) != myPopPos + 1;
+			}
+
+		private:
+			struct Cell
+			{
+				std::atomic<unsigned int> seq;
+				unsigned int message;
+				int wParam;
+			};
+
+			Cell myCells[SS_INBOX_SIZE];
+			alignas(64) std::atomic<unsigned int> myPushPos; //shared by the posting threads
+			alignas(64) unsigned int myPopPos;
+	};
+
+	/*****************************************************************************/
+	/* STATEMGR BEGIN*/
+	/*****************************************************************************/
+	/* Class: StateMgr
+	 *Description: This is a base class for handling the state transitions.
+	 *The generated code will specialize this class.
+	 *Context should create an instance of the generated class.
+	 *This class defines the interface to be used by the Context class.
+	 */
+	class StateMgr
+	{
+		friend class BaseState;
+
+		protected:
+
+			/*Constructor
+			*
+			*Param: name - Name of the object.
+			*/
+			StateMgr(const string& name);
+
+		public:
+
+			/*Destructor
+			*/
+			virtual ~StateMgr();
+
+		private:
+
+			/*No copy & assignment allowed.
+			*/
+			StateMgr(const StateMgr& );
+			StateMgr& operator=(const StateMgr& );
+
+		/*METHODS - For Context
+		*/
+		public:
+
+			/*
+			*Method: start
+			*Description: Runs the StateMgr and initialize all initial states.
+			*Param: None
+			*Return: None.
+			*See: 'serialise' function for initialising to the last saved state.
+			*/
+			void start();
+
+			/*
+			*Method: getName
+			*Description: Returns the name of the StateMgr object.
+			*Param: None
+			*Return: Name of StateMgr object.
+			*/
+			const string& getName();
+
+			/*
+			*Method: postEvent
+			*Description: Interface used by Context to post events.
+			*Param: message - the event for state transition.
+			*Param: wParam - additional information with the event.
+			*				  [default = 0]
+			*Param: lparam - additional information with the event.
+			*				  [default = 0]
+			*Return: None
+			*Exception: std::string
+			*			 Possible reason:
+			*			 1) StateMgr is in FinalState or not running.
+			*			 2) Internal messaging (PostMessage) specifies an
+			*			 invalid target state name.
+			*			 3) Internal logic error (may be an invalid model)
+			*/
+			virtual void postEvent(unsigned int message, int wParam = 0,
+				int lParam = 0);
+			    // throw (std::string); // removed as no longer allowed in C++17
+
+			/*
+			*Method: reInit
+			*Description: Interface used by Context to reinitialize the
+			*			   state of StateMgr. It resets all active states
+			*			   and history, and calls onEntry() of each state.
+			*			   Usually used to reInitialize when the state goes
+			*			   to FinalState, so that a machine can be reused
+			*			   rather than constructed again.
+			*Param: none
+			*Return: None
+			*Exception: None
+			*/
+			void reInit();
+
+			/*
+			*Method: isRunning
+			*Description: Interface used by Context to check the status of
+			*			   StateMgr. Returns true when its active and false
+			*			   when its in FinalState.
+			*Param: none
+			*Return: Either
+			*		  true  - Running, can send messges
+			*		  false - In FinalState, need to be reinitialized.
+			*Exception: None
+			*/
+			virtual bool isRunning() const;
+
+			/*
+			*Method: serialise
+			*Description: Persist the state machine to the ostream object.
+			*			We can initialise the state machine to the same state later.
+			*Param: outStream - The output stream to serialise the machine
+			*		Can be a physical file opened (fstream) or an inmemory
+			*		string stream (ostringstream) or any other ostream.
+			*/
+			void serialise(ostream& outStream) const;
+
+			/*
+			*Method: serialise
+			*Description: Load the state machine from the istream object.
+			*			The machine will be running after this operation.
+			*			Calling start() or reInit() after serialise will
+			* 			reset the machine to initial states.
+			*
+			*Param: inStream - The input stream to serialise the machine
+			*		Can be a physical file opened (fstream) or an inmemory
+			*		string stream (istringstream) or any other istream.
+			*		Can serialise only a previously saved state machine.
+			*
+			*Return: None
+			*/
+			void serialise(istream& inStream);
+
+			/*
+			*Method: snapshot
+			*Description: Save the active states and the history of every
+			*			   state, as numbers, to buf. Unlike serialise, the
+			*			   machine continues from a snapshot exactly as it
+			*			   would have, and taking one costs little more than
+			*			   copying it. Only between events (not from actions).
+			*Param: buf - where to save.
+			*Param: n - the size of buf.
+			*Return: The number of bytes saved, or 0 if n is too small.
+			*/
+			size_t snapshot(void* buf, size_t n) const;
+
+			/*
+			*Method: restore
+			*Description: Load a snapshot taken of a machine generated from
+			*			   the same model. The machine will be running after
+			*			   this operation. No entry actions are called.
+			*Param: buf - the snapshot.
+			*Param: n - its size.
+			*Return: None
+			*Exception: std::string, if it is not such a snapshot. The machine
+			*			 is left as it was.
+			*/
+			void restore(const void* buf, size_t n);
+
+			/*
+			*Method: setDebugLog
+			*Description: To specify user defined output stream for logging
+			*debug messages. Effective ONLY if the code generation is done with
+			*-g flag while compiling. Else reduntant.
+			*Optional API only if needed to override the default (standard console)
+			*
+			*Param: logStream - Out stream for debug data logging.
+			*	Default to standard console (cout).
+			*
+			*Return: None
+			*/
+			void setDebugLog(ostream* logStream);
+
+			/*
+			*Method: setTrace
+			*Description: Record what the generated code does, as binary
+			*			   TraceRecords, in ring. While there is no ring
+			*			   (the default), each trace point costs one test.
+			*			   Define SS_NO_TRACE when compiling the generated
+			*			   code to remove the trace points altogether.
+			*Param: ring - where to record, or 0 to stop.
+			*Return: None
+			*/
+			void setTrace(TraceRing* ring);
+
+			/*
+			*Method: dumpTrace
+			*Description: Write the records in ring as text, one per line,
+			*			   with the names of the states.
+			*Param: outStream - where to write.
+			*Param: ring - the records, made by this StateMgr.
+			*Return: None
+			*/
+			void dumpTrace(ostream& outStream, const TraceRing& ring) const;
+
+			/*
+			*Method: setProfile
+			*Description: Count, in profile, how long each state is active
+			*			   and how often each transition is taken. Like the
+			*			   trace, it costs one test per trace point while
+			*			   there is no profile (the default). Sizes the
+			*			   tables of profile for this machine.
+			*Param: profile - where to count, or 0 to stop.
+			*Return: None
+			*/
+			void setProfile(StateProfile* profile);
+
+			/*
+			*Method: dumpProfile
+			*Description: Write profile as text, one line per state and per
+			*			   transition, with the names of the states. See
+			*			   StateProfile::diff.
+			*Param: outStream - where to write.
+			*Param: profile - the counts, made by this StateMgr.
+			*Return: None
+			*/
+			void dumpProfile(ostream& outStream, const StateProfile& profile) const;
+
+			/*
+			*Method: getStateId
+			*Description: Returns the number given to a state when the
+			*			   machine was built. Names are only needed for
+			*			   logging and serialise.
+			*Param: stateName - name of the state, or "FinalState".
+			*Return: The state number, eFinalState, or eNoState if there is
+			*		 no such state.
+			*/
+			int getStateId(const string& stateName) const;
+
+			/*
+			*Method: checkStateIds
+			*Description: Used by the generated constructor, once the states
+			*			   are built, to check that the state numbers it was
+			*			   generated with are those the states were given.
+			*Param: stateNames - the name of each state, by number.
+			*Param: count - the number of names.
+			*Return: None
+			*Exception: std::string, naming the first state that differs.
+			*/
+			void checkStateIds(const char* const stateNames[], int count) const;
+
+			/*
+			*Method: injectEvent
+			*Description: Post an event from any thread, without locking.
+			*			   postEvent and everything else may only be called
+			*			   by the one thread that runs the machine, which
+			*			   delivers injected events with drainInjected.
+			*Param: message - the event for state transition.
+			*Param: wParam - additional information with the event.
+			*Return: false if SS_INBOX_SIZE events are already waiting, and
+			*		 the event has been dropped.
+			*/
+			bool injectEvent(unsigned int message, int wParam = 0);
+
+			/*
+			*Method: drainInjected
+			*Description: Deliver, with postEvent, the events injected so far.
+			*			   Called by the thread that runs the machine, between
+			*			   its own events.
+			*Return: The number of events delivered.
+			*Exception: std::string, as postEvent.
+			*/
+			int drainInjected();
+
+			/*
+			*Method: hasInjected
+			*Description: Are injected events waiting? For the thread that
+			*			   runs the machine.
+			*/
+			bool hasInjected() const;
+
+		/*METHODS - For Internal Classes
+		*/
+		public:
+
+			/*
+			*Method: executeEntry
+			*Description: Interface used by generated classes for entering a state
+			*			   Should not be called from Context.
+			*Param: root - The common root state reference.
+			*Param: nextState - The number of next state, or eFinalState.
+			*Return: None.
+			*/
+			void executeEntry(const BaseState* root, int nextState);
+
+			/*
+			*Method: executeExit
+			*Description: Interface used by generated classes for exiting a state.
+			*			   Should not be called from Context.
+			*Param: currState - The number of current state.
+			*Param: nextState - The number of next state, or eFinalState.
+			*Return: The common root state reference.
+			*/
+			const BaseState* executeExit(int currState, int nextState);
+
+			/*
+			*Method: executeEntry
+			*Description: As above, but with the name of next state. Slower.
+			*/
+			void executeEntry(const BaseState* root, const string& nextState);
+
+			/*
+			*Method: executeExit
+			*Description: As above, but with the names of the states. Slower.
+			*/
+			const BaseState* executeExit(const string& currState, const string& nextState);
+
+			/*Method: debugLog
+			*Description: Log the generated debug message using the out stream.
+			*See: setDebugLog for more information.
+			*Param: str - the message to log
+			*/
+			void debugLog(const string& str);
+			void debugLog(const char* str); //no string is built for a literal
+
+			/*Method: trace
+			*Description: Used by generated classes, through SS_TRACE, to
+			*			   record a trace point if there is a TraceRing or
+			*			   a StateProfile. Costs one test when neither.
+			*/
+			void trace(int state, unsigned int message, ETracePoint point);
+
+			/*
+			*Method: profilePoint
+			*Description: Count a trace point in the profile.
+			*/
+			void profilePoint(int state, unsigned int message, ETracePoint point);
+
+
+		private:
+
+			/*
+			*Method: traceRecord
+			*Description: What trace does when there is a TraceRing or a
+			*			   StateProfile.
+			*/
+			void traceRecord(int state, unsigned int message, ETracePoint point);
+
+			/*
+			*Method: getRoot
+			*Description: Returns the common root object reference.
+			*Param: leaf1 - the first leaf
+			*Param: leaf2 - the second leaf
+			*Return: The common root object reference.
+			*/
+			const BaseState* getRoot(const BaseState* leaf1, const BaseState* leaf2);
+
+			/*
+			*Method: constructTree
+			*Description: Constructs the tree of object references.
+			*Param: root - The common root object reference
+			*Param: state - the leaf
+			*Param: tree - the tree as out param
+			*Return: None
+			*/
+			void constructTree(const BaseState* root, const BaseState* state,
+				BaseStateList& tree);
+
+			/*
+			*Method: constructInitialTree
+			*Description: Constructs the initial state tree.
+			*Param: tree - the tree as out param
+			*Return: None
+			*/
+			void constructInitialTree(BaseStateList& tree);
+
+			/*
+			*Method: registerState
+			*Description: Registers the state, giving it the next number.
+			*Param: stateRef - object reference.
+			*Return: None
+			*/
+			void registerState(BaseState* stateRef);
+
+			/*
+			*Method: findState
+			*Description: Returns the state with the given name, or 0.
+			*			   The map of names is only built when first needed.
+			*/
+			BaseState* findState(const string& stateName) const;
+
+			/*
+			*Method: allocateState
+			*Description: Storage for a state object, from blocks owned by
+			*			   the StateMgr and freed all together with it.
+			*			   See BaseState::operator new.
+			*/
+			void* allocateState(size_t size);
+
+			/*
+			*Method: removeActiveStates
+			*Description: Removes the active states in between the given state
+			*			   and the root and its child states.
+			*Param: state - the leaf state reference.
+			*Param: root - the root object reference.
+			*Return: None
+			*/
+			void removeActiveStates(const BaseState* state, const BaseState* root);
+
+			/*
+			*Method: fireMessage
+			*Description: Sends a message to the target if specified else to all
+			*Param: mesg - the message to send.
+			*Param: target - the target Conurrent state object ref.
+			*Return: None
+			*/
+			void fireMessage(const Mesg& mesg, BaseState* target=0);
+
+			/*
+			*Method: queueMessage
+			*Description: Queue the posted internal messages for delivery.
+			*Param: postMsg - the posted message.
+			*Return: None
+			*Exception: std::string if SS_POSTED_MESG_MAX messages are
+			*			 already waiting.
+			*/
+			void queueMessage(const PostedMesg& postMsg);
+
+			/*
+			*Method sendPostedMessages
+			*Description: Process all internally posted messages
+			*Return: None
+			*/
+			void sendPostedMessages();
+
+			/*
+			*Method: getState
+			*Description: Returns the state with the given number.
+			*Param: stateId - the state number.
+			*Param: what - describes the state for the exception.
+			*Exception: std::string if there is no such state.
+			*/
+			BaseState* getState(int stateId, const char* what) const;
+
+			/*
+			*Methods: clearActiveStates, addInitialStates, isActive
+			*Description: Maintain the active states list, together with a
+			*			   flag for each state number so that isActive
+			*			   does not have to search the list.
+			*/
+			void clearActiveStates();
+			void addInitialStates(const BaseState* state);
+			bool isActive(const BaseState* state) const;
+
+
+		/*ATRIBUTES
+		*/
+		protected:
+
+			/*List of concurrent states.
+			*/
+			BaseStateList myConcStateList;
+
+		private:
+
+			/*Map of name Vs object of registerd states.
+			*/
+			mutable BaseStateMap myStateMap;
+
+			/*Blocks of storage for the states, and the space used in the last.
+			*/
+			vector<char*> myArenaBlocks;
+			size_t myArenaUsed;
+
+			/*Registered states, by number.
+			*/
+			BaseStateList myStates;
+
+			/*Currently active states, and a flag for each state number.
+			*/
+			BaseStateList myActiveStatesList;
+			vector<char> myActiveFlags;
+
+			/*Lists reused by each message, so that handling an event does
+			 *not allocate once they have grown large enough.
+			*/
+			BaseStateList myFireList;
+			BaseStateList myTreeList;
+			BaseStateList myScratchList;
+
+			/*Current status
+			*/
+			bool myStatus;
+
+			/*Posted messages, in a ring. myPostedHead is the oldest.
+			*/
+			PostedMesg myPostedMesgs[SS_POSTED_MESG_MAX];
+			unsigned int myPostedHead;
+			unsigned int myPostedCount;
+
+			/*name of the StateMgr object.
+			*/
+			string myName;
+
+			/*Processing a message or not.
+			*/
+			bool myBusyStatus;
+
+			/*out stream for debug logging if -g is specified while code generation
+			*/
+			ostream* myDebugLogStream;
+
+			/*where to record trace points, or 0.
+			*/
+			TraceRing* myTraceRing;
+
+			/*where to count how long states are active, or 0.
+			*/
+			StateProfile* myProfile;
+
+			/*eTraceToRing and eTraceToProfile, as there are myTraceRing
+			 *and myProfile, so that a trace point tests just this.
+			*/
+			enum {eTraceToRing = 1, eTraceToProfile = 2};
+			unsigned int myTraceFlags;
+
+			/*Events from other threads, see injectEvent.
+			*/
+			EventInbox myInbox;
+	};
+
+	/*INLINES
+	*/
+	inline void StateMgr::trace(int state, unsigned int message, ETracePoint point)
+	{
+		if(myTraceFlags)
+		{
+			traceRecord(state, message, point);
+		}
+	}
+
+	inline const string& StateMgr::getName()
+	{
+		return myName;
+	}
+
+	/*****************************************************************************/
+	/* STATEMGR END*/
+	/*****************************************************************************/
+
+	/*****************************************************************************/
+	/* BASESTATE BEGIN*/
+	/*****************************************************************************/
+	class StateMgr;
+
+	class BaseState
+	{
+		friend class StateMgr;
+
+		protected:
+			BaseState();
+			/*name is kept, not copied. The generated code gives a literal.
+			*/
+			BaseState(const char* name, BaseState* parent, StateMgr* mgr);
+		public:
+			virtual ~BaseState();
+
+			/*States are created with new (mgr) State(...), in storage from
+			 *their StateMgr, which frees it when it is destroyed.
+			 */
+			static void* operator new(size_t size, StateMgr* mgr);
+			static void operator delete(void* state, StateMgr* mgr);
+			static void operator delete(void* state);
+
+		private:
+			BaseState(const BaseState& );
+			BaseState& operator=(const BaseState& );
+
+		public:
+			BaseState* getParent() const;
+			const char* getName() const;
+			int getId() const;
+			EStateType getType() const;
+
+			bool isParent(const BaseState* state) const;
+			void getInitialStates(BaseStateList& iniList) const;
+
+		protected:
+			virtual void onMessage(const Mesg& mesg);
+			void setType(EStateType type);
+			void postMessage(unsigned int message, int wParam = 0, int lParam = 0);
+			void postMessage(string targetState, unsigned int message, int wParam = 0, int lParam = 0);
+			void postMessageToAll(unsigned int message, int wParam = 0, int lParam = 0);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+			static bool isInList(const BaseState* state, const BaseStateList& aList);
+
+		protected:
+			const char* myName;
+			int myId; //given by the StateMgr
+			BaseState* myParent;
+			BaseStateList mySubStates;
+			EStateType myType;
+			StateMgr* myMgr;
+
+			bool myHistory;
+			BaseState* myHistoryState;
+	};
+
+	#define POST postMessage
+	#define POST_ALL postMessageToAll
+
+	/*Trace points in generated code.
+	*/
+	#ifdef SS_NO_TRACE
+	#define SS_TRACE(state, message, point)
+	#else
+	#define SS_TRACE(state, message, point) myMgr->trace(state, message, point)
+	#endif
+
+	inline BaseState* BaseState::getParent() const
+	{
+		return myParent;
+	}
+
+	inline const char* BaseState::getName() const
+	{
+		return myName;
+	}
+
+	inline int BaseState::getId() const
+	{
+		return myId;
+	}
+
+	inline EStateType BaseState::getType() const
+	{
+		return myType;
+	}
+
+	/*****************************************************************************/
+	/* BASESTATE END*/
+	/*****************************************************************************/
+
+} /*end namespace smartstate*/
+
+#endif
@@ -7,18 +7,21 @@ CPP_SRCS += \
 ../src/Ensc351Part6.cpp \
 ../src/Kvm.cpp \
 ../src/Medium.cpp \
+../src/SimConfig.cpp \
 ../src/main.cpp 
 
 CPP_DEPS += \
 ./src/Ensc351Part6.d \
 ./src/Kvm.d \
 ./src/Medium.d \
+./src/SimConfig.d \
 ./src/main.d 
 
 OBJS += \
 ./src/Ensc351Part6.o \
 ./src/Kvm.o \
 ./src/Medium.o \
+./src/SimConfig.o \
 ./src/main.o 
 
 
@@ -34,7 +37,7 @@ src/%.o: ../src/%.cpp src/subdir.mk
 clean: clean-src
 
 clean-src:
-	-$(RM) ./src/Ensc351Part6.d ./src/Ensc351Part6.o ./src/Kvm.d ./src/Kvm.o ./src/Medium.d ./src/Medium.o ./src/main.d ./src/main.o
+	-$(RM) ./src/Ensc351Part6.d ./src/Ensc351Part6.o ./src/Kvm.d ./src/Kvm.o ./src/Medium.d ./src/Medium.o ./src/SimConfig.d ./src/SimConfig.o ./src/main.d ./src/main.o
 
 .PHONY: clean-src
 
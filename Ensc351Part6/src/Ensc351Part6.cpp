@@ -1,96 +1,184 @@
-// Solution to ENSC 351 Part 6.  Prepared by:
-//      - Craig Scratchley, Simon Fraser University
-//      - Zhenwang Yao
-
-//#include <sys/types.h>
-//#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-#include <stdlib.h>
-#include <sys/socket.h>
-#include <pthread.h>
-#include <thread>
-#include <iostream>
-
-#include "myIO.h"
-#include "Medium.h"
-#include "Linemax.h"
-#include "terminal.h"
-#include "Kvm.h"
-#include "VNPE.h"
-#include "SocketReadcond.h"
-
-using namespace std;
-
-enum  {TERM_SIDE, OTHER_SIDE};
-
-static int daSktPrTermMed[2][2];	//Socket Pairs between terminals and Medium
-static int daSktPrTermKvm[2][2];	//  "      " between terminals and kvm
-
-//kvm thread, handles all keyboard input and routes it to the selected terminal
-void kvmFunc() {
-	int d[]{
-   	daSktPrTermKvm[Term1][OTHER_SIDE],
-   	daSktPrTermKvm[Term2][OTHER_SIDE]
-   	};
-
-	Kvm(d);
-	PE(myClose(d[Term1]));
-	PE(myClose(d[Term2]));
-}
-
-//terminal thread
-//at least 2 terminal threads are required to simulate a file transfer on a single computer
-void termFunc(int termNum)
-{
-   PE_0(pthread_setname_np(pthread_self(), to_string(termNum).c_str())); // give the thread a name
-	int inD, outD;
-   inD = outD = daSktPrTermKvm[termNum][TERM_SIDE];
-
-	int mediumD{daSktPrTermMed[termNum][TERM_SIDE]};
-	//mediumD = open("/dev/ser2", O_RDWR);
-
-	Terminal(termNum + 1, inD, outD, mediumD);
-	PE(myClose(mediumD));
-}
-
-void mediumFunc(void)
-{
-   PE_0(pthread_setname_np(pthread_self(), "M")); // give the thread a name
-	Medium medium(daSktPrTermMed[Term1][OTHER_SIDE], daSktPrTermMed[Term2][OTHER_SIDE], "ymodemData.dat");
-	medium.start();
-}
-
-int Ensc351Part5()
-{
-	cout.precision(2);
-	PE_0(pthread_setname_np(pthread_self(), "K")); // give the primary thread (does kvm) a name
-
-	// lower the priority of the primary thread to 4
-//	PE_EOK(pthread_setschedprio(pthread_self(), 4));
-
-	//Create and wire socket pairs
-	// creating socket pair between terminal1 and Medium
-	PE(mySocketpair(AF_LOCAL, SOCK_STREAM, 0, daSktPrTermMed[Term1]));
-	
-	// creating socket pair between terminal2 and Medium
-	PE(mySocketpair(AF_LOCAL, SOCK_STREAM, 0, daSktPrTermMed[Term2]));
-	
-	// opening kvm-term2 socket pair
-	PE(mySocketpair(AF_LOCAL, SOCK_STREAM, 0, daSktPrTermKvm[Term2])); 
-	
-	// opening kvm-term1 socket pair
-	PE(mySocketpair(AF_LOCAL, SOCK_STREAM, 0, daSktPrTermKvm[Term1]));
-
-	//Create 3 threads
-
-	jthread term1Thrd(termFunc, Term1);
-	jthread term2Thrd(termFunc, Term2);
-	
-	// ***** create thread for medium *****
-	jthread mediumThrd(mediumFunc);
-
-	kvmFunc();
-
-	return EXIT_SUCCESS;
-}
+// Solution to ENSC 351 Part 6.  Prepared by:
+//      - Craig Scratchley, Simon Fraser University
+//      - Zhenwang Yao
+
+//#include <sys/types.h>
+//#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <sched.h>			// for cpu_set_t
+#include <pty.h>			// for openpty()
+#include <thread>
+#include <functional>		// for cref()
+#include <iostream>
+#include <initializer_list>
+#include <algorithm>		// for find()
+
+#include "myIO.h"
+#include "Medium.h"
+#include "Linemax.h"
+#include "terminal.h"
+#include "Kvm.h"
+#include "VNPE.h"
+#include "SocketReadcond.h"
+#include "PeerYConfig.h"
+#include "SimConfig.h"
+
+using namespace std;
+
+enum  {TERM_SIDE, OTHER_SIDE};
+
+static int daSktPrTermMed[2][2];	//Socket Pairs (or ptys) between terminals and Medium
+static int daSktPrTermKvm[2][2];	//  "      " between terminals and kvm
+
+// pin the calling thread (and the threads it creates afterwards) to cpu, unless cpu is -1
+static void pinTo(int cpu)
+{
+	if (cpu < 0)
+		return;
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	PE_0(pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus));
+}
+
+// close the descriptors of the socket pairs that this process does not use
+static void keepOnly(initializer_list<int> kept)
+{
+	for (auto sktPr: {daSktPrTermMed, daSktPrTermKvm})
+		for (int term: {Term1, Term2})
+			for (int side: {TERM_SIDE, OTHER_SIDE})
+				if (find(kept.begin(), kept.end(), sktPr[term][side]) == kept.end())
+					PE(myClose(sktPr[term][side]));
+}
+
+//kvm thread, handles all keyboard input and routes it to the selected terminal
+void kvmFunc() {
+	int d[]{
+   	daSktPrTermKvm[Term1][OTHER_SIDE],
+   	daSktPrTermKvm[Term2][OTHER_SIDE]
+   	};
+
+	Kvm(d);
+	PE(myClose(d[Term1]));
+	PE(myClose(d[Term2]));
+}
+
+//terminal thread
+//at least 2 terminal threads are required to simulate a file transfer on a single computer
+void termFunc(int termNum, const SimConfig& sim)
+{
+   PE_0(pthread_setname_np(pthread_self(), to_string(termNum).c_str())); // give the thread a name
+   pinTo(termNum == Term1 ? sim.cpuTerm1 : sim.cpuTerm2);
+	int inD, outD;
+   inD = outD = daSktPrTermKvm[termNum][TERM_SIDE];
+
+	int mediumD{daSktPrTermMed[termNum][TERM_SIDE]};
+	// a serial port (SERIAL_DEV1 or SERIAL_DEV2 in SimConfig), e.g. /dev/ttyS1, replaces the
+	//  link to the Medium.  The peer is then whatever is at the other end of the line.
+	const string& device{termNum == Term1 ? sim.serialDev1 : sim.serialDev2};
+	if (!device.empty()) {
+		PE(myClose(mediumD));
+		mediumD = PE2(myOpenSerial(device.c_str(), sim.baud, sim.flow), device.c_str());
+	}
+
+	Terminal(termNum + 1, inD, outD, mediumD);
+	PE(myClose(mediumD));
+}
+
+void mediumFunc(const SimConfig& sim, const PeerYConfig& cfg)
+{
+   PE_0(pthread_setname_np(pthread_self(), "M")); // give the thread a name
+   pinTo(sim.cpuMedium);
+	Medium medium(daSktPrTermMed[Term1][OTHER_SIDE], daSktPrTermMed[Term2][OTHER_SIDE], "ymodemData.dat",
+		cfg.canLen);
+	medium.pace(sim.serial ? sim.baud : 0);
+	medium.start();
+}
+
+int Ensc351Part5()
+{
+	cout.precision(2);
+	PE_0(pthread_setname_np(pthread_self(), "K")); // give the primary thread (does kvm) a name
+
+	// lower the priority of the primary thread to 4
+//	PE_EOK(pthread_setschedprio(pthread_self(), 4));
+
+	// with CHANNEL_BUF set, the data does not go through the kernel.  With PROCESSES set,
+	//  it goes through memory shared by the processes.
+	const SimConfig sim{SimConfig::load()};
+	const PeerYConfig cfg{PeerYConfig::load()};
+	auto makePair{[&sim](int des[2]) {
+		if (sim.processes)
+			return myShmpair(des, sim.channelBuf ? sim.channelBuf : 4096);
+		return sim.channelBuf ? myChannelpair(des, sim.channelBuf) : mySocketpair(AF_LOCAL, SOCK_STREAM, 0, des);
+	}};
+
+	// with SERIAL set, each terminal has the slave side of a pty as its serial port, and
+	//  the Medium has the master side
+	auto makeLine{[&sim, &makePair](int des[2]) {
+		if (!sim.serial)
+			return makePair(des);
+		if (-1 == openpty(&des[OTHER_SIDE], &des[TERM_SIDE], nullptr, nullptr, nullptr))
+			return -1;
+		return mySerialConfig(des[TERM_SIDE], sim.baud, sim.flow);
+	}};
+
+	//Create and wire socket pairs
+	// creating socket pair between terminal1 and Medium
+	PE(makeLine(daSktPrTermMed[Term1]));
+	
+	// creating socket pair between terminal2 and Medium
+	PE(makeLine(daSktPrTermMed[Term2]));
+	
+	// opening kvm-term2 socket pair
+	PE(makePair(daSktPrTermKvm[Term2])); 
+	
+	// opening kvm-term1 socket pair
+	PE(makePair(daSktPrTermKvm[Term1]));
+
+	if (sim.processes) {
+		// Create 3 processes, each keeping only the descriptors it uses, so that a
+		//  socket pair is closed once the processes using it have closed it
+		auto spawn{[](initializer_list<int> kept, auto body) {
+			pid_t pid{PE(fork())};
+			if (0 == pid) {
+				keepOnly(kept);
+				body();
+				exit(EXIT_SUCCESS);
+			}
+			return pid;
+		}};
+		pid_t pids[]{
+			spawn({daSktPrTermMed[Term1][TERM_SIDE], daSktPrTermKvm[Term1][TERM_SIDE]},
+				[&sim] {termFunc(Term1, sim);}),
+			spawn({daSktPrTermMed[Term2][TERM_SIDE], daSktPrTermKvm[Term2][TERM_SIDE]},
+				[&sim] {termFunc(Term2, sim);}),
+			spawn({daSktPrTermMed[Term1][OTHER_SIDE], daSktPrTermMed[Term2][OTHER_SIDE]},
+				[&sim, &cfg] {mediumFunc(sim, cfg);})
+		};
+		keepOnly({daSktPrTermKvm[Term1][OTHER_SIDE], daSktPrTermKvm[Term2][OTHER_SIDE]});
+
+		kvmFunc();
+
+		for (auto pid: pids)
+			PE(waitpid(pid, nullptr, 0));
+		return EXIT_SUCCESS;
+	}
+
+	//Create 3 threads
+
+	jthread term1Thrd(termFunc, Term1, cref(sim));
+	jthread term2Thrd(termFunc, Term2, cref(sim));
+	
+	// ***** create thread for medium *****
+	jthread mediumThrd(mediumFunc, cref(sim), cref(cfg));
+
+	kvmFunc();
+
+	return EXIT_SUCCESS;
+}
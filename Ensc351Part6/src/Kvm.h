@@ -1,17 +1,17 @@
-/*
- * Kvm.h
- *
- *      Author: wcs
- */
-
-#ifndef KVM_H_
-#define KVM_H_
-
-#include <span>
-
-enum  {Term1, Term2};
-
-void Kvm(std::span<const int> d)
-;
-
-#endif /* KVM_H_ */
+/*
+ * Kvm.h
+ *
+ *      Author: wcs
+ */
+
+#ifndef KVM_H_
+#define KVM_H_
+
+#include <span>
+
+enum  {Term1, Term2};
+
+void Kvm(std::span<const int> d)
+;
+
+#endif /* KVM_H_ */
@@ -1,55 +1,72 @@
-/*
- * Medium.h
- *
- *      Author: Craig Scratchley
- *      Copyright(c) 2024 (Fall) Craig Scratchley
- */
-
-#ifndef MEDIUM_H_
-#define MEDIUM_H_
-
-//comment out "define USE_PART2A_R1_TO_S2"
-// to use the final terminal 1->2 medium. It can drop chars, glitch, etc.
-///#define USE_PART2A_R1_TO_S2
-
-//comment out "define USE_PART2A_S2_TO_R1"
-// to use the final terminal 2->1 medium. It can drop chars, glitch, etc.
-///#define USE_PART2A_S2_TO_R1
-
-class Medium {
-public:
-	Medium(int d1, int d2, const char *fname);
-	virtual ~Medium();
-
-	void start();
-
-private:
-	int Term1D;	// descriptor for Term1
-	int Term2D;	// descriptor for Term2
-	const char* logFileName;
-	int logFileD;	// descriptor for log file
-
-#ifndef USE_PART2A_S2_TO_R1
-	unsigned int fromT2ByteCount;
-	unsigned int corruptThreshold;
-	unsigned int dropThreshold;
-	bool fromT2Glitch;
-#else
-	int byteCount;
-#endif
-
-#ifndef USE_PART2A_R1_TO_S2
-	unsigned char glitchCount;
-	unsigned int fromT1ByteCount;
-	unsigned int sentCount;
-#else
-	int ACKreceived;
-	int ACKforwarded;
-#endif
-	bool sendExtraAck;
-
-	bool MsgFromTerm1();
-	bool MsgFromTerm2();
-};
-
-#endif /* MEDIUM_H_ */
+/*
+ * Medium.h
+ *
+ *      Author: Craig Scratchley
+ *      Copyright(c) 2024 (Fall) Craig Scratchley
+ */
+
+#ifndef MEDIUM_H_
+#define MEDIUM_H_
+
+#include <sys/types.h>	// for ssize_t
+#include <stdint.h>		// for uint8_t
+#include <chrono>
+#include <vector>
+
+//comment out "define USE_PART2A_R1_TO_S2"
+// to use the final terminal 1->2 medium. It can drop chars, glitch, etc.
+///#define USE_PART2A_R1_TO_S2
+
+//comment out "define USE_PART2A_S2_TO_R1"
+// to use the final terminal 2->1 medium. It can drop chars, glitch, etc.
+///#define USE_PART2A_S2_TO_R1
+
+class Medium {
+public:
+	// canLen is the number of CAN characters a terminal sends to cancel (PeerYConfig::canLen)
+	Medium(int d1, int d2, const char *fname, int canLen);
+	virtual ~Medium();
+
+	void start();
+
+	// Pass on the bytes from each terminal no faster than a serial line of baud bits
+	//  per second (10 bits a byte) would deliver them, or as fast as they come for 0.
+	//  A pty, unlike a serial port, does not itself keep to its baud rate.
+	void pace(unsigned baud);
+
+private:
+	int Term1D;	// descriptor for Term1
+	int Term2D;	// descriptor for Term2
+	const char* logFileName;
+	int logFileD;	// descriptor for log file
+
+#ifndef USE_PART2A_S2_TO_R1
+	unsigned int fromT2ByteCount;
+	unsigned int corruptThreshold;
+	unsigned int dropThreshold;
+	bool fromT2Glitch;
+#else
+	int byteCount;
+#endif
+
+#ifndef USE_PART2A_R1_TO_S2
+	unsigned char glitchCount;
+	unsigned int fromT1ByteCount;
+	unsigned int sentCount;
+#else
+	int ACKreceived;
+	int ACKforwarded;
+	std::vector<uint8_t> fromT1Buf;	// canLen bytes, as many as Term1 sends at once
+#endif
+	bool sendExtraAck;
+
+	std::chrono::nanoseconds byteTime;		// the time for a byte on a line, or 0 for no pacing
+	std::chrono::steady_clock::time_point term1LineFree;	// when the line from Term1 ...
+	std::chrono::steady_clock::time_point term2LineFree;	// ... and from Term2 will have sent its bytes
+	ssize_t lineRead(int des, void* buf, size_t nbyte);
+
+	bool MsgFromTerm1();
+	bool MsgFromTerm2();
+};
+
+#endif /* MEDIUM_H_ */
@@ -0,0 +1,86 @@
+/*
+ * SimConfig.cpp
+ *
+ * How the simulator runs the terminals and the Medium.
+ */
+
+#include "SimConfig.h"
+
+#include <stdlib.h>		// for getenv()
+#include <string.h>		// for strcmp()
+#include <errno.h>
+
+#include "PeerYConfig.h"	// for loadSettings() ...
+#include "myIO.h"			// for MY_FLOW_NONE ...
+#include "AtomicCOUT.h"
+
+using namespace std;
+
+SimConfig::
+SimConfig()
+:channelBuf(0),
+ processes(false),
+ cpuTerm1(-1),
+ cpuTerm2(-1),
+ cpuMedium(-1),
+ serial(false),
+ baud(115200),
+ flow(MY_FLOW_NONE)
+{
+}
+
+int
+SimConfig::
+set(const char* key, const char* value)
+{
+	if (!strcmp(key, "SERIAL_DEV1")) {
+		serialDev1 = value;
+		return 0;
+	}
+	if (!strcmp(key, "SERIAL_DEV2")) {
+		serialDev2 = value;
+		return 0;
+	}
+
+	long number{settingNumber(value)};
+	if (number < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (!strcmp(key, "CHANNEL_BUF"))
+		channelBuf = number;
+	else if (!strcmp(key, "PROCESSES"))
+		processes = number;
+	else if (!strcmp(key, "CPU_TERM1"))
+		cpuTerm1 = number;
+	else if (!strcmp(key, "CPU_TERM2"))
+		cpuTerm2 = number;
+	else if (!strcmp(key, "CPU_MEDIUM"))
+		cpuMedium = number;
+	else if (!strcmp(key, "SERIAL"))
+		serial = number;
+	else if (!strcmp(key, "BAUD") && number > 0)
+		baud = number;
+	else if (!strcmp(key, "FLOW") && number <= MY_FLOW_XONXOFF)
+		flow = number;
+	else {
+		errno = EINVAL;
+		return -1;
+	}
+	return 0;
+}
+
+SimConfig
+SimConfig::
+load()
+{
+	SimConfig config;
+	auto set{[&config](const char* key, const char* value) {return config.set(key, value);}};
+	const char* fileName{getenv("YMODEM_SIM_CONFIG")};
+	if (fileName && -1 == loadSettings(fileName, set))
+		CERR << "Cannot read simulator configuration file " << fileName << endl;
+	loadEnvSettings({"CHANNEL_BUF", "PROCESSES", "CPU_TERM1", "CPU_TERM2", "CPU_MEDIUM", "SERIAL", "BAUD", "FLOW",
+		"SERIAL_DEV1", "SERIAL_DEV2"}, set);
+	return config;
+}
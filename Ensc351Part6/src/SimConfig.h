@@ -0,0 +1,38 @@
+/*
+ * SimConfig.h
+ *
+ * How the simulator runs the terminals and the Medium.  These settings are
+ *  read as those of the peers are (see PeerYConfig.h), from the environment
+ *  (e.g. YMODEM_PROCESSES=1) and from the file named by $YMODEM_SIM_CONFIG,
+ *  but they mean nothing to the peers.
+ */
+
+#ifndef SIMCONFIG_H_
+#define SIMCONFIG_H_
+
+#include <string>
+
+struct SimConfig {
+	SimConfig();
+
+	unsigned channelBuf;	// bytes buffered in-process for each simulated link (myChannelpair), or 0 for socketpairs
+	bool processes;			// run the terminals and the Medium as separate processes, linked by myShmpair(),
+							//  rather than as threads
+	int cpuTerm1;			// the CPU to pin terminal 1 to, or -1 for none
+	int cpuTerm2;			//  "   "   "   "  terminal 2  "
+	int cpuMedium;			//  "   "   "   "  the Medium  "
+	bool serial;			// link each terminal to the Medium by a pty, as by a serial line
+	unsigned baud;			// the bits per second of those lines (the Medium is paced to them)
+	int flow;				// their flow control, MY_FLOW_NONE, MY_FLOW_RTSCTS or MY_FLOW_XONXOFF (myIO.h)
+	std::string serialDev1;	// a serial port (e.g. /dev/ttyS1) replacing terminal 1's link to the Medium, or empty
+	std::string serialDev2;	//  "   "     "    "     "      "        "     2's  "   "   "    "      "   "
+
+	/* Set the setting named key (e.g. "PROCESSES", "BAUD") from the text in value.
+	 * Return 0, or -1 with errno set to EINVAL for an unknown key or bad value. */
+	int set(const char* key, const char* value);
+
+	// defaults, then the file named by $YMODEM_SIM_CONFIG (if any), then the environment
+	static SimConfig load();
+};
+
+#endif /* SIMCONFIG_H_ */
@@ -5,11 +5,21 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../PeerY.cpp \
+../PeerYConfig.cpp \
+../PeerYCore.cpp \
+../Reactor.cpp \
 ../ReceiverY.cpp \
+../ReceiverYCore.cpp \
 ../SenderY.cpp \
+../SenderYCore.cpp \
+../SessionPool.cpp \
 ../myIO.cpp \
 ../terminal.cpp \
+../yReceiverChart.cpp \
+../yReceiverCo.cpp \
 ../yReceiverSS.cpp \
+../ySenderChart.cpp \
+../ySenderCo.cpp \
 ../ySenderSS.cpp 
 
 C_SRCS += \
@@ -17,11 +27,21 @@ C_SRCS += \
 
 CPP_DEPS += \
 ./PeerY.d \
+./PeerYConfig.d \
+./PeerYCore.d \
+./Reactor.d \
 ./ReceiverY.d \
+./ReceiverYCore.d \
 ./SenderY.d \
+./SenderYCore.d \
+./SessionPool.d \
 ./myIO.d \
 ./terminal.d \
+./yReceiverChart.d \
+./yReceiverCo.d \
 ./yReceiverSS.d \
+./ySenderChart.d \
+./ySenderCo.d \
 ./ySenderSS.d 
 
 C_DEPS += \
@@ -29,12 +49,22 @@ C_DEPS += \
 
 OBJS += \
 ./PeerY.o \
+./PeerYConfig.o \
+./PeerYCore.o \
+./Reactor.o \
 ./ReceiverY.o \
+./ReceiverYCore.o \
 ./SenderY.o \
+./SenderYCore.o \
+./SessionPool.o \
 ./crc.o \
 ./myIO.o \
 ./terminal.o \
+./yReceiverChart.o \
+./yReceiverCo.o \
 ./yReceiverSS.o \
+./ySenderChart.o \
+./ySenderCo.o \
 ./ySenderSS.o 
 
 
@@ -71,7 +101,7 @@ ySenderSS.o: ../ySenderSS.cpp subdir.mk
 clean: clean--2e-
 
 clean--2e-:
-	-$(RM) ./PeerY.d ./PeerY.o ./ReceiverY.d ./ReceiverY.o ./SenderY.d ./SenderY.o ./crc.d ./crc.o ./myIO.d ./myIO.o ./terminal.d ./terminal.o ./yReceiverSS.d ./yReceiverSS.o ./ySenderSS.d ./ySenderSS.o
+	-$(RM) ./PeerY.d ./PeerY.o ./PeerYConfig.d ./PeerYConfig.o ./PeerYCore.d ./PeerYCore.o ./Reactor.d ./Reactor.o ./ReceiverY.d ./ReceiverY.o ./ReceiverYCore.d ./ReceiverYCore.o ./SenderY.d ./SenderY.o ./SenderYCore.d ./SenderYCore.o ./SessionPool.d ./SessionPool.o ./crc.d ./crc.o ./myIO.d ./myIO.o ./terminal.d ./terminal.o ./yReceiverChart.d ./yReceiverChart.o ./yReceiverCo.d ./yReceiverCo.o ./yReceiverSS.d ./yReceiverSS.o ./ySenderChart.d ./ySenderChart.o ./ySenderCo.d ./ySenderCo.o ./ySenderSS.d ./ySenderSS.o
 
 .PHONY: clean--2e-
 
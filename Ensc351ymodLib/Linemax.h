@@ -1,14 +1,14 @@
-/*
- * Linemax.h
- *
- *  Created on: Mar 8, 2011
- *      Author: wcs
- */
-
-#ifndef LINEMAX_H_
-#define LINEMAX_H_
-
-#define LINEMAX	128	//allocated keyboard buffer length
-#define LINEMAX_SAFE LINEMAX-1
-
-#endif /* LINEMAX_H_ */
+/*
+ * Linemax.h
+ *
+ *  Created on: Mar 8, 2011
+ *      Author: wcs
+ */
+
+#ifndef LINEMAX_H_
+#define LINEMAX_H_
+
+#define LINEMAX	128	//allocated keyboard buffer length
+#define LINEMAX_SAFE LINEMAX-1
+
+#endif /* LINEMAX_H_ */
@@ -0,0 +1,85 @@
+/*
+ * PeerCo.h
+ *
+ * PeerTask is the coroutine type used for the coroutine form of the
+ *  YMODEM sender and receiver (see ySenderCo.cpp and yReceiverCo.cpp).
+ *  A PeerTask does not start until it is started or awaited.  Awaiting
+ *  a PeerTask from another coroutine runs it to completion and then
+ *  resumes the awaiting coroutine, so helpers that have to wait can be
+ *  written as coroutines too.  The waiting itself is done by awaiting
+ *  the PeerYCore functions readN(), discard(), sleepUntil(), drained() and
+ *  nextEvent(), which suspend the coroutine until the core's host (e.g.
+ *  a Reactor) gives it what it waits for.
+ */
+
+#ifndef PEERCO_H_
+#define PEERCO_H_
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+class PeerTask {
+public:
+	struct promise_type {
+		std::coroutine_handle<> continuation; // the coroutine awaiting this one, if any
+		std::exception_ptr exception;
+
+		PeerTask get_return_object() {
+			return PeerTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+		}
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		auto final_suspend() noexcept {
+			struct FinalAwaiter {
+				bool await_ready() noexcept { return false; }
+				std::coroutine_handle<>
+				await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+					auto continuation{h.promise().continuation};
+					return continuation ? continuation : std::noop_coroutine();
+				}
+				void await_resume() noexcept {}
+			};
+			return FinalAwaiter{};
+		}
+		void return_void() {}
+		void unhandled_exception() { exception = std::current_exception(); }
+	};
+
+	PeerTask() = default;
+	PeerTask(PeerTask&& other) : h(std::exchange(other.h, nullptr)) {}
+	PeerTask& operator=(PeerTask&& other) {
+		if (this != &other) {
+			if (h)
+				h.destroy();
+			h = std::exchange(other.h, nullptr);
+		}
+		return *this;
+	}
+	~PeerTask() { if (h) h.destroy(); }
+
+	bool valid() const { return bool(h); }
+	bool done() const { return !h || h.done(); }
+
+	// run a top-level task until it first has to wait
+	void start() { h.resume(); }
+
+	// rethrow any exception that ended the task
+	void check() const {
+		if (h && h.promise().exception)
+			std::rethrow_exception(h.promise().exception);
+	}
+
+	// awaiting a task runs it, and continues the awaiting coroutine when it has finished
+	bool await_ready() const { return done(); }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+		h.promise().continuation = awaiting;
+		return h;
+	}
+	void await_resume() const { check(); }
+
+private:
+	explicit PeerTask(std::coroutine_handle<promise_type> handle) : h(handle) {}
+	std::coroutine_handle<promise_type> h;
+};
+
+#endif /* PEERCO_H_ */
@@ -0,0 +1,241 @@
+//============================================================================
+// File Name   : PeerYConfig.cpp
+// Description : Run-time tunables for the YMODEM peers.
+//============================================================================
+
+#include "PeerYConfig.h"
+
+#include <stdlib.h>     // for getenv(), strtol(), free()
+#include <stdio.h>      // for fopen(), getline()
+#include <string.h>     // for strcmp()
+#include <errno.h>
+#include <string>
+
+#include "PeerYCore.h"
+#include "AtomicCOUT.h"
+
+// comment out the lines below to get rid of Sender/Receiver logging information by default.
+///#define SENDER_REPORT_INFO
+#define RECEIVER_REPORT_INFO
+
+using namespace std;
+
+PeerYConfig::
+PeerYConfig()
+:tmSohC(TM_SOH_C),
+ tmSoh(TM_SOH),
+ tmVL(TM_VL),
+ tm2Char(TM_2CHAR),
+ tmChar(TM_CHAR),
+ tmBlk(TM_BLK),
+#ifdef FAST_SIM
+ fast(true),
+#else
+ fast(false),
+#endif
+ canLen(CAN_LEN),
+ errBound(errB),
+#ifdef SENDER_REPORT_INFO
+ senderReportInfo(true),
+#else
+ senderReportInfo(false),
+#endif
+#ifdef RECEIVER_REPORT_INFO
+ receiverReportInfo(true),
+#else
+ receiverReportInfo(false),
+#endif
+#ifdef ALLOW_DEEMED_GOOD
+ allowDeemedGood(true),
+#else
+ allowDeemedGood(false),
+#endif
+ staticChart(false),
+ smTrace(false),
+ smProfile(false),
+ smDir("/tmp"),
+ drainLowWater(0)
+{
+}
+
+void
+PeerYConfig::
+fastSim(bool fast)
+{
+	this->fast = fast;
+	if (fast) {
+		tmSohC = TM_SOH_C_FAST;
+		tmSoh = TM_SOH_FAST;
+		tmVL = TM_VL_FAST;
+		tm2Char = TM_2CHAR_FAST;
+		tmChar = TM_CHAR_FAST;
+		tmBlk = TM_BLK_FAST;
+	}
+	else {
+		tmSohC = TM_SOH_C_NORMAL;
+		tmSoh = TM_SOH_NORMAL;
+		tmVL = TM_VL_NORMAL;
+		tm2Char = TM_2CHAR_NORMAL;
+		tmChar = TM_CHAR_NORMAL;
+		tmBlk = TM_BLK_NORMAL;
+	}
+}
+
+long
+settingNumber(const char* value)
+{
+	if (!strcmp(value, "true"))
+		return 1;
+	if (!strcmp(value, "false"))
+		return 0;
+	char* end;
+	errno = 0;
+	long result{strtol(value, &end, 10)};
+	if (end == value || *end || errno || result < 0)
+		return -1;
+	return result;
+}
+
+int
+PeerYConfig::
+set(const char* key, const char* value)
+{
+	if (!strcmp(key, "SM_DIR")) {
+		if (!*value) {
+			errno = EINVAL;
+			return -1;
+		}
+		smDir = value;
+		return 0;
+	}
+
+	long number{settingNumber(value)};
+	if (number < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (!strcmp(key, "FAST_SIM"))
+		fastSim(number);
+	else if (!strcmp(key, "REPORT_INFO"))
+		senderReportInfo = receiverReportInfo = number;
+	else if (!strcmp(key, "SENDER_REPORT_INFO"))
+		senderReportInfo = number;
+	else if (!strcmp(key, "RECEIVER_REPORT_INFO"))
+		receiverReportInfo = number;
+	else if (!strcmp(key, "ALLOW_DEEMED_GOOD"))
+		allowDeemedGood = number;
+	else if (!strcmp(key, "STATIC_CHART"))
+		staticChart = number;
+	else if (!strcmp(key, "SM_TRACE"))
+		smTrace = number;
+	else if (!strcmp(key, "SM_PROFILE"))
+		smProfile = number;
+	else if (!strcmp(key, "DRAIN_LOW_WATER"))
+		drainLowWater = number;
+	else if (!strcmp(key, "TM_SOH_C"))
+		tmSohC = number;
+	else if (!strcmp(key, "TM_SOH"))
+		tmSoh = number;
+	else if (!strcmp(key, "TM_VL"))
+		tmVL = number;
+	else if (!strcmp(key, "TM_2CHAR"))
+		tm2Char = number;
+	else if (!strcmp(key, "TM_CHAR"))
+		tmChar = number;
+	else if (!strcmp(key, "TM_BLK"))
+		tmBlk = number;
+	else if (!strcmp(key, "CAN_LEN") && number >= 3) // clearing CANs will not work if CAN_LEN < 3
+		canLen = number;
+	else if (!strcmp(key, "errB"))
+		errBound = number;
+	else {
+		errno = EINVAL;
+		return -1;
+	}
+	return 0;
+}
+
+// strip leading and trailing whitespace (including a newline)
+static string
+trim(const string& str)
+{
+	const char* whitespace{" \t\r\n"};
+	auto begin{str.find_first_not_of(whitespace)};
+	if (begin == string::npos)
+		return "";
+	return str.substr(begin, str.find_last_not_of(whitespace) + 1 - begin);
+}
+
+int
+loadSettings(const char* fileName, const function<int(const char* key, const char* value)>& set)
+{
+	FILE* configFile{fopen(fileName, "r")};
+	if (!configFile)
+		return -1;
+	char* text{nullptr};
+	size_t size{0};
+	int lineNum{0};
+	while (-1 != getline(&text, &size, configFile)) {
+		++lineNum;
+		string line{trim(text)};
+		if (line.empty() || line[0] == '#')
+			continue;
+		auto equals{line.find('=')};
+		string key{trim(line.substr(0, equals))};
+		string value{equals == string::npos ? "" : trim(line.substr(equals + 1))};
+		if (-1 == set(key.c_str(), value.c_str()))
+			CERR << fileName << ":" << lineNum << ": ignoring bad setting '" << line << "'" << endl;
+	}
+	free(text);
+	// getline() fails with errno set when the file cannot be read (e.g. EISDIR), as at its end
+	int readErrno{ferror(configFile) ? errno : 0};
+	fclose(configFile);
+	if (readErrno) {
+		errno = readErrno;
+		return -1;
+	}
+	return 0;
+}
+
+void
+loadEnvSettings(initializer_list<const char*> keys, const function<int(const char* key, const char* value)>& set)
+{
+	for (auto key: keys) {
+		string envName{string("YMODEM_") + key};
+		const char* value{getenv(envName.c_str())};
+		if (value && -1 == set(key, value))
+			CERR << "ignoring bad setting " << envName << "=" << value << endl;
+	}
+}
+
+int
+PeerYConfig::
+loadFile(const char* fileName)
+{
+	return loadSettings(fileName, [this](const char* key, const char* value) {return set(key, value);});
+}
+
+void
+PeerYConfig::
+loadEnv()
+{
+	// FAST_SIM first, so that individual timeouts can override its set.
+	loadEnvSettings({
+		"FAST_SIM", "TM_SOH_C", "TM_SOH", "TM_VL", "TM_2CHAR", "TM_CHAR", "TM_BLK", "CAN_LEN", "errB",
+		"REPORT_INFO", "SENDER_REPORT_INFO", "RECEIVER_REPORT_INFO", "ALLOW_DEEMED_GOOD", "STATIC_CHART", "SM_TRACE",
+		"SM_PROFILE", "SM_DIR", "DRAIN_LOW_WATER"
+	}, [this](const char* key, const char* value) {return set(key, value);});
+}
+
+PeerYConfig
+PeerYConfig::
+load()
+{
+	PeerYConfig config;
+	const char* fileName{getenv("YMODEM_CONFIG")};
+	if (fileName && -1 == config.loadFile(fileName))
+		CERR << "Cannot read YMODEM configuration file " << fileName << endl;
+	config.loadEnv();
+	return config;
+}
@@ -0,0 +1,77 @@
+/*
+ * PeerYConfig.h
+ *
+ * Run-time tunables for the YMODEM peers.  A PeerYConfig is filled in once
+ *  (from its compile-time defaults, an optional file and the environment)
+ *  and then copied into each peer, so the protocol code reads it without
+ *  any locking.
+ */
+
+#ifndef PEERYCONFIG_H_
+#define PEERYCONFIG_H_
+
+#include <string>
+#include <functional>
+#include <initializer_list>
+
+struct PeerYConfig {
+	// the defaults are the compile-time values in PeerYCore.h, so a
+	//  default-constructed PeerYConfig behaves exactly as before.
+	PeerYConfig();
+
+	// timeouts, in units (see UNITS_PER_SEC in PeerYCore.h)
+	int tmSohC;		// waiting for SOH/EOT after sending 'C'
+	int tmSoh;		// waiting for SOH/EOT
+	int tmVL;		// very long timeout
+	int tm2Char;	// a little more than a character time
+	int tmChar;		// a character time
+	int tmBlk;		// the most time for the rest of a block, once its SOH has arrived
+	bool fast;		// the set of timeouts chosen last was the FAST_SIM one (see fastSim())
+
+	int canLen;			// the number of CAN characters to send to cancel a transmission
+	unsigned errBound;	// the number of errors in a row that are allowed
+
+	bool senderReportInfo;		// should the sender report debugging information
+	bool receiverReportInfo;	// should the receiver report debugging information
+	bool allowDeemedGood;		// treat a resent copy of the last good block as "deemed" good
+	bool staticChart;			// run the statecharts on the StaticChart engine instead of SmartState
+	bool smTrace;				// record SmartState trace points, written to a log file after each session
+	bool smProfile;				// profile the SmartState statecharts, added to a file after each session
+	std::string smDir;			// the directory for those files (e.g. SenderSS.log, ReceiverSS.prof)
+
+	unsigned drainLowWater;	// bytes a drain of the medium may leave unread (myTcdrainTo), or 0 to drain it all
+
+	// select the FAST_SIM (true) or the normal (false) set of timeouts
+	void fastSim(bool fast);
+
+	/* Set the tunable named key (named as the corresponding macro in PeerYCore.h,
+	 *  e.g. "TM_VL", "CAN_LEN", "errB", "REPORT_INFO") from the text in value.
+	 * Return 0, or -1 with errno set to EINVAL for an unknown key or bad value. */
+	int set(const char* key, const char* value);
+
+	/* Read "key = value" lines from the named file (see loadSettings()).
+	 *  Return 0, or -1 (with errno set) if the file cannot be read. */
+	int loadFile(const char* fileName);
+
+	// apply any YMODEM_<key> environment variables, e.g. YMODEM_TM_CHAR=2
+	void loadEnv();
+
+	// defaults, then the file named by $YMODEM_CONFIG (if any), then the environment
+	static PeerYConfig load();
+};
+
+// for other sets of settings read in the same way, e.g. the simulator's (SimConfig in Ensc351Part6)
+
+// parse a non-negative decimal integer, or "true" (1) or "false" (0).  Return -1 if value is none of these.
+long settingNumber(const char* value);
+
+/* Read "key = value" lines from the named file, giving each to set, which returns -1 for
+ *  a bad one (reported, then ignored).  Blank lines and lines starting with '#' are
+ *  ignored.  Return 0, or -1 with errno set if the file cannot be opened or read. */
+int loadSettings(const char* fileName, const std::function<int(const char* key, const char* value)>& set);
+
+// give set each of keys that is in the environment as YMODEM_<key>, e.g. YMODEM_TM_CHAR=2
+void loadEnvSettings(std::initializer_list<const char*> keys,
+	const std::function<int(const char* key, const char* value)>& set);
+
+#endif /* PEERYCONFIG_H_ */
@@ -0,0 +1,758 @@
+//============================================================================
+// File Name   : PeerYCore.cpp
+// Description : The YMODEM protocol with no I/O of its own (see PeerYCore.h).
+//============================================================================
+
+#include "PeerYCore.h"
+
+#include <errno.h>
+#include <algorithm>
+#include <fstream>
+#include <atomic>	// for atomic_ref, atomic_thread_fence()
+#include <sched.h>	// for sched_yield()
+#include <string.h>	// for memcpy(), strnlen()
+
+#include "AtomicCOUT.h"
+
+using namespace std;
+using namespace smartstate;
+
+PeerYCore::
+PeerYCore(char left, char right, const char *smLogN, const char *smProfN, const PeerYConfig& config)
+:cfg(config),
+ logLeft(left),
+ logRight(right),
+ smLogName(config.smDir + '/' + smLogN),
+ smProfileName(config.smDir + '/' + smProfN)
+{
+}
+
+//Send a byte to the remote peer across the medium
+void
+PeerYCore::
+sendByte(uint8_t byte)
+{
+	if (reportInfo) {
+	    //*** remove all but last of this block ***
+	     char displayByte;
+        if (byte == NAK)
+            displayByte = 'N';
+        else if (byte == ACK)
+            displayByte = 'A';
+        else if (byte == EOT)
+            displayByte = 'E';
+        else
+            displayByte = byte;
+        COUT << logLeft << displayByte << ":" << (int)(unsigned char) byte << logRight << flush;        
+	}
+	mediumWrite(&byte, sizeof(byte));
+}
+
+/*
+set a timeout time at an absolute time timeoutUnits into
+the future. That is, determine an absolute time to be used
+for the next one or more XMODEM timeouts by adding
+timeoutUnits to the current time.
+*/
+void 
+PeerYCore::
+tm(int timeoutUnits)
+{
+	queueSessionOp(OP_TM, timeoutUnits);
+}
+
+/* make the absolute timeout earlier by reductionUnits */
+void 
+PeerYCore::
+tmRed(int unitsToReduce)
+{
+	queueSessionOp(OP_TM_RED, unitsToReduce);
+}
+
+/*
+Store the current absolute timeout, and create a temporary
+absolute timeout timeoutUnits into the future.
+*/
+void 
+PeerYCore::
+tmPush(int timeoutUnits)
+{
+	queueSessionOp(OP_TM_PUSH, timeoutUnits);
+}
+
+/*
+Discard the temporary absolute timeout and revert to the
+stored absolute timeout
+*/
+void 
+PeerYCore::
+tmPop()
+{
+	queueSessionOp(OP_TM_POP);
+}
+
+void
+PeerYCore::
+setTimer(SessionOpKind kind, int units)
+{
+	switch (kind) {
+	case OP_TM:
+		absoluteTimeout = now + units * uSECS_PER_UNIT;
+		break;
+	case OP_TM_RED:
+		absoluteTimeout -= (units * uSECS_PER_UNIT);
+		break;
+	case OP_TM_PUSH:
+		holdTimeout = absoluteTimeout;
+		absoluteTimeout = now + units * uSECS_PER_UNIT;
+		break;
+	case OP_TM_POP:
+		absoluteTimeout = holdTimeout;
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+Read and discard contiguous CAN characters.  Take characters
+from the medium one-by-one until (cfg.canLen - 2) CAN characters
+are received or nothing is
+received over the specified timeout period or a character other than
+CAN is received. If received, send a non-CAN character to
+the console.
+*/
+void PeerYCore::clearCan(const int canTimeout)
+{
+	queueSessionOp(OP_CLEAR_CAN, canTimeout);
+}
+
+PeerTask
+PeerYCore::
+clearCanCo(const int canTimeout)
+{
+	char character{CAN};
+	int bytesRead;
+	int totalBytesRd{0};
+	// will not work if cfg.canLen < 3
+	do {
+		bytesRead = co_await readN(&character, sizeof(character), sizeof(character), canTimeout, canTimeout);
+		totalBytesRd += bytesRead;
+	} while (bytesRead && character==CAN && totalBytesRd < (cfg.canLen - 2));
+	if (character != CAN)
+		consoleOut += character;
+}
+
+void
+PeerYCore::
+mediumWrite(const void* buf, int n)
+{
+	queueSessionOp(OP_WRITE, 0, buf, n);
+}
+
+void
+PeerYCore::
+mediumSleep(int mSecs)
+{
+	queueSessionOp(OP_SLEEP, mSecs);
+}
+
+/* Bytes that a statechart action needs are waited for before the byte that
+ *  leads to the action is posted (see readAheadFor()), so take them without waiting. */
+int
+PeerYCore::
+takeInput(void* buf, int n)
+{
+	int count{std::min(n, (int) sessionInput.size())};
+	std::copy_n(sessionInput.begin(), count, (uint8_t*) buf);
+	sessionInput.erase(sessionInput.begin(), sessionInput.begin() + count);
+	return count;
+}
+
+void
+PeerYCore::
+queueSessionOp(SessionOpKind kind, int units, const void* buf, int n)
+{
+	// timer operations and writes only need to wait if something is ahead of them.
+	if (!deferring() && kind <= OP_TM_POP) {
+		if (kind == OP_WRITE)
+			mediumOut.append((const char*) buf, n);
+		else
+			setTimer(kind, units);
+		return;
+	}
+	SessionOp op{kind, units};
+	if (buf)
+		op.bytes.assign((const char*) buf, n);
+	sessionOps.push_back(move(op));
+}
+
+ssize_t
+PeerYCore::
+fileRequest(const FileRequest& request)
+{
+	if (!fileHandler) {
+		errno = ENOSYS;
+		return -1;
+	}
+	return fileHandler(request);
+}
+
+namespace
+{
+// a SmartState machine seen as a SessionChart.  Given a traceName, it records
+//  the machine's trace points and writes them to that file when it is done.
+//  Given a profileName, it adds a profile of each transfer to that file.
+class SmartStateChart : public SessionChart
+{
+public:
+	SmartStateChart(shared_ptr<StateMgr> mySM, string traceName, string profileName)
+	:sm(move(mySM)), traceName(move(traceName)), profileName(move(profileName))
+	{
+		if (!this->traceName.empty()) {
+			traceRing = make_unique<TraceRing>();
+			sm->setTrace(traceRing.get());
+		}
+		if (!this->profileName.empty()) {
+			profile = make_unique<StateProfile>();
+			sm->setProfile(profile.get());
+		}
+	}
+	~SmartStateChart() override
+	{
+		if (profile)
+			sm->setProfile(nullptr);
+		if (!traceRing)
+			return;
+		sm->setTrace(nullptr);
+		ofstream traceFile(traceName, ios::trunc);
+		if (traceFile.is_open())
+			sm->dumpTrace(traceFile, *traceRing);
+		else
+			CERR << "Error opening state chart trace file named: " << traceName << endl;
+	}
+	// reInit(), in case the machine is being reused (see SenderYCore::shareChart())
+	void start() override { sm->reInit(); }
+	void postEvent(unsigned int event, int wParam) override { sm->postEvent(event, wParam); }
+	bool isRunning() const override { return sm->isRunning(); }
+	int drainInjected() override { return sm->drainInjected(); }
+	bool hasInjected() const override { return sm->hasInjected(); }
+	size_t snapshot(uint8_t* buf, size_t n) const override { return sm->snapshot(buf, n); }
+	// add the profile of the transfer to the file, after its result (see StateProfile::diff())
+	void finished(const string& result) override
+	{
+		if (!profile)
+			return;
+		ofstream profileFile(profileName, ios::app);
+		if (!profileFile.is_open()) {
+			CERR << "Error opening state chart profile file named: " << profileName << endl;
+			return;
+		}
+		sm->dumpProfile(profileFile, *profile);
+		profileFile << "result " << result << endl;
+	}
+	bool restore(const uint8_t* buf, size_t n) override
+	{
+		try {
+			sm->restore(buf, n);
+			return true;
+		}
+		catch (const string& reason) {
+			CERR << reason << endl;
+			return false;
+		}
+	}
+
+protected:
+	bool pushInjected(unsigned int event, int wParam) override { return sm->injectEvent(event, wParam); }
+
+private:
+	shared_ptr<StateMgr> sm;
+	string traceName;
+	unique_ptr<TraceRing> traceRing;
+	string profileName;
+	unique_ptr<StateProfile> profile;
+};
+}
+
+void
+PeerYCore::
+beginSession(std::shared_ptr<StateMgr> mySM, bool reportInfoParam)
+{
+   // the generated code records binary trace points rather than logging text (see
+   // ss_api.hxx).  With cfg.smTrace they are written to the file named smLogName.
+   mySM->setDebugLog(nullptr);
+
+	beginSession(make_shared<SmartStateChart>(mySM, cfg.smTrace ? smLogName : string(),
+	                                          cfg.smProfile ? smProfileName : string()), reportInfoParam);
+}
+
+void
+PeerYCore::
+beginSession(std::shared_ptr<SessionChart> chart, bool reportInfoParam)
+{
+	reportInfo = reportInfoParam;
+	sessionSM = chart;
+	started = false;
+	sessionOps.clear();
+	sessionInput.clear();
+	readAheadDeadline = readAheadCharDeadline = 0;
+	readAheadHave = 0;
+	mediumClosed = drainDone = kbPending = false;
+}
+
+void
+PeerYCore::
+beginSession(PeerTask task, bool reportInfoParam)
+{
+	reportInfo = reportInfoParam;
+	sessionTask = move(task);
+	started = false;
+	sessionWaiter = nullptr;
+	wait.kind = WAIT_NONE;
+	sessionInput.clear();
+	mediumClosed = drainDone = kbPending = false;
+}
+
+void
+PeerYCore::
+endSession()
+{
+	PeerTask task{move(sessionTask)};
+	if (sessionSM)
+		sessionSM->finished(result);
+	sessionSM.reset();
+	sessionOps.clear();
+	sessionInput.clear();
+	sessionWaiter = nullptr;
+	sessionEnded();
+	task.check();
+}
+
+bool
+PeerYCore::
+snapshot(SessionSnapshot& snap) const
+{
+	if (!sessionSM || !started || !sessionOps.empty() || !sessionInput.empty() || kbPending
+			|| !mediumOut.empty() || !sessionSM->isRunning() || sessionSM->hasInjected()
+			|| result.size() >= SNAPSHOT_RESULT_SZ)
+		return false;
+
+	uint8_t chart[SNAPSHOT_CHART_SZ];
+	size_t chartSz{sessionSM->snapshot(chart, SNAPSHOT_CHART_SZ)};
+	if (!chartSz)
+		return false;
+
+	// a reader (e.g. a standby, after this process has died) must not take half a
+	//  snapshot.  If a process died while taking one, seq is already odd.
+	atomic_ref<uint32_t> seq{snap.seq};
+	const uint32_t taking{seq.load(memory_order_relaxed) | 1};
+	seq.store(taking, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	snap.magic = SessionSnapshot::MAGIC;
+	snap.chartSz = chartSz;
+	memcpy(snap.chart, chart, chartSz);
+	snap.peer = logLeft;
+	memcpy(snap.result, result.c_str(), result.size() + 1);
+	snap.errCnt = errCnt;
+	snap.KbCan = KbCan;
+	snap.fileOpen = transferringFileD >= 0;
+	snap.fileOffset = fileOffset;
+	snap.timeoutLeft = absoluteTimeout - now;
+	snap.holdTimeoutLeft = holdTimeout - now;
+	snapshotPeer(snap.peerState);
+	seq.store(taking + 1, memory_order_release);
+	return true;
+}
+
+bool
+SessionSnapshot::
+read(SessionSnapshot& copy) const
+{
+	atomic_ref<uint32_t> seqRef{const_cast<uint32_t&>(seq)};
+	for (int tries{0}; tries < 100; ++tries) {
+		const uint32_t before{seqRef.load(memory_order_acquire)};
+		if (before & 1) {
+			sched_yield(); // wait for the snapshot to be finished
+			continue;
+		}
+		memcpy(&copy, this, sizeof(copy));
+		atomic_thread_fence(memory_order_acquire);
+		if (seqRef.load(memory_order_relaxed) == before)
+			return copy.magic == MAGIC;
+	}
+	return false;
+}
+
+bool
+PeerYCore::
+restoreSession(const SessionSnapshot& shared, long long nowUsecs)
+{
+	SessionSnapshot snap;
+	if (!shared.read(snap) || snap.peer != logLeft || !sessionSM
+			|| snap.chartSz > SNAPSHOT_CHART_SZ || !sessionSM->restore(snap.chart, snap.chartSz)) {
+		sessionSM.reset();
+		return false;
+	}
+	started = true;
+	now = nowUsecs;
+	result.assign(snap.result, strnlen(snap.result, SNAPSHOT_RESULT_SZ));
+	errCnt = snap.errCnt;
+	KbCan = snap.KbCan;
+	transferringFileD = -1; // until restorePeer() reopens the file
+	fileOffset = snap.fileOffset;
+	absoluteTimeout = now + snap.timeoutLeft;
+	holdTimeout = now + snap.holdTimeoutLeft;
+	if (!restorePeer(snap.peerState, snap)) {
+		sessionSM.reset();
+		return false;
+	}
+	return true;
+}
+
+void
+PeerYCore::
+input(const void* bytes, int n)
+{
+	if (running())
+		sessionInput.insert(sessionInput.end(), (const uint8_t*) bytes, (const uint8_t*) bytes + n);
+}
+
+bool
+PeerYCore::
+wantsDrain() const
+{
+	if (sessionSM)
+		return !sessionOps.empty() && sessionOps.front().kind == OP_DRAIN;
+	return sessionWaiter && wait.kind == WAIT_DRAIN;
+}
+
+bool
+PeerYCore::
+wantsConsole() const
+{
+	if (sessionSM)
+		return sessionOps.empty();
+	return sessionWaiter && wait.kind == WAIT_EVENT;
+}
+
+long long
+PeerYCore::
+deadline() const
+{
+	if (!running())
+		return -1;
+	if (!started)
+		return now;
+	if (!sessionSM) {
+		if (!sessionWaiter)
+			return now;
+		if (wait.kind == WAIT_DRAIN)
+			return drainDone ? now : -1;
+		if (wait.kind == WAIT_EVENT) {
+			if (kbPending)
+				return now;
+			if (!sessionInput.empty())
+				return readAheadDeadline ? std::min(readAheadDeadline, readAheadCharDeadline) : now;
+			return absoluteTimeout;
+		}
+		return wait.deadline;
+	}
+	if (!sessionOps.empty()) {
+		const auto& op{sessionOps.front()};
+		if (op.kind == OP_DRAIN)
+			return drainDone ? now : -1;
+		if (op.kind >= OP_SLEEP && op.deadline)
+			return op.deadline;
+		return now;
+	}
+	if (kbPending || !sessionSM->isRunning() || sessionSM->hasInjected())
+		return now;
+	if (!sessionInput.empty())
+		return readAheadDeadline ? std::min(readAheadDeadline, readAheadCharDeadline) : now;
+	return absoluteTimeout;
+}
+
+/* Make progress on the operation at the head of sessionOps.
+ * Return true if it has finished. */
+bool
+PeerYCore::
+runSessionOp()
+{
+	auto& op{sessionOps.front()};
+	switch (op.kind) {
+	case OP_WRITE:
+		mediumOut += op.bytes;
+		return true;
+	case OP_TM:
+	case OP_TM_RED:
+	case OP_TM_PUSH:
+	case OP_TM_POP:
+		setTimer(op.kind, op.units);
+		return true;
+	case OP_SLEEP:
+		if (!op.deadline)
+			op.deadline = now + op.units * 1000LL;
+		return now >= op.deadline;
+	case OP_DRAIN:
+		return std::exchange(drainDone, false);
+	case OP_DUMP: {
+		int dumped{discardInput()};
+		if (reportInfo)
+			COUT << logLeft << "d" << dumped << logRight << flush;
+		return true;
+	}
+	case OP_PURGE:
+		// until at least 10 bytes or 5 units have gone by.
+		if (!op.deadline)
+			op.deadline = now + 5 * uSECS_PER_UNIT;
+		while (!sessionInput.empty() && op.count < BUF_SZ) {
+			sessionInput.pop_front();
+			++op.count;
+		}
+		return op.count >= 10 || now >= op.deadline || mediumClosed;
+	case OP_CLEAR_CAN:
+		// one character timeout per CAN
+		if (!op.deadline)
+			op.deadline = now + op.units * uSECS_PER_UNIT;
+		while (!sessionInput.empty()) {
+			uint8_t character{sessionInput.front()};
+			sessionInput.pop_front();
+			if (character != CAN) {
+				consoleOut += character;
+				return true;
+			}
+			if (++op.count >= cfg.canLen - 2)
+				return true;
+			op.deadline = now + op.units * uSECS_PER_UNIT;
+		}
+		return now >= op.deadline || mediumClosed;
+	}
+	return true;
+}
+
+/* Make as much progress as possible: finish what operations can be
+ *  finished, then deliver cancels, input and timeouts to the statechart,
+ *  or resume the coroutine while what it waits for is ready. */
+void
+PeerYCore::
+tick(long long nowUsecs)
+{
+	now = nowUsecs;
+	if (sessionTask.valid()) {
+		if (!started) {
+			started = true;
+			sessionTask.start();
+		}
+		while (sessionWaiter && waitReady()) {
+			auto waiter{sessionWaiter};
+			sessionWaiter = nullptr;
+			waiter.resume(); // runs until the coroutine next waits or finishes
+		}
+		if (sessionTask.done())
+			endSession();
+		return;
+	}
+	if (sessionSM && !started) {
+		started = true;
+		sessionSM->start();
+	}
+	while (sessionSM) {
+		while (!sessionOps.empty()) {
+			if (!runSessionOp())
+				return;
+			sessionOps.pop_front();
+		}
+		if (!sessionSM->isRunning()) {
+			endSession();
+			return;
+		}
+		if (kbPending) {
+			kbPending = false;
+			sessionSM->postEvent(KB_C); // keyboard cancel event, seen before KbCan is set
+			KbCan = true;
+			continue;
+		}
+		// events from other threads, between those from the medium
+		if (sessionSM->drainInjected())
+			continue;
+		if (!sessionInput.empty()) {
+			if (readingAhead())
+				return; // wait for more input
+			uint8_t byte{sessionInput.front()};
+			sessionInput.pop_front();
+			if (reportInfo)
+				COUT << logLeft << (int) byte << logRight << flush;
+			sessionSM->postEvent(SER, byte);
+			continue;
+		}
+		if (now >= absoluteTimeout)
+			// only one timeout per tick, as select() with no time left would give.
+			sessionSM->postEvent(TM);
+		return;
+	}
+}
+
+/* Should the byte at the front of sessionInput wait until the bytes that
+ *  readAheadFor() asks for have arrived, or its timers have run out?
+ *  Starts the timers, and restarts the character timer as bytes arrive. */
+bool
+PeerYCore::
+readingAhead()
+{
+	int timeUnits{0}, timeoutUnits{0};
+	unsigned needed = readAheadFor(sessionInput.front(), timeUnits, timeoutUnits);
+	if (needed && sessionInput.size() - 1 < needed && !mediumClosed) {
+		if (!readAheadDeadline) {
+			readAheadDeadline = now + timeoutUnits * uSECS_PER_UNIT;
+			readAheadHave = 0;
+		}
+		if (sessionInput.size() != readAheadHave) { // more has arrived
+			readAheadHave = sessionInput.size();
+			readAheadCharDeadline = now + timeUnits * uSECS_PER_UNIT;
+		}
+		if (now < std::min(readAheadDeadline, readAheadCharDeadline))
+			return true;
+	}
+	readAheadDeadline = 0;
+	return false;
+}
+
+int
+PeerYCore::
+discardInput()
+{
+	int count = sessionInput.size();
+	sessionInput.clear();
+	return count;
+}
+
+PeerYCore::SessionWait
+PeerYCore::
+readN(void* buf, int n, int min, int timeUnits, int timeoutUnits)
+{
+	wait.kind = WAIT_READ;
+	wait.buf = (uint8_t*) buf;
+	wait.n = n;
+	wait.min = min;
+	wait.units = timeUnits;
+	wait.count = sessionInput.size();
+	wait.limit = now + timeoutUnits * uSECS_PER_UNIT;
+	wait.deadline = std::min(wait.limit, now + timeUnits * uSECS_PER_UNIT);
+	return {*this};
+}
+
+PeerYCore::SessionWait
+PeerYCore::
+discard(int timeUnits, int minBytes)
+{
+	wait.kind = WAIT_DISCARD;
+	wait.min = minBytes;
+	wait.count = 0;
+	wait.deadline = now + timeUnits * uSECS_PER_UNIT;
+	return {*this};
+}
+
+PeerYCore::SessionWait
+PeerYCore::
+sleepUntil(long long usecs)
+{
+	wait.kind = WAIT_SLEEP;
+	wait.deadline = usecs;
+	return {*this};
+}
+
+PeerYCore::SessionWait
+PeerYCore::
+sleepFor(int mSecs)
+{
+	return sleepUntil(now + mSecs * 1000LL);
+}
+
+PeerYCore::SessionWait
+PeerYCore::
+drained()
+{
+	wait.kind = WAIT_DRAIN;
+	drainDone = false;
+	return {*this};
+}
+
+PeerYCore::SessionWait
+PeerYCore::
+nextEvent()
+{
+	wait.kind = WAIT_EVENT;
+	return {*this};
+}
+
+bool
+PeerYCore::
+waitReady()
+{
+	switch (wait.kind) {
+	case WAIT_READ:
+		// each byte that arrives restarts the character timer
+		if ((int) sessionInput.size() > wait.count) {
+			wait.count = sessionInput.size();
+			wait.deadline = std::min(wait.limit, now + wait.units * uSECS_PER_UNIT);
+		}
+		return (int) sessionInput.size() >= wait.min || now >= wait.deadline || mediumClosed;
+	case WAIT_DISCARD:
+		// as OP_PURGE in runSessionOp()
+		while (!sessionInput.empty() && wait.count < BUF_SZ) {
+			sessionInput.pop_front();
+			++wait.count;
+		}
+		return wait.count >= wait.min || now >= wait.deadline || mediumClosed;
+	case WAIT_SLEEP:
+		return now >= wait.deadline;
+	case WAIT_DRAIN:
+		return drainDone;
+	case WAIT_EVENT:
+		// as tick() for the statecharts, which also waits for read-ahead
+		if (kbPending)
+			return true;
+		if (!sessionInput.empty())
+			return !readingAhead();
+		return now >= absoluteTimeout;
+	default:
+		return true;
+	}
+}
+
+int
+PeerYCore::
+waitResult()
+{
+	int result{0};
+	switch (wait.kind) {
+	case WAIT_READ:
+		result = std::min(wait.n, (int) sessionInput.size());
+		std::copy_n(sessionInput.begin(), result, wait.buf);
+		sessionInput.erase(sessionInput.begin(), sessionInput.begin() + result);
+		break;
+	case WAIT_DRAIN:
+		drainDone = false;
+		break;
+	case WAIT_EVENT:
+		// a cancel first, as tick() posts KB_C before the input
+		if (kbPending) {
+			kbPending = false;
+			result = EV_KB_C;
+		}
+		else if (!sessionInput.empty()) {
+			result = sessionInput.front();
+			sessionInput.pop_front();
+			if (reportInfo)
+				COUT << logLeft << result << logRight << flush;
+		}
+		else
+			result = EV_TM;
+		break;
+	default:
+		break;
+	}
+	wait.kind = WAIT_NONE;
+	return result;
+}
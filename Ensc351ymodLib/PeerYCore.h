@@ -0,0 +1,406 @@
+/*
+ * PeerYCore.h
+ *
+ * The YMODEM protocol with no I/O of its own.  A core is driven entirely by
+ *  its host: the host gives it the bytes that arrive from the medium, keyboard
+ *  cancels and the time, and takes from it the bytes to send to the medium
+ *  and to the console.  Files are only reached through FileRequests, which
+ *  the host carries out.  The statecharts (ySenderSS and yReceiverSS) and the
+ *  coroutine forms of the protocol run on a core.  PeerY (and SenderY and
+ *  ReceiverY) host a core on descriptors (see myIO.h), but it can as well be
+ *  run from another event loop or from interrupt-driven UART code.
+ */
+
+#ifndef PEERYCORE_H_
+#define PEERYCORE_H_
+
+#include <cstdint> // for uint8_t
+#include <sys/types.h> // for ssize_t, mode_t
+#include <memory>
+#include <string>
+#include <deque>
+#include <functional>
+
+#include "ss_api.hxx"
+#include "crc.h"
+#include "PeerYConfig.h"
+#include "PeerCo.h"
+#include "StaticChart.h"
+
+//#define CHUNK_SZ	 128
+#define SOH_OH  	 1			//SOH Byte Overhead
+#define BLK_NUM_AND_COMP_OH  2	//Overhead for blkNum and its complement
+#define DATA_POS  	 (SOH_OH + BLK_NUM_AND_COMP_OH)	//Position of data in buffer
+#define PAST_CHUNK 	 (DATA_POS + CHUNK_SZ)		//Position of checksum in buffer
+
+#define CS_OH           1			                    //Overhead for CheckSum
+#define REST_BLK_OH_CS  (BLK_NUM_AND_COMP_OH + CS_OH)	//Overhead in rest of block
+#define REST_BLK_SZ_CS  (CHUNK_SZ + REST_BLK_OH_CS)
+#define BLK_SZ_CS  	 	(SOH_OH + REST_BLK_SZ_CS)
+#define MOST_BLK_SZ_CS	(BLK_SZ_CS - 1)
+
+#define CRC_OH           2			                    //Overhead for CRC16
+#define REST_BLK_OH_CRC  (BLK_NUM_AND_COMP_OH + CRC_OH)	//Overhead in rest of block
+#define REST_BLK_SZ_CRC  (CHUNK_SZ + REST_BLK_OH_CRC)
+#define BLK_SZ_CRC  	 (SOH_OH + REST_BLK_SZ_CRC)
+#define MOST_BLK_SZ_CRC	 (BLK_SZ_CRC - 1)
+
+#define GLITCH_SPACE  30			//Space for extra glitch bytes
+#define BUF_SZ  (BLK_SZ_CRC + GLITCH_SPACE)
+
+#define CAN_LEN 8 // was 2 // the number of CAN characters to send to cancel a transmission
+
+#define errB 10 // the error bound.  The number of errors in a row that are allowed.
+
+#define CANC_C	"&c\n" // string for cancel command
+
+// define names for control characters used in the protocol.
+#define SOH 0x01
+#define EOT 0x04
+#define ACK 0x06
+#define NAK 0x15
+#define CAN 0x18 // 24  
+#define	CTRL_Z 0x1A //	26
+
+#define FAST_SIM
+
+// treat a resent copy of the last good block as a "deemed" good block
+//#define ALLOW_DEEMED_GOOD
+
+// CAN_LEN, errB, the timeouts below and the switches above are only
+//  defaults.  They can be changed at run time with a PeerYConfig.
+
+// timeouts in units
+// for fast simulation
+#define TM_SOH_C_FAST (.5*UNITS_PER_SEC) // timeout waiting for SOH/EOT (normally 3 seconds)
+//#define TM_END_FAST (.5*UNITS_PER_SEC) // timeout waiting for SOH/EOT (normally 3 seconds)
+#define TM_SOH_FAST (.9*UNITS_PER_SEC) // timeout waiting for SOH/EOT -- should normally be 10 seconds
+#define TM_VL_FAST  (15*UNITS_PER_SEC) // Very long timeout -- normally 60 seconds
+#define TM_2CHAR_FAST (.4*UNITS_PER_SEC) // normally wait for more than 1 second (1 second plus)
+#define TM_CHAR_FAST (.2*UNITS_PER_SEC) // normally wait for 1 second
+#define TM_BLK_FAST (1*UNITS_PER_SEC) // the rest of a block, in all (normally 5 seconds)
+// normal
+#define TM_SOH_C_NORMAL (3*UNITS_PER_SEC) // timeout waiting for SOH/EOT (3 seconds)
+//#define TM_END_NORMAL (3*UNITS_PER_SEC) // timeout waiting for SOH/EOT (3 seconds)
+#define TM_SOH_NORMAL (10*UNITS_PER_SEC) // timeout waiting for SOH/EOT (10 seconds)
+#define TM_VL_NORMAL  (60*UNITS_PER_SEC) // Very long timeout (60 seconds)
+#define TM_2CHAR_NORMAL (2*UNITS_PER_SEC) // wait for more than 1 second (1 second plus)
+#define TM_CHAR_NORMAL (1*UNITS_PER_SEC) // wait for 1 second
+#define TM_BLK_NORMAL (5*UNITS_PER_SEC) // the rest of a block, in all (132 bytes take 4.4 seconds at 300 baud)
+
+#ifdef FAST_SIM
+#define TM_SOH_C TM_SOH_C_FAST
+#define TM_SOH   TM_SOH_FAST
+#define TM_VL    TM_VL_FAST
+#define TM_2CHAR TM_2CHAR_FAST
+#define TM_CHAR  TM_CHAR_FAST
+#define TM_BLK   TM_BLK_FAST
+#else
+#define TM_SOH_C TM_SOH_C_NORMAL
+#define TM_SOH   TM_SOH_NORMAL
+#define TM_VL    TM_VL_NORMAL
+#define TM_2CHAR TM_2CHAR_NORMAL
+#define TM_CHAR  TM_CHAR_NORMAL
+#define TM_BLK   TM_BLK_NORMAL
+#endif
+
+#define UNITS_PER_SEC 10 // deciseconds (or tenths of seconds)
+
+#define MILLION 1000000
+
+#define dSECS_PER_UNIT (10/UNITS_PER_SEC)  		//deciseconds per unit
+#define mSECS_PER_UNIT (1000/UNITS_PER_SEC)		//milliseconds per unit
+#define uSECS_PER_UNIT (MILLION/UNITS_PER_SEC) 	//microseconds per unit
+
+typedef uint8_t blkT[BLK_SZ_CRC]; // blkT is the the type for a block
+
+enum {CONT, //Continue event
+	SER, 	//Event from serial port
+	TM, 	//Timeout event
+	KB_C	//Cancellation via Keyboard event
+};
+
+
+/* A file operation wanted by a core.  The host carries it out and returns what
+ *  the corresponding system call would, i.e. -1 with errno set on failure. */
+struct FileRequest {
+	enum Kind {
+		OPEN,	// open name for reading.  Gives a descriptor
+		CREATE,	// create (or truncate) name for writing, with mode.  Gives a descriptor
+		SIZE,	// gives the size of the file called name
+		READ,	// read up to n bytes from fileD into buf
+		WRITE,	// write n bytes from buf to fileD
+		CLOSE,	// close fileD
+		REOPEN,	// open name for writing, keeping what it holds.  Gives a descriptor
+		SEEK	// move fileD to offset n from its start.  Gives the offset
+	} kind;
+	const char* name{nullptr};
+	int fileD{-1};
+	void* buf{nullptr};
+	size_t n{0};
+	mode_t mode{0};
+};
+
+#define SNAPSHOT_CHART_SZ	64	// room in a SessionSnapshot for the statechart
+#define SNAPSHOT_PEER_SZ	384	// room for the state of the sender or receiver itself
+#define SNAPSHOT_RESULT_SZ	128	// room for the result so far
+
+/* The state of a transfer between events, from which another core of the same
+ *  kind can continue it: for instance, in a new process that has inherited the
+ *  medium's descriptor, after this one has died.  It is plain data, so it can
+ *  be kept anywhere (e.g. in a file or in memory shared with a standby) and
+ *  taking one costs about as much as copying it.  See PeerYCore::snapshot().
+ *  seq makes it a seqlock: a reader that may race with the core taking a
+ *  snapshot copies it out with read().
+ */
+struct SessionSnapshot {
+	static const uint32_t MAGIC{0x594d5331}; // "YMS1"
+
+	/* Copy the last snapshot completed into copy.  Return false if none has
+	 *  been, or if one was being taken (e.g. by a process that then died). */
+	bool read(SessionSnapshot& copy) const;
+
+	uint32_t seq; // odd while a snapshot is being taken, and bumped when it has been
+	uint32_t magic; // MAGIC once a snapshot has been taken
+	char peer; // '[' for a sender, '(' for a receiver
+	uint16_t chartSz;
+	uint8_t chart[SNAPSHOT_CHART_SZ]; // see SessionChart::snapshot()
+	char result[SNAPSHOT_RESULT_SZ];
+	unsigned errCnt;
+	bool KbCan;
+	bool fileOpen; // a file was being read or written (restorePeer() reopens it)
+	off_t fileOffset;
+	long long timeoutLeft; // microseconds from the snapshot to the timeout
+	long long holdTimeoutLeft;
+	uint8_t peerState[SNAPSHOT_PEER_SZ]; // see snapshotPeer()
+};
+
+class PeerYCore {
+public:
+	typedef std::function<ssize_t(const FileRequest&)> FileHandler;
+
+	// smLogN and smProfN are the names of the files in cfg.smDir for the statechart trace and profile
+	PeerYCore(char left, char right, const char *smLogN, const char *smProfN, const PeerYConfig& config)
+	;
+	virtual ~PeerYCore() = default;
+
+	void tm(int timeoutUnits);
+	void tmRed(int reductionUnits);
+	void tmPush(int timeoutUnits);
+	void tmPop();
+
+	//Send a byte to the remote peer across the medium
+	void
+	sendByte(uint8_t byte)
+	;
+
+	const PeerYConfig cfg; // run-time tunables, fixed for the life of the peer
+
+	std::string result;  // the result of the file transfer
+	unsigned errCnt{0};	 // counts the number of "errors" in a row
+    int transferringFileD{-1};  // descriptor (from the host) for file being read from or written to.
+
+	/* A variable that records the fact that a keyboard cancel event
+	 * has been received.
+	 */
+	bool KbCan{false};
+
+	/* The host interface.  Once a transfer has begun (see the subclasses), the host
+	 *  calls tick() with the time to start it, and again whenever it has called
+	 *  input(), inputClosed(), cancel() or mediumDrained(), and when deadline() comes.
+	 *  After each tick() the host sends output() to the medium and consoleOutput()
+	 *  to the console, erasing what it has sent.  While wantsDrain(), the host waits
+	 *  until everything sent has left the medium (or all but cfg.drainLowWater bytes),
+	 *  gives the core any input that has arrived meanwhile, and then calls mediumDrained().
+	 */
+	bool running() const { return sessionSM != nullptr || sessionTask.valid(); }
+	void setFileHandler(FileHandler handler) { fileHandler = std::move(handler); }
+	void input(const void* bytes, int n); // bytes have arrived from the medium
+	void inputClosed() { mediumClosed = true; } // no more bytes will arrive
+	void cancel() { kbPending = true; } // "&c" has been typed
+	void mediumDrained() { drainDone = true; }
+	void tick(long long nowUsecs); // make as much progress as possible.  Time never goes backwards.
+	std::string& output() { return mediumOut; }
+	std::string& consoleOutput() { return consoleOut; }
+	bool wantsDrain() const;
+	bool wantsInput() const { return running() && !mediumClosed; }
+	// are keyboard commands taken now?  Not while operations are pending, just as
+	//  they would not be read by a thread blocked in one of the helpers.
+	bool wantsConsole() const;
+	// when tick() is next needed, on the clock given to tick(), or -1 if not until
+	//  input, a cancel or a drain (or never, once the transfer has finished).
+	long long deadline() const;
+	// is the core part way through a block (operations pending or input not yet
+	//  delivered)?  A pinned core must not be moved to another thread.
+	bool pinned() const {
+		return !sessionOps.empty() || !sessionInput.empty() || (sessionWaiter && wait.kind != WAIT_EVENT);
+	}
+	/* The statechart of the transfer, or null (as with the coroutine form).  Take it
+	 *  on the host's thread, after the transfer has begun; other threads may then
+	 *  inject() events into it (see SessionChart).  They are delivered at the next
+	 *  tick(), so a host waiting until deadline() also waits for injectD() to be
+	 *  readable, and then clears it (SessionChart::clearInjectD()) before the tick(). */
+	std::shared_ptr<SessionChart> session() const { return sessionSM; }
+	int injectD() const { return sessionSM ? sessionSM->injectD() : -1; }
+	/* Save the transfer to snap, if it is quiet: run by a statechart, after a tick()
+	 *  whose output has been taken, with no operation pending and no input waiting.
+	 *  Return false (without touching snap) if it is not. */
+	bool snapshot(SessionSnapshot& snap) const;
+
+protected:
+	void 
+	//PeerYCore::
+	clearCan(const int canTimeout)
+	;
+
+	// begin a transfer run by mySM.  It starts at the next tick().
+	void
+	beginSession(std::shared_ptr<smartstate::StateMgr> mySM, bool reportInfoParam)
+	;
+
+	// the same, with the statechart on the StaticChart engine (or any other SessionChart)
+	void
+	beginSession(std::shared_ptr<SessionChart> chart, bool reportInfoParam)
+	;
+
+	// begin a transfer run by task, the coroutine form.  It starts at the next tick().
+	void
+	beginSession(PeerTask task, bool reportInfoParam)
+	;
+
+	/* The number of bytes that should have arrived after byte before byte is
+	 *  posted to the statechart, because handling byte may need them, or 0.
+	 *  timeUnits gets how long to wait for each of them (an inter-character
+	 *  timer, restarted whenever more arrive) and timeoutUnits how long to wait
+	 *  for them all.  nextEvent() waits for them in the same way. */
+	virtual int readAheadFor(uint8_t byte, int& timeUnits, int& timeoutUnits) { return 0; }
+
+	// medium output, and waiting, for the statechart actions.  Nothing waits;
+	//  later output, timer changes and events are held behind a pending wait.
+	void mediumWrite(const void* buf, int n);
+	void mediumSleep(int mSecs);
+	int takeInput(void* buf, int n); // take up to n bytes that have arrived (see readAheadFor())
+
+	enum SessionOpKind {
+		OP_WRITE,		// write bytes to the medium
+		OP_TM,			// tm(units)
+		OP_TM_RED,		// tmRed(units)
+		OP_TM_PUSH,		// tmPush(units)
+		OP_TM_POP,		// tmPop()
+		OP_SLEEP,		// wait for units milliseconds
+		OP_DRAIN,		// wait until the medium has been drained
+		OP_DUMP,		// discard any input that has arrived
+		OP_PURGE,		// discard input until the line idles
+		OP_CLEAR_CAN	// discard CAN characters as clearCan(units) does
+	};
+
+	// do a session operation, or queue it if it has to wait (or be held behind one that does)
+	void queueSessionOp(SessionOpKind kind, int units = 0, const void* buf = nullptr, int n = 0);
+
+	// called when a transfer has finished
+	virtual void sessionEnded() {}
+
+	/* Continue the transfer saved in snap instead of starting one, on the
+	 *  statechart that the subclass has just given to beginSession().  Files are
+	 *  reopened, with FileRequests, by restorePeer().  nowUsecs is the time on
+	 *  the clock that will be given to tick().  Return false if snap cannot be
+	 *  continued, as the subclass restore...() functions do. */
+	bool restoreSession(const SessionSnapshot& snap, long long nowUsecs);
+
+	// save to state, and restore from it, what the subclass needs to continue a transfer
+	virtual void snapshotPeer(uint8_t state[SNAPSHOT_PEER_SZ]) const {}
+	virtual bool restorePeer(const uint8_t state[SNAPSHOT_PEER_SZ], const SessionSnapshot& snap) { return false; }
+
+	// carry out a file request with the host's FileHandler
+	ssize_t fileRequest(const FileRequest& request);
+
+	// what nextEvent() gives instead of a byte from the medium
+	enum { EV_TM = -1, EV_KB_C = -2 };
+
+	enum WaitKind { WAIT_NONE, WAIT_READ, WAIT_DISCARD, WAIT_SLEEP, WAIT_DRAIN, WAIT_EVENT };
+
+	// an awaitable for one of the functions below.  A coroutine waits for one thing at a time.
+	struct SessionWait {
+		PeerYCore& peer;
+		bool await_ready() { return peer.waitReady(); }
+		void await_suspend(std::coroutine_handle<> h) { peer.sessionWaiter = h; }
+		int await_resume() { return peer.waitResult(); }
+	};
+
+	// wait until min bytes have arrived from the medium, or timeUnits have passed with
+	//  none arriving, or timeoutUnits have passed in all (as readcond() with time and
+	//  timeout), then take up to n of them.  Gives the number of bytes taken.
+	SessionWait readN(void* buf, int n, int min, int timeUnits, int timeoutUnits);
+	// discard input until at least minBytes have been discarded or timeUnits have passed,
+	//  as purge() does for the statecharts (OP_PURGE).  Gives the number of bytes discarded.
+	SessionWait discard(int timeUnits, int minBytes);
+	SessionWait sleepUntil(long long usecs); // usecs is on the clock given to tick()
+	SessionWait sleepFor(int mSecs);
+	SessionWait drained(); // wait until the medium has been drained (as myTcdrain())
+	// wait for the next byte from the medium (0 to 255), or a timeout (EV_TM, see tm()),
+	//  or "&c" from the console (EV_KB_C).
+	SessionWait nextEvent();
+
+	int discardInput(); // discard all input that has arrived.  Return the number of bytes.
+
+	PeerTask clearCanCo(const int canTimeout); // the coroutine form of clearCan()
+
+	char logLeft; // for this peer, symbol to use to start a phrase of logging information
+	char logRight; // symbol to use to end info phrase for this peer
+	const std::string smLogName; // path of optional statechart logging file
+	const std::string smProfileName; // path of optional statechart profile file, added to after each transfer
+
+	bool reportInfo{false}; // should debugging information be reported
+
+	off_t fileOffset{0}; // how far transferringFileD has been read or written
+
+private:
+	long long int absoluteTimeout{0};  // time in microseconds of timeout
+	long long int holdTimeout{0};		// hold original timeout during temporary timeout.
+	long long int now{0};				// the time last given to tick()
+
+	struct {
+		WaitKind kind{WAIT_NONE};
+		uint8_t* buf;
+		int n, min, units;
+		long long deadline;
+		long long limit;	// for WAIT_READ, the deadline for the whole wait
+		int count;
+	} wait;
+	bool waitReady(); // has the current wait finished?
+	int waitResult(); // finish the current wait
+
+	struct SessionOp {
+		SessionOpKind kind;
+		int units;
+		std::string bytes;		// for OP_WRITE
+		long long deadline{0};	// 0 until the operation starts
+		int count{0};			// bytes consumed so far
+	};
+
+	// hold output, timer changes and events behind queued operations?
+	bool deferring() const { return sessionSM && !sessionOps.empty(); }
+	void setTimer(SessionOpKind kind, int units); // do a timer operation immediately
+	bool runSessionOp(); // progress head operation.  Return true when done.
+	void endSession();
+
+	std::shared_ptr<SessionChart> sessionSM; // non-null while the statechart runs the transfer
+	bool started{false}; // has the statechart or coroutine been started?
+	std::deque<SessionOp> sessionOps; // operations that must finish before anything else happens
+	std::deque<uint8_t> sessionInput; // bytes from the medium not yet consumed
+	long long readAheadDeadline{0}; // when to stop waiting for read-ahead bytes, or 0
+	long long readAheadCharDeadline{0}; // when to stop if no more of them arrive
+	size_t readAheadHave{0}; // the bytes there when the character timer was last restarted
+	bool readingAhead(); // should the byte at the front of sessionInput wait for more?
+	bool mediumClosed{false};
+	bool drainDone{false}; // the host has called mediumDrained()
+	PeerTask sessionTask; // valid while a coroutine runs the transfer
+	std::coroutine_handle<> sessionWaiter; // the coroutine waiting for wait to finish
+	bool kbPending{false}; // "&c" has been typed but not yet given to the statechart or coroutine
+
+	std::string mediumOut; // for the host to send to the medium
+	std::string consoleOut; // for the host to send to the console
+	FileHandler fileHandler;
+};
+
+#endif /* PEERYCORE_H_ */
@@ -0,0 +1,495 @@
+/* CircBuf - A fast, [limited] thread-safe, lockless circular buffer. */
+/* read()/write() interface adjusted by Craig Scratchley to be similar
+ * to the posix read() and write() functions in order to increase efficiency.
+ * Switched from volatile to atomic variables.
+ * Craig Scratchley -- 2011 - 2024 */
+ 
+#ifndef RAGE_UTIL_CIRCULAR_BUFFER
+#define RAGE_UTIL_CIRCULAR_BUFFER
+
+#include <cstring> // for memcpy
+#include <atomic>
+#include <algorithm> // for min
+
+/* Lock-free circular buffer.  This should be threadsafe if one thread is reading
+ * and another is writing. [Multiple simultaneous readers or writers is not threadsafe.] */
+template<class T>
+class CircBuf
+{
+	T *buf;
+	/* read_pos is the position data is read from; write_pos is the position
+	 * data is written to.  If read_pos == write_pos, the buffer is empty.
+	 *
+	 * There will always be at least one position empty, as a completely full
+	 * buffer (read_pos == write_pos) is indistinguishable from an empty buffer.
+	 *
+	 * Invariants: read_pos < size, write_pos < size. */
+	unsigned size;
+	unsigned m_iBlockSize;
+
+	// Craig says:  making the variables volatile won't make this code safe for a simultaneous reader and writer.
+	// /* These are volatile to prevent reads and writes to them from being optimized. */
+	// // volatile unsigned read_pos, write_pos;
+	std::atomic<unsigned> read_pos, write_pos;  // substituted by Craig Scratchley
+
+public:
+	CircBuf()
+	{
+		buf = nullptr;
+		clear();
+	}
+
+	~CircBuf()
+	{
+		delete[] buf;
+	}
+
+// atomics cause a problem for swap() and copy assignment
+//	void swap( CircBuf &rhs )
+//	{
+//		std::swap( size, rhs.size );
+//		std::swap( m_iBlockSize, rhs.m_iBlockSize );
+//      // a correct compiler will not swap atomics
+//		std::swap( read_pos, rhs.read_pos );
+//		std::swap( write_pos, rhs.write_pos );
+//		std::swap( buf, rhs.buf );
+//	}
+//
+//	CircBuf &operator=( const CircBuf &rhs )
+//	{
+//		CircBuf c( rhs );
+//		this->swap( c );
+//		return *this;
+//	}
+
+	CircBuf( const CircBuf &cpy )
+	{
+		size = cpy.size;
+		read_pos = cpy.read_pos;
+		write_pos = cpy.write_pos;
+		m_iBlockSize = cpy.m_iBlockSize;
+		if( size )
+		{
+			buf = new T[size];
+			std::memcpy( buf, cpy.buf, size*sizeof(T) );
+		}
+		else
+		{
+			buf = nullptr;
+		}
+	}
+
+	/* Return the number of elements available to read. */
+	unsigned num_readable() const
+	{
+		const int rpos = read_pos;
+		const int wpos = write_pos;
+		if( rpos < wpos )
+			/* The buffer looks like "eeeeDDDDeeee" (e = empty, D = data). */
+			return wpos - rpos;
+		else if( rpos > wpos )
+			/* The buffer looks like "DDeeeeeeeeDD" (e = empty, D = data). */
+			return size - (rpos - wpos);
+		else // if( rpos == wpos )
+			/* The buffer looks like "eeeeeeeeeeee" (e = empty, D = data). */
+			return 0;
+	}
+
+	/* Return the number of writable elements. */
+	unsigned num_writable() const
+	{
+		const int rpos = read_pos;
+		const int wpos = write_pos;
+
+		int ret;
+		if( rpos < wpos )
+			/* The buffer looks like "eeeeDDDDeeee" (e = empty, D = data). */
+			ret = size - (wpos - rpos);
+		else if( rpos > wpos )
+			/* The buffer looks like "DDeeeeeeeeDD" (e = empty, D = data). */
+			ret = rpos - wpos;
+		else // if( rpos == wpos )
+			/* The buffer looks like "eeeeeeeeeeee" (e = empty, D = data). */
+			ret = size;
+
+		/* Subtract the blocksize, to account for the element that we never fill
+		 * while keeping the entries aligned to m_iBlockSize. */
+		return ret - m_iBlockSize;
+	}
+
+	unsigned capacity() const { return size - 1; }
+
+	void reserve( unsigned n, int iBlockSize = 1 )
+	{
+		m_iBlockSize = iBlockSize;
+
+		clear();
+		delete[] buf;
+		buf = nullptr;
+
+		/* Reserve an extra element.  We'll never fill more than n elements; the extra
+		 * element is to guarantee that read_pos != write_pos when the buffer is full,
+		 * since that would be ambiguous with an empty buffer. */
+		if( n != 0 )
+		{
+			size = n+1;
+			size = ((size + iBlockSize - 1) / iBlockSize) * iBlockSize; // round up
+
+			buf = new T[size];
+		}
+		else
+			size = 0;
+	}
+
+	void clear()
+	{
+		read_pos = write_pos = 0;
+	}
+
+	/* Indicate that n elements have been written. */
+	void advance_write_pointer( int n )
+	{
+		write_pos = (write_pos + n) % size;
+	}
+
+	/* Indicate that n elements have been read. */
+	void advance_read_pointer( int n )
+	{
+		read_pos = (read_pos + n) % size;
+	}
+
+	void get_write_pointers( T *pPointers[2], unsigned pSizes[2] )
+	{
+		const int rpos = read_pos;
+		const int wpos = write_pos;
+
+		if( rpos <= wpos )
+		{
+			/* The buffer looks like "eeeeDDDDeeee" or "eeeeeeeeeeee" (e = empty, D = data). */
+			pPointers[0] = buf+wpos;
+			pPointers[1] = buf;
+
+			pSizes[0] = size - wpos;
+			pSizes[1] = rpos;
+		}
+		else if( rpos > wpos )
+		{
+			/* The buffer looks like "DDeeeeeeeeDD" (e = empty, D = data). */
+			pPointers[0] = buf+wpos;
+			pPointers[1] = nullptr;
+
+			pSizes[0] = rpos - wpos;
+			pSizes[1] = 0;
+		}
+
+		/* Subtract the blocksize, to account for the element that we never fill
+		 * while keeping the entries aligned to m_iBlockSize. */
+		if( pSizes[1] )
+			pSizes[1] -= m_iBlockSize;
+		else
+			pSizes[0] -= m_iBlockSize;
+	}
+
+	/* Like get_write_pointers, but only return the first range available. */
+	T *get_write_pointer( unsigned *pSizes )
+	{
+		T *pBothPointers[2];
+		unsigned iBothSizes[2];
+		get_write_pointers( pBothPointers, iBothSizes );
+		*pSizes = iBothSizes[0];
+		return pBothPointers[0];
+	}
+
+	void get_read_pointers( T *pPointers[2], unsigned pSizes[2] )
+	{
+		const int rpos = read_pos;
+		const int wpos = write_pos;
+
+		if( rpos <= wpos )
+		{
+			/* The buffer looks like "eeeeDDDDeeee" (e = empty, D = data). */
+            /*    or   */
+            /* The buffer looks like "eeeeeeeeeeee" (e = empty, D = data). */
+			pPointers[0] = buf+rpos;
+			pPointers[1] = nullptr;
+
+			pSizes[0] = wpos - rpos;
+			pSizes[1] = 0;
+		}
+		else
+		{
+			/* The buffer looks like "DDeeeeeeeeDD" (e = empty, D = data). */
+			pPointers[0] = buf+rpos;
+			pPointers[1] = buf;
+
+			pSizes[0] = size - rpos;
+			pSizes[1] = wpos;
+		}
+	}
+
+	/* Write buffer_size elements from buffer into the circular buffer object,
+	 * and advance the write pointer.  Return the number of elements that were
+	 * able to be written.  If
+	 * the data will not fit entirely, as much data as possible will be fit
+	 * in. */
+	unsigned write( const T *buffer, unsigned buffer_size )
+	{
+		using std::min;
+		using std::max;
+		T *p[2];
+		unsigned sizes[2];
+		get_write_pointers( p, sizes );
+
+		unsigned max_write_size = sizes[0] + sizes[1];
+		if( buffer_size > max_write_size )
+			buffer_size = max_write_size;
+
+		const int from_first = min( buffer_size, sizes[0] );
+		std::memcpy( p[0], buffer, from_first*sizeof(T) );
+		if( buffer_size > sizes[0] )
+			std::memcpy( p[1], buffer+from_first, max(buffer_size-sizes[0], 0u)*sizeof(T) );
+
+		advance_write_pointer( buffer_size );
+
+		return buffer_size;
+	}
+
+	/* Read buffer_size elements into buffer from the circular buffer object,
+	 * and advance the read pointer.  Return the number of elements that were
+	 * read.  If buffer_size elements cannot be read, as many elements as
+	 * possible will be read */
+	unsigned read( T *buffer, unsigned buffer_size )
+	{
+		using std::max;
+		using std::min;
+		T *p[2];
+		unsigned sizes[2];
+		get_read_pointers( p, sizes );
+
+		unsigned max_read_size = sizes[0] + sizes[1];
+		if( buffer_size > max_read_size )
+			buffer_size = max_read_size;
+
+		const int from_first = min( buffer_size, sizes[0] );
+		std::memcpy( buffer, p[0], from_first*sizeof(T) );
+		if( buffer_size > sizes[0] )
+			std::memcpy( buffer+from_first, p[1], max(buffer_size-sizes[0], 0u)*sizeof(T) );
+
+		/* Set the data that we just read to 0xFF.  Thisa8 way, if we're passing pointers
+		 * through, we can tell if we accidentally get a stale pointer. */
+		std::memset( p[0], 0xFF, from_first*sizeof(T) );
+		if( buffer_size > sizes[0] )
+			std::memset( p[1], 0xFF, max(buffer_size-sizes[0], 0u)*sizeof(T) );
+
+		advance_read_pointer( buffer_size );
+		return buffer_size;
+	}
+};
+
+/* SpscRing - a variant of CircBuf for exactly one reading thread and one writing
+ * thread, added by the ENSC 351 team.  The interface is that of CircBuf, but:
+ *
+ * The size is a power of two, so positions are masked rather than taken modulo
+ * the size.  The positions count up freely (wrapping with unsigned arithmetic),
+ * so a full buffer is write_pos - read_pos == size and every element can be used.
+ *
+ * Each position is on its own cache line, together with the other thread's
+ * position as last seen.  A thread only loads the other position (and so only
+ * touches the other thread's cache line) when the last one seen does not give it
+ * enough data or room.  Positions are published with release and loaded with
+ * acquire ordering, which is all that is needed to hand over the elements.
+ *
+ * get_read_pointers()/advance_read_pointer() let a reader look at the data in
+ * place and then consume it, and get_write_pointers()/advance_write_pointer() let a
+ * writer fill the buffer in place, without copying through another buffer. */
+template<class T>
+class SpscRing
+{
+	static const unsigned CACHE_LINE = 64;
+
+	T *buf;
+	unsigned size;
+	unsigned mask; // size - 1
+
+	struct alignas(CACHE_LINE) Writer {
+		std::atomic<unsigned> pos;	// changed only by the writer
+		unsigned read_pos_seen;		// the reader's position, as the writer last saw it
+	} w;
+
+	struct alignas(CACHE_LINE) Reader {
+		std::atomic<unsigned> pos;	// changed only by the reader
+		unsigned write_pos_seen;	// the writer's position, as the reader last saw it
+	} r;
+
+public:
+	SpscRing()
+	{
+		buf = nullptr;
+		size = mask = 0;
+		clear();
+	}
+
+	~SpscRing()
+	{
+		delete[] buf;
+	}
+
+	SpscRing( const SpscRing & ) = delete;
+	SpscRing &operator=( const SpscRing & ) = delete;
+
+	/* Allocate room for at least n elements, rounded up to a power of two, and
+	 * empty the buffer.  Not to be called while another thread is using it. */
+	void reserve( unsigned n )
+	{
+		clear();
+		delete[] buf;
+		buf = nullptr;
+		size = mask = 0;
+		if( n != 0 )
+		{
+			size = 1;
+			while( size < n )
+				size <<= 1;
+			mask = size - 1;
+			buf = new T[size];
+		}
+	}
+
+	/* Not to be called while another thread is using the buffer. */
+	void clear()
+	{
+		w.pos.store( 0, std::memory_order_relaxed );
+		w.read_pos_seen = 0;
+		r.pos.store( 0, std::memory_order_relaxed );
+		r.write_pos_seen = 0;
+	}
+
+	unsigned capacity() const { return size; }
+
+	/* Return the number of elements available to read.  Exact for the reader. */
+	unsigned num_readable() const
+	{
+		return w.pos.load( std::memory_order_acquire ) - r.pos.load( std::memory_order_relaxed );
+	}
+
+	/* Return the number of writable elements.  Exact for the writer. */
+	unsigned num_writable() const
+	{
+		return size - (w.pos.load( std::memory_order_relaxed ) - r.pos.load( std::memory_order_acquire ));
+	}
+
+	/* Writer only.  Return the room in up to two ranges.  The reader's position is
+	 * only loaded if the last one seen gives fewer than wanted elements. */
+	void get_write_pointers( T *pPointers[2], unsigned pSizes[2], unsigned wanted = 1 )
+	{
+		const unsigned wpos = w.pos.load( std::memory_order_relaxed );
+		unsigned room = size - (wpos - w.read_pos_seen);
+		if( room < wanted )
+		{
+			w.read_pos_seen = r.pos.load( std::memory_order_acquire );
+			room = size - (wpos - w.read_pos_seen);
+		}
+		split( wpos, room, pPointers, pSizes );
+	}
+
+	/* Writer only.  Make n elements, filled in from get_write_pointers(), readable. */
+	void advance_write_pointer( unsigned n )
+	{
+		w.pos.store( w.pos.load( std::memory_order_relaxed ) + n, std::memory_order_release );
+	}
+
+	/* Reader only.  Return the data in up to two ranges.  The writer's position is
+	 * only loaded if the last one seen gives fewer than wanted elements. */
+	void get_read_pointers( T *pPointers[2], unsigned pSizes[2], unsigned wanted = 1 )
+	{
+		const unsigned rpos = r.pos.load( std::memory_order_relaxed );
+		unsigned data = r.write_pos_seen - rpos;
+		if( data < wanted )
+		{
+			r.write_pos_seen = w.pos.load( std::memory_order_acquire );
+			data = r.write_pos_seen - rpos;
+		}
+		split( rpos, data, pPointers, pSizes );
+	}
+
+	/* Reader only.  Give back n elements, from get_read_pointers(), to the writer. */
+	void advance_read_pointer( unsigned n )
+	{
+		r.pos.store( r.pos.load( std::memory_order_relaxed ) + n, std::memory_order_release );
+	}
+
+	/* Writer only.  As CircBuf::write(). */
+	unsigned write( const T *buffer, unsigned buffer_size )
+	{
+		T *p[2];
+		unsigned sizes[2];
+		get_write_pointers( p, sizes, buffer_size );
+
+		if( buffer_size > sizes[0] + sizes[1] )
+			buffer_size = sizes[0] + sizes[1];
+		const unsigned from_first = std::min( buffer_size, sizes[0] );
+		std::memcpy( p[0], buffer, from_first*sizeof(T) );
+		if( buffer_size > from_first )
+			std::memcpy( p[1], buffer+from_first, (buffer_size-from_first)*sizeof(T) );
+
+		advance_write_pointer( buffer_size );
+		return buffer_size;
+	}
+
+	/* Reader only.  As CircBuf::read(), but the data read is not overwritten. */
+	unsigned read( T *buffer, unsigned buffer_size )
+	{
+		T *p[2];
+		unsigned sizes[2];
+		get_read_pointers( p, sizes, buffer_size );
+
+		if( buffer_size > sizes[0] + sizes[1] )
+			buffer_size = sizes[0] + sizes[1];
+		const unsigned from_first = std::min( buffer_size, sizes[0] );
+		std::memcpy( buffer, p[0], from_first*sizeof(T) );
+		if( buffer_size > from_first )
+			std::memcpy( buffer+from_first, p[1], (buffer_size-from_first)*sizeof(T) );
+
+		advance_read_pointer( buffer_size );
+		return buffer_size;
+	}
+
+private:
+	/* The n elements from position pos, which may wrap around the end of buf. */
+	void split( unsigned pos, unsigned n, T *pPointers[2], unsigned pSizes[2] ) const
+	{
+		const unsigned index = pos & mask;
+		pPointers[0] = buf+index;
+		pSizes[0] = std::min( n, size - index );
+		pSizes[1] = n - pSizes[0];
+		pPointers[1] = pSizes[1] ? buf : nullptr;
+	}
+};
+
+#endif
+
+/*
+ * Copyright (c) 2004 Glenn Maynard
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
@@ -0,0 +1,120 @@
+//============================================================================
+// File Name   : Reactor.cpp
+// Description : Run many YMODEM sessions on one thread.
+//============================================================================
+
+#include "Reactor.h"
+
+#include <poll.h>
+#include <errno.h>
+#include <time.h>
+#include <stdint.h>
+#include <unistd.h>
+
+using namespace std;
+
+void
+Reactor::
+add(shared_ptr<PeerY> peer, DoneFn onDone)
+{
+	sessions.push_back({move(peer), move(onDone)});
+}
+
+void
+Reactor::
+reap()
+{
+	// a callback may add sessions, so don't hold an iterator across it
+	for (size_t i{0}; i < sessions.size(); ) {
+		if (sessions[i].peer->sessionRunning())
+			++i;
+		else {
+			Session done{move(sessions[i])};
+			sessions.erase(sessions.begin() + i);
+			if (done.onDone)
+				done.onDone(*done.peer);
+		}
+	}
+}
+
+shared_ptr<PeerY>
+Reactor::
+removeUnpinned(DoneFn& onDone)
+{
+	// take from the back, the most recently added
+	for (size_t i{sessions.size()}; i-- > 0; ) {
+		auto& peer{*sessions[i].peer};
+		if (peer.sessionRunning() && !peer.sessionPinned()) {
+			auto result{move(sessions[i].peer)};
+			onDone = move(sessions[i].onDone);
+			sessions.erase(sessions.begin() + i);
+			return result;
+		}
+	}
+	return nullptr;
+}
+
+int
+Reactor::
+runOnce(long long maxUsecs)
+{
+	reap();
+	if (sessions.empty() && wakeD < 0)
+		return 0;
+
+	// four slots per session: medium, console, drain and injected events, then wakeD.
+	//  A descriptor of -1 is ignored by ppoll().
+	vector<struct pollfd> fds(SLOTS * sessions.size() + 1);
+	fds.back() = {wakeD, POLLIN, 0};
+	long long usecs{maxUsecs};
+	for (size_t i{0}; i < sessions.size(); ++i) {
+		auto& peer{*sessions[i].peer};
+		fds[SLOTS*i] = {peer.sessionMediumD(), POLLIN, 0};
+		fds[SLOTS*i + 1] = {peer.sessionConsoleD(), POLLIN, 0};
+		fds[SLOTS*i + 2] = {peer.sessionDrainD(), POLLIN, 0};
+		fds[SLOTS*i + 3] = {peer.sessionInjectD(), POLLIN, 0};
+		long long left{peer.sessionUsecsLeft()};
+		if (left >= 0 && (usecs < 0 || left < usecs))
+			usecs = left;
+	}
+
+	struct timespec ts;
+	if (usecs >= 0) {
+		ts.tv_sec = usecs / MILLION;
+		ts.tv_nsec = (usecs % MILLION) * 1000;
+	}
+	int ready{ppoll(fds.data(), fds.size(), (usecs >= 0) ? &ts : nullptr, nullptr)};
+	if (-1 == ready)
+		return (EINTR == errno) ? 0 : -1;
+
+	if (fds.back().revents & POLLIN) {
+		uint64_t counter;
+		if (-1 == read(wakeD, &counter, sizeof(counter)) && EAGAIN != errno)
+			return -1;
+	}
+
+	// sessions added by callbacks below have no slot yet
+	size_t count{fds.size() / SLOTS};
+	for (size_t i{0}; i < count; ++i) {
+		auto peer{sessions[i].peer};
+		if (fds[SLOTS*i].revents)
+			peer->sessionMediumReady();
+		if (fds[SLOTS*i + 1].revents & POLLIN)
+			peer->sessionConsoleReady();
+		if (fds[SLOTS*i + 3].revents & POLLIN)
+			peer->sessionInjectReady();
+		peer->sessionPump(); // timeouts, and the end of a drain
+	}
+	reap();
+	return 0;
+}
+
+int
+Reactor::
+run()
+{
+	while (!sessions.empty())
+		if (-1 == runOnce())
+			return -1;
+	return 0;
+}
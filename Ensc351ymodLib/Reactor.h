@@ -0,0 +1,56 @@
+/*
+ * Reactor.h
+ *
+ * A single-threaded event loop that runs many YMODEM sender and receiver
+ *  sessions at once.  Each peer is started in session mode (for example
+ *  with SenderY::beginSendFiles() or ReceiverY::beginReceiveFiles()) and
+ *  then added.  run() waits on all of their descriptors and timeouts
+ *  with a single ppoll() and hands each ready session to the peer.
+ */
+
+#ifndef REACTOR_H_
+#define REACTOR_H_
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "PeerY.h"
+
+class Reactor {
+public:
+	typedef std::function<void(PeerY&)> DoneFn;
+
+	// add a peer whose session has begun.  onDone (if any) is called when the
+	//  session finishes, and may add more sessions.
+	void add(std::shared_ptr<PeerY> peer, DoneFn onDone = nullptr);
+
+	size_t size() const { return sessions.size(); }
+
+	// also wait on descriptor d (e.g. an eventfd).  When d is readable,
+	//  a counter is read from it and runOnce() returns.
+	void setWakeD(int d) { wakeD = d; }
+
+	// remove a session that is not pinned (see PeerY::sessionPinned()) so that
+	//  it can be added to another Reactor.  Return nullptr if there is none.
+	std::shared_ptr<PeerY> removeUnpinned(DoneFn& onDone);
+
+	// wait (at most maxUsecs if not negative) until some session can make
+	//  progress, and let it.  Return -1 if ppoll() fails, else 0.
+	int runOnce(long long maxUsecs = -1);
+
+	// run until all sessions have finished.  Return -1 if ppoll() fails, else 0.
+	int run();
+
+private:
+	struct Session {
+		std::shared_ptr<PeerY> peer;
+		DoneFn onDone;
+	};
+	std::vector<Session> sessions;
+	static const size_t SLOTS{4}; // pollfds per session
+	int wakeD{-1};
+	void reap(); // remove finished sessions
+};
+
+#endif /* REACTOR_H_ */
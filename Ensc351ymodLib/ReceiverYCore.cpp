@@ -0,0 +1,353 @@
+//============================================================================
+// File Name   : ReceiverYCore.cpp
+// Description : The YMODEM receiver, with no I/O of its own (see PeerYCore.h)
+// Original portions Copyright (c) 2024 Craig Scratchley  (wcs AT sfu DOT ca)
+//============================================================================
+
+#include "ReceiverYCore.h"
+
+#include <string.h> // for memset(), memcpy()
+#include <fcntl.h>
+#include <stdint.h>
+//#include <sys/dcmd_chr.h> // for DCMD_CHR_GETOBAND
+#include <memory> // for pointer to SS class
+#include "Linemax.h"
+#include <sstream>
+
+#include "yReceiverSS.h"
+#include "VNPE.h"
+#include "AtomicCOUT.h"
+
+using namespace std;
+using namespace yReceiver_SS;
+
+ReceiverYCore::
+ReceiverYCore(const PeerYConfig& config)
+:PeerYCore('(', ')', "ReceiverSS.log", "ReceiverSS.prof", config),
+ //closeProb(1),
+ //NCGbyte('C'),
+ goodBlk(false), 
+ goodBlk1st(false), 
+ syncLoss(false), // transfer will end if syncLoss becomes true
+ bytesRemaining(0),
+ numLastGoodBlk(255)
+{
+}
+
+/* Only called after an SOH character has been received and
+posted to the Receiver_SS statechart. The function tries
+to receive the remaining characters to form a complete
+block.  The member
+variable goodBlk1st will be made true if this is the first
+time that the block was received in "good" condition.
+ The function will set or reset a Boolean variable,
+goodBlk. This variable will be made false if either
+	� the needed number of bytes have not yet been received and another
+	byte does not arrive within the character timeout since the last byte
+	(or within the character timeout of the function being called).
+	� the needed number of bytes (or more) are received and the block
+	created using the needed number of bytes has something
+	wrong with it, like the checksum being incorrect.
+	� more than the needed number of bytes are received.
+The function will also set or reset another Boolean variable,
+syncLoss. syncLoss will only be set to true when there is a
+fatal loss of syncronization as described in the XMODEM
+specification. If goodBlk has not already been made false
+and if syncLoss is false, then goodBlk will be set to true.  The
+first time each block is received and is good, goodBlk1st will be
+set to true.  This is an indication of when a block should be
+written to disk.  If goodBlk is false and at
+least the needed number of bytes were received in the function,
+then a purge() function should be called before returning from
+getRestBlk(). The purge() subroutine will read and discard
+characters until nothing is received over a character timeout period.
+*/
+
+void ReceiverYCore::getRestBlk()
+{
+    // here, we can take about 30 more characters than we hope to get,
+    //         so any extra characters that happen to have come from
+    //         the serial port are taken too.  The SOH was not posted until
+    //         REST_BLK_SZ_CRC characters had arrived, or a character time had
+    //         passed with none arriving, or TM_BLK in all (see readAheadFor()).
+    int bytesRead{takeInput(rcvBlk+1, BUF_SZ - 1)};
+    if (checkRestBlk(bytesRead))
+        purge();  // discard chars until line idles for the character timeout period.
+}
+
+/* Check the rest of a block, of which bytesRead bytes have been read by getRestBlk(),
+ *  and set goodBlk, goodBlk1st and syncLoss.  Return true if the caller should purge().
+ */
+bool ReceiverYCore::checkRestBlk(int bytesRead)
+{
+	const int restBlkSz = REST_BLK_SZ_CRC;
+    	// consider receiving CRC after calculating local CRC
+    if(bytesRead < restBlkSz) {
+    	if (reportInfo)
+    		// "Sh"ort block
+    		COUT << "(Sh" << bytesRead << ")" << flush;
+    	goodBlk = goodBlk1st = false; // short block
+    	// return;
+    }
+    else { // not needed if we put return in above.
+    	const char* badReason;
+   	 	if( bytesRead > restBlkSz) { // got an extra byte or two -- maybe there are more
+			goodBlk = false; //things are fishy -- let's not take chances
+			badReason = "be"; // "bad -- extra (bytes)"
+		}
+		else if (rcvBlk[2] != (uint8_t) ~rcvBlk[1]) {
+			//  block # and its complement are not matched
+			goodBlk = false;
+			badReason = "bm"; // "bad -- (complement not) matched"
+		}
+		else {
+			goodBlk1st = (rcvBlk[1] == (uint8_t) (numLastGoodBlk + 1)); // but might be made false below
+			if (!goodBlk1st) {
+				// determine fatal loss of synchronization
+            if (transferringFileD == -1 || (rcvBlk[1] != numLastGoodBlk)) {
+					syncLoss = true;
+					goodBlk = false;
+					if (reportInfo)
+						// "s"ynchronization has been lost
+						COUT << "(s" << (unsigned) rcvBlk[1] << ":" << (unsigned) numLastGoodBlk << ")" << flush;
+					return true;
+				}
+				else if (cfg.allowDeemedGood) { // (rcvBlk[1] == numLastGoodBlk)
+					goodBlk = true; // "deemed" good block
+					if (reportInfo)
+						// "d"eemed good block
+						COUT << "(d" << (unsigned) rcvBlk[1] << ")" << flush;
+					// purge(); // ??
+					return false;
+				}
+			}
+			badReason = "bd"; // "bad data (in chunk)"
+			// detect if data error in chunk
+			// consider receiving checksum/CRC after calculating local checksum/CRC
+			uint16_t CRCbytes;
+			crc16ns(&CRCbytes, &rcvBlk[DATA_POS]);
+			goodBlk = (*((uint16_t*) &rcvBlk[PAST_CHUNK]) == CRCbytes);
+		}
+		if (!goodBlk) {
+			goodBlk1st = false; // but the block was "bad".
+			if (reportInfo)
+				COUT << "(" << badReason << (unsigned) rcvBlk[1] << ")" << flush;
+			return true;  // discard chars until line idles for the character timeout period.
+		}
+		else if (!goodBlk1st) { // not reached if cfg.allowDeemedGood
+			if (reportInfo)
+				// "r"esent good block
+				COUT << "(r" << (unsigned) rcvBlk[1] << ")" << flush; // "resent" good block
+			return false;
+		}
+		// good block for the "first" time.
+		numLastGoodBlk = rcvBlk[1];
+		if (reportInfo)
+			// good block for the "f"irst time.
+			COUT << "(f" << (unsigned) rcvBlk[1] << ")" << endl;
+	}
+	return false;
+}
+
+//Write chunk (file data) in a received block to disk.  Update the number of bytes remaining to be written.
+void ReceiverYCore::writeChunk()
+{
+   if (bytesRemaining <= 0)
+      return; /// No data left to write, avoid unnecessary operations
+   bytesRemaining -= CHUNK_SZ;
+   /// calculates writeSize in such a way that only the valid data is written
+   ssize_t writeSize{(bytesRemaining < 0) ? (CHUNK_SZ + bytesRemaining) : CHUNK_SZ};
+   /// called with writeSize to write only the valid data from the block.
+   /// Write only valid data to disk
+   if (writeSize > 0) {
+      PE_NOT(fileRequest({.kind = FileRequest::WRITE, .fileD = transferringFileD,
+                          .buf = &rcvBlk[DATA_POS], .n = (size_t) writeSize}), writeSize);
+      fileOffset += writeSize;
+   }
+}
+
+// Open the output file to hold the file being transferred.
+// Initialize the number of bytes remaining to be written with the file size.
+// Fail, as if the file could not be created, if its name does not fit in fileName.
+int
+ReceiverYCore::
+openFileForTransfer()
+{
+    if (reportInfo)
+        COUT << "(opening: " << &rcvBlk[DATA_POS] << ")" << flush;
+    const mode_t mode{S_IRUSR | S_IWUSR}; //  | S_IRGRP | S_IROTH};
+    const char* fileNameP{(const char *) &rcvBlk[DATA_POS]};
+    const size_t nameLen{strlen(fileNameP)};
+    if (nameLen >= sizeof(fileName)) {
+        // too long to keep for restoring, so fail the transfer as for any other create error
+        errno = ENAMETOOLONG;
+        return transferringFileD = -1;
+    }
+    transferringFileD = fileRequest({.kind = FileRequest::CREATE, .name = fileNameP, .mode = mode});
+    fileOffset = 0;
+    memcpy(fileName, fileNameP, nameLen);
+    fileName[nameLen] = 0;
+    bytesRemaining = stoi(string((const char *) &rcvBlk[DATA_POS + nameLen + 1]));
+//    istringstream((const char *) &rcvBlk[DATA_POS + strlen(fileNameP) + 1]) >> bytesRemaining;
+//    sscanf((const char *) &rcvBlk[DATA_POS + strlen(fileNameP) + 1], "%ld", &bytesRemaining);
+    return transferringFileD;
+}
+
+/* If not already closed, close file that was just received (or being received).
+ * Set transferringFileD to -1 and numLastGoodBlk to 255 when file is closed.  Thus numLastGoodBlk
+ * is ready for the next file to be sent.
+ * Return the errno if there was an error closing the file and otherwise return 0.
+ */
+int
+ReceiverYCore::
+closeTransferredFile()
+{
+    if (transferringFileD > -1) {
+        closeProb = fileRequest({.kind = FileRequest::CLOSE, .fileD = transferringFileD});
+        if (closeProb)
+            return errno;
+        else {
+            numLastGoodBlk = 255;
+            transferringFileD = -1;
+        }
+    }
+    return 0;
+}
+
+/*
+Read and discard contiguous CAN characters. 
+*/
+void ReceiverYCore::clearCan()
+{
+	PeerYCore::clearCan(cfg.tm2Char);
+}
+
+//Send cfg.canLen CAN characters in a row to the YMODEM sender, to inform it of
+//	the cancelling of a file transfer
+void ReceiverYCore::cans()
+{
+	// no need to space in time CAN chars coming from receiver
+    const string buffer(cfg.canLen, CAN);
+    mediumWrite(buffer.data(), cfg.canLen);
+}
+
+//The purge() subroutine will read and discard characters until at least
+//10 have been discarded or 5 units (half a second normally) have gone by.
+void ReceiverYCore::purge()
+{
+   queueSessionOp(OP_PURGE);
+}
+
+// anotherFile will be zero (0) if there are no more files to be received.
+uint8_t
+ReceiverYCore::
+checkForAnotherFile()
+{
+    return (anotherFile = rcvBlk[DATA_POS]);
+}
+
+// Begin the YMODEM protocol to receive files.  It starts at the next tick().
+void ReceiverYCore::beginReceiveFiles()
+{
+	if (cfg.staticChart)
+		beginSession(receiveFilesChart(), cfg.receiverReportInfo);
+	else if (chartSS)
+		beginSession(chartSS, cfg.receiverReportInfo);
+	else
+		beginSession(make_shared<yReceiverSS>(this, false), cfg.receiverReportInfo);
+}
+
+bool ReceiverYCore::restoreReceiveFiles(const SessionSnapshot& snap, long long nowUsecs)
+{
+	beginReceiveFiles();
+	return restoreSession(snap, nowUsecs);
+}
+
+namespace {
+// what a receiver saves in SessionSnapshot::peerState
+struct ReceiverState {
+	uint8_t rcvBlk[BUF_SZ];
+	char fileName[CHUNK_SZ];
+	off_t bytesRemaining;
+	int closeProb;
+	uint8_t numLastGoodBlk;
+	uint8_t anotherFile;
+	uint8_t NCGbyte;
+	bool goodBlk;
+	bool goodBlk1st;
+	bool syncLoss;
+};
+static_assert(sizeof(ReceiverState) <= SNAPSHOT_PEER_SZ, "SNAPSHOT_PEER_SZ is too small");
+}
+
+void ReceiverYCore::snapshotPeer(uint8_t state[SNAPSHOT_PEER_SZ]) const
+{
+	ReceiverState& saved{*(ReceiverState*) state};
+	memcpy(saved.rcvBlk, rcvBlk, sizeof(rcvBlk));
+	memcpy(saved.fileName, fileName, sizeof(fileName));
+	saved.bytesRemaining = bytesRemaining;
+	saved.closeProb = closeProb;
+	saved.numLastGoodBlk = numLastGoodBlk;
+	saved.anotherFile = anotherFile;
+	saved.NCGbyte = NCGbyte;
+	saved.goodBlk = goodBlk;
+	saved.goodBlk1st = goodBlk1st;
+	saved.syncLoss = syncLoss;
+}
+
+bool ReceiverYCore::restorePeer(const uint8_t state[SNAPSHOT_PEER_SZ], const SessionSnapshot& snap)
+{
+	const ReceiverState& saved{*(const ReceiverState*) state};
+	memcpy(rcvBlk, saved.rcvBlk, sizeof(rcvBlk));
+	memcpy(fileName, saved.fileName, sizeof(fileName));
+	fileName[sizeof(fileName) - 1] = 0;
+	bytesRemaining = saved.bytesRemaining;
+	closeProb = saved.closeProb;
+	numLastGoodBlk = saved.numLastGoodBlk;
+	anotherFile = saved.anotherFile;
+	NCGbyte = saved.NCGbyte;
+	goodBlk = saved.goodBlk;
+	goodBlk1st = saved.goodBlk1st;
+	syncLoss = saved.syncLoss;
+	if (!snap.fileOpen)
+		return true; // no file was open
+	transferringFileD = fileRequest({.kind = FileRequest::REOPEN, .name = fileName});
+	if (transferringFileD == -1)
+		return false;
+	fileOffset = snap.fileOffset;
+	return fileRequest({.kind = FileRequest::SEEK, .fileD = transferringFileD, .n = (size_t) fileOffset}) == fileOffset;
+}
+
+void ReceiverYCore::shareChart(shared_ptr<yReceiverSS>& sm)
+{
+	if (cfg.staticChart)
+		return; // nothing worth sharing
+	if (sm)
+		sm->setCtx(this);
+	else
+		sm = make_shared<yReceiverSS>(this, false);
+	chartSS = sm;
+}
+
+// The same, but with the coroutine form of the protocol (see yReceiverCo.cpp).
+void ReceiverYCore::beginReceiveFilesCo()
+{
+	beginSession(receiveFilesCo(), cfg.receiverReportInfo);
+}
+
+void ReceiverYCore::sessionEnded()
+{
+	if (reportInfo)
+		COUT << "\n"; // insert new line.
+}
+
+// the rest of the block may take up to TM_BLK to arrive, but a gap of a character
+//  time means it has stalled
+int ReceiverYCore::readAheadFor(uint8_t byte, int& timeUnits, int& timeoutUnits)
+{
+	if (byte != SOH)
+		return 0;
+	timeUnits = cfg.tmChar;
+	timeoutUnits = cfg.tmBlk;
+	return REST_BLK_SZ_CRC;
+}
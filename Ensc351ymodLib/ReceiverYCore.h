@@ -0,0 +1,107 @@
+#ifndef RECEIVERYCORE_H
+#define RECEIVERYCORE_H
+
+#include "PeerYCore.h"
+
+namespace yReceiver_SS { class yReceiverSS; }
+
+// the YMODEM receiver, with no I/O of its own (see PeerYCore.h).  ReceiverY runs it on descriptors.
+class ReceiverYCore : public PeerYCore
+{
+public:
+	ReceiverYCore(const PeerYConfig& config = PeerYConfig());
+
+	void getRestBlk();	// get the remaining bytes (132) of a block
+	void writeChunk();
+
+	int
+	//ReceiverYCore::
+	openFileForTransfer()
+	;
+
+   int
+   //ReceiverYCore::
+   closeTransferredFile()
+   ;
+
+	void cans();		// send CAN characters
+
+	uint8_t
+	//ReceiverYCore::
+	checkForAnotherFile()
+	;
+
+	void
+	clearCan()
+	;
+	
+	void purge();
+   void beginReceiveFiles(); // begin receiving files with the statechart (SmartState, or static if cfg.staticChart)
+   void beginReceiveFilesCo(); // the same, but with the coroutine form of the protocol
+
+   /* Run the SmartState statechart in sm rather than in a machine of our own, so that
+    *  a machine constructed once can be reused, one transfer at a time.  If sm is
+    *  empty a machine is constructed into it. */
+   void shareChart(std::shared_ptr<yReceiver_SS::yReceiverSS>& sm);
+
+   /* Continue receiving files from a snapshot (see PeerYCore::snapshot()) instead of
+    *  beginning.  nowUsecs is the time on the clock that will be given to tick().
+    *  Return false if snap cannot be continued. */
+   bool restoreReceiveFiles(const SessionSnapshot& snap, long long nowUsecs);
+
+   int closeProb{1};       // return value from closing the file in closeTransferredFile() indicating error.  0 if no error.
+   uint8_t anotherFile  {0xFF}; // there is a(nother) file to receive.  reset after getting good block #1
+
+	uint8_t NCGbyte{'C'};	// a 'C' sent by receiver to initiate transfers
+
+	/* A Boolean variable that indicates whether the
+	 *  block just received should be ACKed (true) or NAKed (false).*/
+	bool goodBlk;
+
+	/* A Boolean variable that indicates that a good copy of a block
+	 *  being sent has been received for the first time.  It is an
+	 *  indication that the data in a data block can be written to disk.
+	 */
+	bool goodBlk1st;
+
+	/* A Boolean variable that indicates whether or not a fatal loss
+	 *  of synchronization has been detected.*/
+	bool syncLoss;
+
+	/* A variable which counts the number of responses in a
+	 *  row sent because of problems like communication
+	 *  problems. An initial NAK (or 'C') does not add to the count. The reception
+	 *  of a particular block in good condition for the first time resets the count. */
+//	unsigned errCnt;	// found in PeerYCore.h
+
+protected:
+	// an SOH needs the rest of the block to have arrived for getRestBlk()
+	int readAheadFor(uint8_t byte, int& timeUnits, int& timeoutUnits) override;
+	void sessionEnded() override;
+
+	// the coroutine form of the protocol, and of the helpers that have to wait
+	PeerTask receiveFilesCo();
+	PeerTask getRestBlkCo();
+	SessionWait purgeCo() { return discard(5, 10); } // as purge()
+
+	// the statechart on the StaticChart engine (see yReceiverChart.cpp)
+	std::shared_ptr<SessionChart> receiveFilesChart();
+
+	std::shared_ptr<yReceiver_SS::yReceiverSS> chartSS; // or empty to construct a machine for each transfer
+
+	void snapshotPeer(uint8_t state[SNAPSHOT_PEER_SZ]) const override;
+	bool restorePeer(const uint8_t state[SNAPSHOT_PEER_SZ], const SessionSnapshot& snap) override;
+
+private:
+	bool checkRestBlk(int bytesRead); // the checks in getRestBlk().  Returns whether to purge.
+
+	off_t bytesRemaining;   // the number of bytes remaining to be written.
+
+	uint8_t rcvBlk[BUF_SZ];		// a received block
+
+	uint8_t numLastGoodBlk; // the number of the last good block
+
+	char fileName[CHUNK_SZ]{}; // the name of the file being received, to reopen it when restoring
+};
+
+#endif
@@ -0,0 +1,323 @@
+//============================================================================
+// File Name   : SenderYCore.cpp
+// Description : The YMODEM sender, with no I/O of its own (see PeerYCore.h)
+// Portions Copyright (c) 2024 Craig Scratchley  (wcs AT sfu DOT ca)
+//============================================================================
+
+#include "SenderYCore.h"
+
+#include <iostream>
+#include <filesystem>
+#include <stdio.h> // for snprintf()
+#include <stdint.h> // for uint8_t
+#include <string.h> // for memset(), and memcpy() or strncpy()
+
+#include "VNPE.h"
+#include "AtomicCOUT.h"
+#include "ySenderSS.h"
+
+using namespace std;
+using namespace std::filesystem; // C++17 and beyond
+using namespace ySender_SS;
+
+SenderYCore::
+SenderYCore(vector<const char*> iFileNames, const PeerYConfig& config)
+:PeerYCore('[', ']', "SenderSS.log", "SenderSS.prof", config),
+ bytesRd(-2), // initialize with unique value.
+ fileName(nullptr),
+ fileNames(iFileNames),
+ blkNum(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+
+// Send the block, less the block's last byte, to the receiver.
+// Returns the block's last byte.
+uint8_t SenderYCore::sendMostBlk(blkT blkBuf)
+//uint8_t SenderYCore::sendMostBlk(uint8_t blkBuf[BLK_SZ_CRC])
+{
+	const int mostBlockSize{(BLK_SZ_CRC) - 1};
+	mediumWrite(blkBuf, mostBlockSize);
+	return *(blkBuf + mostBlockSize);
+}
+
+// Send the last byte of a block to the receiver
+// First wait for previous part of the block to be drained
+// and then dump any received glitches.
+void
+SenderYCore::
+sendLastByte(uint8_t lastByte)
+{
+	queueSessionOp(OP_DRAIN); // wait for previous part of block to be completely drained from the medium
+	queueSessionOp(OP_DUMP);  // dump any received glitches
+
+	mediumWrite(&lastByte, sizeof(lastByte));
+}
+
+/* Generate a block (numbered 0) with filename and filesize (a "stat" block).
+ * If fileName is empty (""), generate an empty stat block */
+void SenderYCore::genStatBlk(blkT blkBuf, const char* fileName)
+//void SenderYCore::genStatBlk(uint8_t blkBuf[BLK_SZ_CRC], const char* fileName)
+{
+    blkBuf[SOH_OH] = 0;
+    blkBuf[SOH_OH + 1] = ~0;
+    int index{DATA_POS};
+    if (strlen(fileName)) {
+//    if (*fileName) { // (0 != strcmp("", fileName)) { // (strlen(fileName)) {
+        const auto myBasename{path( fileName ).filename().string()};
+        auto c_basename{myBasename.c_str()};
+        const auto fileNameLengthPlus1{strlen(c_basename) + 1};
+        // check for fileNameLengthPlus1 greater than 127.
+        if (fileNameLengthPlus1 + 1 > CHUNK_SZ) { // need at least one decimal digit to store st.st_size below
+            COUT /* cerr */ << "Ran out of space in file info block!  Need block with 1024 bytes of data." << endl;
+            exit(-1);
+        }
+        // On Linux: The maximum length for a file name is 255 bytes. The maximum combined length of both the file name and path name is 4096 bytes.
+        memcpy(&blkBuf[index], c_basename, fileNameLengthPlus1);
+        //strncpy(&blkBuf[index], c_basename, 12X);
+        index += fileNameLengthPlus1;
+        const off_t fileSize{PE(fileRequest({.kind = FileRequest::SIZE, .name = fileName}))};
+        int spaceAvailable = CHUNK_SZ + DATA_POS - index;
+        int spaceNeeded = snprintf((char*)&blkBuf[index], spaceAvailable, "%ld", fileSize); // check the value of CHUNK_SZ + DATA_POS - index
+        if (spaceNeeded > spaceAvailable) {
+            COUT /* cerr */ << "Ran out of space in file info block!  Need block with 1024 bytes of data." << endl;
+            exit(-1);
+        }
+        index += spaceNeeded + 1;
+    }
+    uint8_t padSize = CHUNK_SZ + DATA_POS - index;
+    memset(blkBuf+index, 0, padSize);
+
+    // check here if index is greater than 128 or so.
+    blkBuf[0] = SOH; // can be pre-initialized for efficiency if no 1K blocks allowed
+
+    /* calculate and add CRC in network byte order */
+    crc16ns((uint16_t*)&blkBuf[PAST_CHUNK], &blkBuf[DATA_POS]);
+}
+
+/* tries to generate a block.  Updates the
+variable bytesRd with the number of bytes that were read
+from the input file in order to create the block. Sets
+bytesRd to 0 and does not actually generate a block if the end
+of the input file had been reached when the previously generated block
+was prepared or if the input file is empty (i.e. has 0 length).
+*/
+//void SenderYCore::genBlk(blkT blkBuf)
+void SenderYCore::genBlk(uint8_t blkBuf[BLK_SZ_CRC])
+{
+	//read data and store it directly at the data portion of the buffer
+	bytesRd = PE(fileRequest({.kind = FileRequest::READ, .fileD = transferringFileD,
+	                          .buf = &blkBuf[DATA_POS], .n = CHUNK_SZ}));
+	if (bytesRd>0) {
+		fileOffset += bytesRd;
+		blkBuf[0] = SOH; // can be pre-initialized for efficiency
+		//block number and its complement
+		blkBuf[SOH_OH] = blkNum;
+		blkBuf[SOH_OH + 1] = ~blkNum;
+
+      //pad ctrl-z for the last block
+      uint8_t padSize = CHUNK_SZ - bytesRd;
+      memset(blkBuf+DATA_POS+bytesRd, CTRL_Z, padSize);
+
+		/* calculate and add CRC in network byte order */
+		crc16ns((uint16_t*)&blkBuf[PAST_CHUNK], &blkBuf[DATA_POS]);
+	}
+}
+
+/* Open a file to transfer unless there are none left to transfer in
+ * which case set the fileName to nullptr.
+ * Prepare a stat block with filename and file size, or an empty
+ * stat block if there are no more files to send.
+ * Initialize blkNum to 0.
+*/
+void SenderYCore::prepStatBlk()
+{
+    blkNum = 0;
+    if (fileNameIndex < fileNames.size()) {
+        fileName = fileNames[fileNameIndex];
+        fileNameIndex++;
+        openFileToTransfer(fileName);
+        if(transferringFileD != -1) {
+            genStatBlk(blkBufs[0], fileName); // prepare 0eth block
+        }
+    }
+    else {
+        transferringFileD = -2; // no more files to transfer
+        genStatBlk(blkBufs[0], ""); // prepare 0eth block
+        fileName = nullptr;
+    }
+}
+
+/* While sending the now current block for the first time, prepare the next block if possible.
+*/
+void SenderYCore::sendBlkPrepNext()
+{
+	sendLastByte(sendMostBlkPrepNext());
+}
+
+/* Send all but the last byte of the now current block for the first time, and
+ * prepare the next block if possible.  Return the last byte of the block.
+*/
+uint8_t SenderYCore::sendMostBlkPrepNext()
+{
+	// **** this function will need to be modified ****
+	if (reportInfo)
+		// block will be "w"ritten to the medium
+		COUT << "\n[w" << (int)blkNum << "]" << flush;
+	uint8_t lastByte{sendMostBlk(blkBufs[blkNum%2])};
+    ++blkNum; // stat block just sent or previous block ACK'd
+	if (fileName) {
+	    genBlk(blkBufs[(blkNum)%2]); // prepare next block
+	}
+	return lastByte;
+}
+
+// Resends the block that had been sent previously to the YMODEM receiver.
+void SenderYCore::resendBlk()
+{
+	sendLastByte(resendMostBlk());
+}
+
+// Resend all but the last byte of the previous block.  Return the last byte.
+uint8_t SenderYCore::resendMostBlk()
+{
+	// resend the block including the crc16 (or checksum if code available for that)
+	//  ***** You will have to write this simple function *****
+	if (reportInfo)
+		// block will be "r"ewritten
+		COUT << "[r" << (int)(uint8_t)(blkNum-1) << "]" << flush;
+	return sendMostBlk(blkBufs[((uint8_t)(blkNum-1))%2]);
+}
+
+// Open a file to send and store the file descriptor.
+int
+SenderYCore::
+openFileToTransfer(const char* fileName)
+{
+    transferringFileD = fileRequest({.kind = FileRequest::OPEN, .name = fileName});
+    fileOffset = 0;
+    return transferringFileD;
+}
+
+/* If not already closed, close file that was transferred (or being transferred).
+ * Set transferringFileD to -1 when file is closed.
+ * Return 0 if file is closed or 1 if file was already closed.
+ */
+int
+SenderYCore::
+closeTransferredFile()
+{
+    if (transferringFileD > -1) {
+        PE2(fileRequest({.kind = FileRequest::CLOSE, .fileD = transferringFileD}), to_string(transferringFileD).c_str());
+        transferringFileD = -1;
+        return 0;
+    }
+    else
+        return 1;
+}
+
+/*
+Read and discard contiguous CAN characters. 
+*/
+void SenderYCore::clearCan()
+{
+	PeerYCore::clearCan(cfg.tmChar);
+}
+
+//Send cfg.canLen copies of CAN characters in a row (in groups spaced in time) to the
+//  YMODEM receiver, to inform it of the cancelling of a file transfer.
+//  There should be a total of (canGroups - 1) delays of
+//  ((cfg.tm2Char + cfg.tmChar)/2 * mSECS_PER_UNIT) milliseconds
+//  between the groups of CAN characters.
+void SenderYCore::cans()
+{
+	const int CAN_BURST=2; //The number of CAN chars in a burst.  
+   char buffer[CAN_BURST];
+   memset( buffer, CAN, CAN_BURST);
+
+	const int canGroups=cfg.canLen/CAN_BURST;
+	int x = 1;
+	while (mediumWrite(buffer, CAN_BURST),
+			x<canGroups) {
+		++x;
+	   mediumSleep((int)((cfg.tm2Char + cfg.tmChar)/2 * mSECS_PER_UNIT));
+	}
+}
+
+// Begin the YMODEM protocol to send files.  It starts at the next tick().
+void SenderYCore::beginSendFiles()
+{
+   if (cfg.staticChart)
+      beginSession(sendFilesChart(), cfg.senderReportInfo);
+   else if (chartSS)
+      beginSession(chartSS, cfg.senderReportInfo);
+   else
+      beginSession(make_shared<ySenderSS>(this, false), cfg.senderReportInfo);
+}
+
+bool SenderYCore::restoreSendFiles(const SessionSnapshot& snap, long long nowUsecs)
+{
+   beginSendFiles();
+   return restoreSession(snap, nowUsecs);
+}
+
+namespace {
+// what a sender saves in SessionSnapshot::peerState
+struct SenderState {
+   blkT blkBufs[2];
+   uint8_t blkNum;
+   bool firstBlk;
+   bool haveFileName;
+   unsigned fileNameIndex;
+   ssize_t bytesRd;
+};
+static_assert(sizeof(SenderState) <= SNAPSHOT_PEER_SZ, "SNAPSHOT_PEER_SZ is too small");
+}
+
+void SenderYCore::snapshotPeer(uint8_t state[SNAPSHOT_PEER_SZ]) const
+{
+   SenderState& saved{*(SenderState*) state};
+   memcpy(saved.blkBufs, blkBufs, sizeof(blkBufs));
+   saved.blkNum = blkNum;
+   saved.firstBlk = firstBlk;
+   saved.haveFileName = (fileName != nullptr);
+   saved.fileNameIndex = fileNameIndex;
+   saved.bytesRd = bytesRd;
+}
+
+bool SenderYCore::restorePeer(const uint8_t state[SNAPSHOT_PEER_SZ], const SessionSnapshot& snap)
+{
+   const SenderState& saved{*(const SenderState*) state};
+   if (saved.fileNameIndex > fileNames.size() || (saved.haveFileName && !saved.fileNameIndex))
+      return false;
+   memcpy(blkBufs, saved.blkBufs, sizeof(blkBufs));
+   blkNum = saved.blkNum;
+   firstBlk = saved.firstBlk;
+   fileNameIndex = saved.fileNameIndex;
+   fileName = saved.haveFileName ? fileNames[fileNameIndex - 1] : nullptr;
+   bytesRd = saved.bytesRd;
+   if (!snap.fileOpen)
+      return true; // no file was open
+   if (!fileName || openFileToTransfer(fileName) == -1)
+      return false;
+   fileOffset = snap.fileOffset;
+   return fileRequest({.kind = FileRequest::SEEK, .fileD = transferringFileD, .n = (size_t) fileOffset}) == fileOffset;
+}
+
+void SenderYCore::shareChart(shared_ptr<ySenderSS>& sm)
+{
+   if (cfg.staticChart)
+      return; // nothing worth sharing
+   if (sm)
+      sm->setCtx(this);
+   else
+      sm = make_shared<ySenderSS>(this, false);
+   chartSS = sm;
+}
+
+// The same, but with the coroutine form of the protocol (see ySenderCo.cpp).
+void SenderYCore::beginSendFilesCo()
+{
+   beginSession(sendFilesCo(), cfg.senderReportInfo);
+}
@@ -0,0 +1,103 @@
+#ifndef SENDERYCORE_H
+#define SENDERYCORE_H
+
+#include <vector>
+
+#include <stdint.h> // uint8_t
+
+#include "PeerYCore.h"
+
+namespace ySender_SS { class ySenderSS; }
+
+// the YMODEM sender, with no I/O of its own (see PeerYCore.h).  SenderY runs it on descriptors.
+class SenderYCore : public PeerYCore
+{
+
+public:
+	SenderYCore(std::vector<const char*> iFileNames, const PeerYConfig& config = PeerYConfig());
+	void statBlk(const char* fileName);
+	//void prep1stBlk(); // tries to prepare the first block.
+
+	void
+	//SenderYCore::
+	prepStatBlk()
+	;
+
+	void sendBlkPrepNext(); // While sending the now current block for the first time, prepare the next block if possible.
+    void resendBlk(); // Resends the block that had been sent previously to the xmodem receiver.
+
+    int
+    openFileToTransfer(const char* fileName)
+    ;
+
+    int
+    closeTransferredFile()
+    ;
+
+    void
+    clearCan()
+    ;
+
+    void cans(); // Send cfg.canLen copies of CAN characters in a row.
+    void beginSendFiles(); // begin sending files with the statechart (SmartState, or static if cfg.staticChart)
+    void beginSendFilesCo(); // the same, but with the coroutine form of the protocol
+
+    /* Run the SmartState statechart in sm rather than in a machine of our own, so that
+     *  a machine constructed once can be reused, one transfer at a time.  If sm is
+     *  empty a machine is constructed into it. */
+    void shareChart(std::shared_ptr<ySender_SS::ySenderSS>& sm);
+
+    /* Continue sending files from a snapshot (see PeerYCore::snapshot()) instead of
+     *  beginning, with the same file names.  nowUsecs is the time on the clock that
+     *  will be given to tick().  Return false if snap cannot be continued. */
+    bool restoreSendFiles(const SessionSnapshot& snap, long long nowUsecs);
+
+    ssize_t bytesRd;  // The number of bytes last read from the input file.
+    const char* fileName; // The file currently being sent
+
+	bool firstBlk = false;
+
+    /* A variable which counts the number of problem responses received. The reception
+     *  of an ACK resets the count. */
+//  unsigned errCnt;    // found in PeerYCore.h
+
+private:
+	std::vector<const char*> fileNames;
+	unsigned fileNameIndex{0};
+	//uint8_t blkBufs[BLK_SZ_CRC][2];	// Array of two blocks
+	blkT blkBufs[2];	// Array of two blocks
+
+	uint8_t blkNum;		// number of the current block to be acknowledged
+
+	// Send the block, less the block's last byte, to the receiver
+	uint8_t sendMostBlk(blkT blkBuf);
+//	uint8_t sendMostBlk(uint8_t blkBuf[BLK_SZ_CRC])
+//	;
+
+	// Send the last byte of a block to the receiver
+	void
+	//SenderYCore::
+	sendLastByte(uint8_t lastByte)
+	;
+
+	uint8_t sendMostBlkPrepNext(); // most of sendBlkPrepNext(), less sending the last byte
+	uint8_t resendMostBlk(); // most of resendBlk(), less sending the last byte
+
+	// the coroutine form of the protocol, and of the helpers that have to wait
+	PeerTask sendFilesCo();
+	PeerTask sendLastByteCo(uint8_t lastByte);
+	PeerTask cansCo();
+
+	// the statechart on the StaticChart engine (see ySenderChart.cpp)
+	std::shared_ptr<SessionChart> sendFilesChart();
+
+	std::shared_ptr<ySender_SS::ySenderSS> chartSS; // or empty to construct a machine for each transfer
+
+	void snapshotPeer(uint8_t state[SNAPSHOT_PEER_SZ]) const override;
+	bool restorePeer(const uint8_t state[SNAPSHOT_PEER_SZ], const SessionSnapshot& snap) override;
+
+    void genBlk(blkT blkBuf); // tries to generate a block.
+	void genStatBlk(blkT blkBuf, const char* fileName); // generate a stat block, possibly empty
+};
+
+#endif
@@ -0,0 +1,150 @@
+//============================================================================
+// File Name   : SessionPool.cpp
+// Description : Run YMODEM sessions on per-core Reactors with work stealing.
+//============================================================================
+
+#include "SessionPool.h"
+
+#include <sys/eventfd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string>
+
+#include "VNPE.h"
+
+using namespace std;
+
+SessionPool::
+SessionPool(unsigned threads, bool pinCores)
+{
+	if (!threads)
+		threads = max(1u, thread::hardware_concurrency());
+	for (unsigned i{0}; i < threads; ++i) {
+		workers.push_back(make_unique<Worker>());
+		workers.back()->wakeD = PE(eventfd(0, EFD_NONBLOCK));
+	}
+	// start threads only once all workers exist, as they look at each other
+	for (unsigned i{0}; i < threads; ++i)
+		workers[i]->thread = thread(&SessionPool::run, this, i, pinCores);
+}
+
+SessionPool::
+~SessionPool()
+{
+	wait();
+	stopping = true;
+	for (unsigned i{0}; i < workers.size(); ++i)
+		wake(i);
+	for (auto& worker: workers) {
+		worker->thread.join();
+		PE(close(worker->wakeD));
+	}
+}
+
+void
+SessionPool::
+wake(unsigned index)
+{
+	uint64_t one{1};
+	PE(write(workers[index]->wakeD, &one, sizeof(one)));
+}
+
+void
+SessionPool::
+give(unsigned index, shared_ptr<PeerY> peer, Reactor::DoneFn onDone)
+{
+	auto& worker{*workers[index]};
+	{
+		lock_guard lk(worker.mutex);
+		worker.incoming.emplace_back(move(peer), move(onDone));
+		++worker.load;
+	}
+	wake(index);
+}
+
+void
+SessionPool::
+add(shared_ptr<PeerY> peer, Reactor::DoneFn onDone)
+{
+	{
+		lock_guard lk(doneMutex);
+		++active;
+	}
+	unsigned least{0};
+	for (unsigned i{1}; i < workers.size(); ++i)
+		if (workers[i]->load < workers[least]->load)
+			least = i;
+	// count the session as finished after its own onDone
+	give(least, move(peer), [this, onDone = move(onDone)](PeerY& peer) {
+		if (onDone)
+			onDone(peer);
+		lock_guard lk(doneMutex);
+		if (0 == --active)
+			doneCv.notify_all();
+	});
+}
+
+void
+SessionPool::
+wait()
+{
+	unique_lock lk(doneMutex);
+	doneCv.wait(lk, [this]{ return 0 == active; });
+}
+
+void
+SessionPool::
+run(unsigned index, bool pinCore)
+{
+	auto& me{*workers[index]};
+	PE_0(pthread_setname_np(pthread_self(), ("R" + to_string(index)).c_str())); // give the thread a name
+	if (pinCore) {
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(index % CPU_SETSIZE, &cpus);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus); // may fail if fewer cores are allowed
+	}
+
+	Reactor reactor;
+	reactor.setWakeD(me.wakeD);
+	while (!stopping) {
+		// take any sessions given to this thread
+		{
+			lock_guard lk(me.mutex);
+			while (!me.incoming.empty()) {
+				reactor.add(move(me.incoming.front().first), move(me.incoming.front().second));
+				me.incoming.pop_front();
+			}
+			me.load = reactor.size();
+		}
+
+		// give a session to a thread that asked for one
+		int thief{me.thief.exchange(-1)};
+		if (thief >= 0 && me.load > workers[thief]->load + 1) {
+			Reactor::DoneFn onDone;
+			if (auto peer{reactor.removeUnpinned(onDone)}) {
+				--me.load;
+				give(thief, move(peer), move(onDone));
+			}
+			else
+				me.thief = thief; // everything is pinned right now; try again next time around
+		}
+
+		// ask the busiest thread for a session if it has at least two more than this one
+		unsigned busiest{index};
+		for (unsigned i{0}; i < workers.size(); ++i)
+			if (workers[i]->load > workers[busiest]->load)
+				busiest = i;
+		if (busiest != index && workers[busiest]->load > me.load + 1) {
+			int none{-1};
+			if (workers[busiest]->thief.compare_exchange_strong(none, index))
+				wake(busiest);
+		}
+
+		PE(reactor.runOnce());
+		lock_guard lk(me.mutex);
+		me.load = reactor.size() + me.incoming.size(); // finished sessions have been removed
+	}
+}
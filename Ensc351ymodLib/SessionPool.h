@@ -0,0 +1,61 @@
+/*
+ * SessionPool.h
+ *
+ * Runs YMODEM sessions on several threads, one Reactor per thread and
+ *  (by default) per core.  New sessions go to the least loaded thread.
+ *  A thread with noticeably fewer sessions than another steals one from
+ *  it, but only a session that is not pinned (see PeerY::sessionPinned()),
+ *  so that the events of a block in flight are all handled, in order,
+ *  by one thread.
+ */
+
+#ifndef SESSIONPOOL_H_
+#define SESSIONPOOL_H_
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "Reactor.h"
+
+class SessionPool {
+public:
+	// 0 threads means one per core.  Thread i is pinned to core i if pinCores.
+	explicit SessionPool(unsigned threads = 0, bool pinCores = true);
+	~SessionPool(); // waits for all sessions to finish
+
+	unsigned threads() const { return workers.size(); }
+
+	// add a peer whose session has begun.  onDone (if any) is called on a
+	//  pool thread when the session finishes.
+	void add(std::shared_ptr<PeerY> peer, Reactor::DoneFn onDone = nullptr);
+
+	// wait until all sessions added so far have finished
+	void wait();
+
+private:
+	struct Worker {
+		int wakeD{-1};					// eventfd to interrupt the Reactor
+		std::mutex mutex;				// protects incoming
+		std::deque<std::pair<std::shared_ptr<PeerY>, Reactor::DoneFn>> incoming;
+		std::atomic<int> load{0};		// sessions owned or incoming
+		std::atomic<int> thief{-1};		// worker asking for a session, or -1
+		std::thread thread;
+	};
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	std::mutex doneMutex;
+	std::condition_variable doneCv;
+	int active{0};			// protected by doneMutex
+	std::atomic<bool> stopping{false};
+
+	void run(unsigned index, bool pinCore);
+	void give(unsigned index, std::shared_ptr<PeerY> peer, Reactor::DoneFn onDone);
+	void wake(unsigned index);
+};
+
+#endif /* SESSIONPOOL_H_ */
@@ -0,0 +1,412 @@
+/*
+ * StaticChart.h
+ *
+ * A statechart engine whose states and transitions are constant tables,
+ *  in the spirit of Boost.SML.  A chart is a class with
+ *
+ *     typedef ... Context;                        // the class the actions work on
+ *     static constexpr StateDef<Context> states[]; // in SmartState construction order
+ *     static constexpr Row<Context> rows[];        // in the order SmartState tries them
+ *
+ *  and StaticChart<Chart> runs it.  The rows of each state are chosen at
+ *  compile time, so an event is offered to a state by one call through a
+ *  constant table, there are no virtual calls inside the machine, and
+ *  nothing is allocated.
+ *
+ * The machines behave as the SmartState ones generated from the same model
+ *  (ss_api.cpp), including which states are exited and entered and when
+ *  history is recorded.  Only one state is active at a time (no concurrent
+ *  states), and a composite state may not have a transition into itself
+ *  or one of its own substates.
+ */
+
+#ifndef STATICCHART_H_
+#define STATICCHART_H_
+
+#include <array>
+#include <cstdint>	// for int16_t
+#include <iterator>	// for std::size()
+#include <string>
+#include <utility>	// for std::index_sequence
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "ss_api.hxx"	// for smartstate::EventInbox
+
+// the statechart running a session, whichever way the chart is implemented
+class SessionChart {
+public:
+	SessionChart() : injectFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+	SessionChart(const SessionChart&) = delete;
+	SessionChart& operator=(const SessionChart&) = delete;
+	virtual ~SessionChart()
+	{
+		if (-1 != injectFd)
+			close(injectFd);
+	}
+	virtual void start() = 0;
+	virtual void postEvent(unsigned int event, int wParam = 0) = 0;
+	virtual bool isRunning() const = 0;
+
+	/* Any thread may inject() an event, without locking.  It is delivered by
+	 *  drainInjected(), called like the others only by the thread running
+	 *  the chart.  inject() returns false if the event had to be dropped.
+	 *  injectD() (an eventfd) is readable once an event has been injected, so
+	 *  that the thread running the chart can wait for one in poll() or select().
+	 *  That thread calls clearInjectD() before drainInjected(), so that an
+	 *  event injected in between still leaves it readable. */
+	bool inject(unsigned int event, int wParam = 0)
+	{
+		if (!pushInjected(event, wParam))
+			return false;
+		const uint64_t one{1};
+		if (-1 != injectFd)
+			(void) !write(injectFd, &one, sizeof(one));
+		return true;
+	}
+	virtual int drainInjected() = 0;
+	virtual bool hasInjected() const = 0;
+	int injectD() const { return injectFd; } // or -1 if no eventfd could be made
+	void clearInjectD()
+	{
+		uint64_t count;
+		if (-1 != injectFd)
+			(void) !read(injectFd, &count, sizeof(count));
+	}
+
+	/* Save the state of the chart to buf, between events.  Return the number of
+	 *  bytes saved, or 0 if n is too small.  restore() loads what snapshot() saved
+	 *  from the same chart, leaving it running, and returns false if it cannot. */
+	virtual size_t snapshot(uint8_t* buf, size_t n) const = 0;
+	virtual bool restore(const uint8_t* buf, size_t n) = 0;
+
+	// the transfer has finished, with result
+	virtual void finished(const std::string& result) {}
+
+protected:
+	// queue an injected event, or return false if there is no room
+	virtual bool pushInjected(unsigned int event, int wParam) = 0;
+
+private:
+	const int injectFd;
+};
+
+namespace staticchart
+{
+	enum {NO_STATE = -1,	// the parent of the top state
+		  INTERNAL = -2,	// the target of a transition that exits and enters nothing
+		  FINAL = -3};		// the target of a transition that ends the machine
+
+	// The most posted messages that can be waiting at once.
+	const unsigned POST_MAX = 4;
+
+	// where actions post messages, as with POST_ALL in SmartState models
+	class Post
+	{
+	public:
+		void post(unsigned int event, int wParam = 0)
+		{
+			if (count == POST_MAX)
+				throw std::string("Posted message queue of a static chart is full, message "
+					+ std::to_string(event) + " dropped.");
+			posted[(head + count++) % POST_MAX] = {event, wParam};
+		}
+
+	protected:
+		struct Posted {unsigned int event; int wParam;};
+		bool takePosted(Posted& next)
+		{
+			if (!count)
+				return false;
+			next = posted[head];
+			head = (head + 1) % POST_MAX;
+			--count;
+			return true;
+		}
+		void clearPosted() { head = count = 0; }
+
+	private:
+		Posted posted[POST_MAX];
+		unsigned head{0};
+		unsigned count{0};
+	};
+
+	template<class Context>
+	struct StateDef
+	{
+		typedef void (*Action)(Context& ctx, int c, Post& post);
+
+		const char* name;
+		int parent;		// or NO_STATE
+		bool super;		// a composite state, entered at its first substate ...
+		bool history;	// ... or, with history, at the substate last left
+		Action entry;	// or nullptr
+		Action exit;	// or nullptr
+	};
+
+	template<class Context>
+	struct Row
+	{
+		typedef bool (*Guard)(Context& ctx, int c);
+		typedef void (*Action)(Context& ctx, int c, Post& post);
+
+		int from;
+		unsigned int event;
+		Guard guard;	// or nullptr for always
+		int to;			// a state, INTERNAL or FINAL
+		Action effect;	// or nullptr
+	};
+}
+
+template<class Chart>
+class StaticChart : public SessionChart, public staticchart::Post
+{
+public:
+	typedef typename Chart::Context Context;
+
+	explicit StaticChart(Context* ctx)
+	:ctx(*ctx)
+	{
+		history.fill(staticchart::NO_STATE);
+	}
+
+	void start() override
+	{
+		history.fill(staticchart::NO_STATE);
+		clearPosted();
+		running = true;
+		leaf = initialLeaf(0);
+		enterPath(staticchart::NO_STATE, leaf);
+		deliverPosted();
+	}
+
+	void postEvent(unsigned int event, int wParam = 0) override
+	{
+		if (!running)
+			throw std::string("Not Running");
+		if (busy) {
+			post(event, wParam);
+			return;
+		}
+		busy = true;
+		clearPosted();
+		try {
+			dispatch(event, wParam);
+			deliverPosted();
+		}
+		catch (...) {
+			busy = false;
+			throw;
+		}
+		busy = false;
+	}
+
+	bool isRunning() const override { return running; }
+
+	int drainInjected() override
+	{
+		int delivered{0};
+		unsigned int event;
+		int wParam;
+		while (inbox.pop(event, wParam)) {
+			postEvent(event, wParam);
+			++delivered;
+		}
+		return delivered;
+	}
+	bool hasInjected() const override { return !inbox.empty(); }
+
+	// the active state and then the history of each state
+	size_t snapshot(uint8_t* buf, size_t n) const override
+	{
+		if (n < (1 + N) * sizeof(int16_t))
+			return 0;
+		int16_t* item{(int16_t*) buf};
+		*item++ = leaf;
+		for (int s{0}; s < N; ++s)
+			*item++ = history[s];
+		return (1 + N) * sizeof(int16_t);
+	}
+
+	bool restore(const uint8_t* buf, size_t n) override
+	{
+		const int16_t* item{(const int16_t*) buf};
+		if (n != (1 + N) * sizeof(int16_t) || item[0] < 0 || item[0] >= N)
+			return false;
+		for (int s{0}; s < N; ++s)
+			if (item[1 + s] != staticchart::NO_STATE && (item[1 + s] < 0 || item[1 + s] >= N))
+				return false;
+		leaf = item[0];
+		for (int s{0}; s < N; ++s)
+			history[s] = item[1 + s];
+		clearPosted();
+		busy = false;
+		running = true;
+		return true;
+	}
+
+	// the active state, or NO_STATE once the machine has finished
+	int state() const { return leaf; }
+	static const char* stateName(int state) { return Chart::states[state].name; }
+
+protected:
+	bool pushInjected(unsigned int event, int wParam) override { return inbox.push(event, wParam); }
+
+private:
+	typedef staticchart::StateDef<Context> StateDef;
+	typedef staticchart::Row<Context> Row;
+
+	static constexpr int N{(int) std::size(Chart::states)};
+	static constexpr size_t R{std::size(Chart::rows)};
+
+	static constexpr bool isAncestorOrSelf(int ancestor, int state)
+	{
+		for (; state != staticchart::NO_STATE; state = Chart::states[state].parent)
+			if (state == ancestor)
+				return true;
+		return false;
+	}
+
+	static constexpr bool validChart()
+	{
+		if (Chart::states[0].parent != staticchart::NO_STATE)
+			return false;
+		for (int s{1}; s < N; ++s)
+			if (Chart::states[s].parent < 0 || Chart::states[s].parent >= s)
+				return false;
+		for (const Row& row: Chart::rows)
+			if (row.to >= 0 && Chart::states[row.from].super && isAncestorOrSelf(row.from, row.to))
+				return false;
+		return true;
+	}
+	static_assert(validChart(), "the chart has a shape StaticChart does not support");
+
+	// the first substate constructed is the initial one
+	static constexpr int firstChild(int state)
+	{
+		for (int s{state + 1}; s < N; ++s)
+			if (Chart::states[s].parent == state)
+				return s;
+		return staticchart::NO_STATE;
+	}
+
+	int initialLeaf(int state) const
+	{
+		while (Chart::states[state].super)
+			state = history[state] != staticchart::NO_STATE ? history[state] : firstChild(state);
+		return state;
+	}
+
+	// enter the states below from, down to and including to
+	void enterPath(int from, int to)
+	{
+		if (to == from)
+			return;
+		enterPath(from, Chart::states[to].parent);
+		if (Chart::states[to].entry)
+			Chart::states[to].entry(ctx, 0, *this);
+	}
+
+	static int commonRoot(int state1, int state2)
+	{
+		for (; state1 != staticchart::NO_STATE; state1 = Chart::states[state1].parent)
+			if (isAncestorOrSelf(state1, state2))
+				return state1;
+		throw std::string("Invalid transition, no common super state.");
+	}
+
+	void take(const Row& row, int c)
+	{
+		if (row.to == staticchart::INTERNAL) {
+			if (row.effect)
+				row.effect(ctx, c, *this);
+			return;
+		}
+		const int from{row.from};
+		if (row.to == staticchart::FINAL) {
+			leaf = staticchart::NO_STATE;
+			if (Chart::states[from].exit)
+				Chart::states[from].exit(ctx, 0, *this);
+			if (row.effect)
+				row.effect(ctx, c, *this);
+			running = false;
+			return;
+		}
+		const int root{commonRoot(from, row.to)};
+		// SmartState records history only when a state enclosing the active one leaves
+		if (from != leaf && root != from) {
+			int parent{Chart::states[leaf].parent};
+			if (Chart::states[parent].super && Chart::states[parent].history)
+				history[parent] = leaf;
+		}
+		// ... and exits from the state with the transition, not the active one
+		for (int s{from}; s != root; s = Chart::states[s].parent)
+			if (Chart::states[s].exit)
+				Chart::states[s].exit(ctx, 0, *this);
+		if (row.effect)
+			row.effect(ctx, c, *this);
+		leaf = initialLeaf(row.to);
+		enterPath(root, row.to);
+		enterPath(row.to, leaf);
+	}
+
+	// offer an event to the rows of state S, in order
+	template<int S, size_t I>
+	bool tryRow(unsigned int event, int c)
+	{
+		constexpr const Row& row{Chart::rows[I]};
+		if constexpr (row.from != S)
+			return false;
+		else {
+			if (row.event != event || (row.guard && !row.guard(ctx, c)))
+				return false;
+			take(row, c);
+			return true;
+		}
+	}
+
+	template<int S, size_t... I>
+	bool handle(unsigned int event, int c, std::index_sequence<I...>)
+	{
+		return (tryRow<S, I>(event, c) || ...);
+	}
+
+	template<int S>
+	bool handleState(unsigned int event, int c)
+	{
+		return handle<S>(event, c, std::make_index_sequence<R>{});
+	}
+
+	typedef bool (StaticChart::*Handler)(unsigned int event, int c);
+
+	template<int... S>
+	static constexpr std::array<Handler, N> makeHandlers(std::integer_sequence<int, S...>)
+	{
+		return {&StaticChart::handleState<S>...};
+	}
+	static constexpr std::array<Handler, N> handlers{makeHandlers(std::make_integer_sequence<int, N>{})};
+
+	// offer the event to the active state and then to the states enclosing it
+	void dispatch(unsigned int event, int c)
+	{
+		for (int s{leaf}; s != staticchart::NO_STATE; s = Chart::states[s].parent)
+			if ((this->*handlers[s])(event, c))
+				return;
+	}
+
+	void deliverPosted()
+	{
+		Posted next;
+		while (takePosted(next))
+			dispatch(next.event, next.wParam);
+	}
+
+	Context& ctx;
+	int leaf{staticchart::NO_STATE};
+	std::array<int, N> history; // the substate last left, for each state with history
+	bool running{false};
+	bool busy{false};
+	smartstate::EventInbox inbox;
+};
+
+#endif /* STATICCHART_H_ */
@@ -1,357 +1,1576 @@
-//============================================================================
-// Name        : myIO.cpp
-// Author(s)   : Craig Scratchley
-//			   :
-// Version     : November 2024 -- tcdrain for socketpairs.
-// Copyright   : Copyright 2024, W. Craig Scratchley, SFU
-// Description : An implementation of tcdrain-like behaviour for socketpairs.
-//============================================================================
-
-// use a circular buffer instead of read() and write() functions.
-//#define CIRCBUF
-
-#include <sys/socket.h>
-#include <unistd.h>				// for posix i/o functions
-#include <stdlib.h>
-#include <termios.h>			// for tcdrain()
-#include <fcntl.h>				// for open/creat
-#include <errno.h>
-#include <stdarg.h>
-#include <mutex>				
-#include <shared_mutex>
-#include <condition_variable>	
-#include <map>
-#include <memory>
-#include "AtomicCOUT.h"
-#include "SocketReadcond.h"
-#include "VNPE.h"
-#ifdef CIRCBUF
-    #include "RageUtil_CircularBuffer.h"
-#endif
-
-using namespace std;
-using namespace std::chrono;
-
-// derived from https://stackoverflow.com/a/40159821
-// tweaked by Craig Scratchley
-// other variations might be useful.
-// get a Value for a key in m or return a default_value if the key is not present
-template <typename Key, typename Value, typename T>
-Value get_or(std::map<Key, Value>& m, const Key& key, T&& default_value)
-{
-    auto it{m.find(key)};
-    if (m.end() == it) {
-        return default_value;
-    }
-    return it->second;
-}
-
-//Unnamed namespace
-namespace{
-
-    class socketInfoClass;
-
-    typedef shared_ptr<socketInfoClass> socketInfoClassSp;
-    map<int, socketInfoClassSp> desInfoMap;
-
-    //  A shared mutex used to protect desInfoMap so only a single thread can modify the map at a time.
-    //  This also means that only one call to functions like mySocketpair() or myClose() can make progress at a time.
-    //  This mutex is also used to prevent a paired socket from being closed at the beginning of a myWrite or myTcdrain function.
-    //  Shared mutex is described in Section 3.3.2 of Williams 2e
-    shared_mutex mapMutex;
-
-    class socketInfoClass {
-        unsigned totalWritten{0};
-        unsigned maxTotalCanRead{0};
-        condition_variable cvDrain;
-        condition_variable cvRead;
-    #ifdef CIRCBUF
-        CircBuf<char> circBuffer;
-//        bool connectionReset = false;
-    #endif
-        mutex socketInfoMutex;
-    public:
-        int pair;   // Cannot be private because myWrite and myTcdrain using it.
-                    // -1 when descriptor closed, -2 when paired descriptor is closed
-
-        socketInfoClass(unsigned pairInit)
-        :pair(pairInit) {
-    #ifdef CIRCBUF
-           circBuffer.reserve(1100); // note constant of 1100
-    #endif
-        }
-
-	/*
-	 * Function:  if necessary, make the calling thread wait for a reading thread to drain the data
-	 */
-	int draining(shared_lock<shared_mutex> &desInfoLk)
-	{ // operating on object for paired descriptor of original des
-		unique_lock socketLk(socketInfoMutex);
-		desInfoLk.unlock();
-
-		//  once the reader decides the drainer should wakeup, it should wakeup
-		if (pair >= 0 && totalWritten > maxTotalCanRead)
-			cvDrain.wait(socketLk); // spurious wakeup?  Not a problem with Linux p-threads
-		   // In the Solaris implementation of condition variables,
-		   //    a spurious wakeup may occur without the condition being assigned
-		   //    if the process is signaled; the wait system call aborts and
-		   //    returns EINTR.[2] The Linux p-thread implementation of condition variables
-		   //    guarantees that it will not do that.[3][4]
-		   // https://en.wikipedia.org/wiki/Spurious_wakeup
-		   //  cvDrain.wait(socketLk, [this]{return pair < 0 || totalWritten <= maxTotalCanRead;});
-
-//		if (pair == -2) { // shouldn't normally happen
-//			errno = EBADF; // check errno
-//			return -1;
-//		}
-		return 0;
-	}
-
-	int writing(int des, const void* buf, size_t nbyte, shared_lock<shared_mutex> &desInfoLk)	{
-		// operating on object for paired descriptor
-		lock_guard socketLk(socketInfoMutex);
-      desInfoLk.unlock();
-
-#ifdef CIRCBUF
-		int written = circBuffer.write((const char*) buf, nbyte);
-#else
-		int written = write(des, buf, nbyte);
-#endif
-        if (written > 0) {
-            totalWritten += written;
-            cvRead.notify_one();
-        }
-        return written;
-	}
-
-	int reading(int des, void * buf, int n, int min, int time, int timeout, shared_lock<shared_mutex> &desInfoLk)
-	{ // it is assumed that des is for a socket in a socketpair created by mySocketpair
-		int bytesRead;
-		unique_lock socketLk(socketInfoMutex);
-      desInfoLk.unlock();
-
-		// would not have got this far if pair == -1
-      if (-2 == pair)
-         bytesRead = 0; // this avoids errno == 104 (Connection Reset by Peer)
-      else if (!maxTotalCanRead && totalWritten >= (unsigned) min) {
-         if (0 == min && 0 == totalWritten)
-             bytesRead = 0;
-         else {
-#ifdef CIRCBUF
-		        bytesRead = circBuffer.read((char *) buf, n);
-#else
-		        bytesRead = read(des, buf, n); // at least min will be waiting
-#endif
-		        if (bytesRead > 0) {
-		           totalWritten -= bytesRead;
-		           if (totalWritten <= maxTotalCanRead) {
-		              int errnoHold{errno};
-                    cvDrain.notify_all();
-                    errno = errnoHold;
-		           }
-		        }
-		    }
-		}
-		else {
-			maxTotalCanRead += n;
-         int errnoHold{errno};
-         cvDrain.notify_all(); // totalWritten must be less than min
-//         if (time != 0 || timeout != 0) {
-//             COUT << "Currently only supporting no timeouts or immediate timeout" << endl;
-//             haltExit(EXIT_FAILURE);
-//         }
-
-         /* Here we are only waiting for "time".  We are not waiting for the inter-character 'timeout" */
-         cvRead.wait_for(socketLk, duration<int, deci>{time}, [this, min] {
-            return totalWritten >= (unsigned) min || pair < 0;});
-
-         errno = errnoHold;
-//			if (pair == -1) { // shouldn't normally happen
-//			   errno = EBADF; // check errno value
-//			   return -1;
-//			}
-#ifdef CIRCBUF
-			bytesRead = circBuffer.read((char *) buf, n);
-         totalWritten -= bytesRead;
-#else
-			// choice below could affect "Connection reset by peer" from read/wcsReadcond
-         if (totalWritten > 0)
-             bytesRead = read(des, buf, n);
-         else
-             bytesRead = 0;
-//			bytesRead = wcsReadcond(des, buf, n, 0, 0, 0);
-
-			if (-1 != bytesRead)
-            totalWritten -= bytesRead;
-			else
-			   if (ECONNRESET == errno)
-			      bytesRead = 0;
-#endif // #ifdef CIRCBUF
-            
-			maxTotalCanRead -= n;
-			if (0 < totalWritten || -2 == pair) {
-            int errnoHold{errno}; // debug gui not updating errnoHold very well.
-            cvRead.notify_one();
-            errno = errnoHold;
-         }
-		}
-		return bytesRead;
-	} // .reading()
-
-	/*
-	 * Function:  Closing des. Should be done only after all other operations on des have returned.
-	 */
-	int closing(int des)
-	{
-		// mapMutex already locked at this point, so no other myClose (or mySocketpair)
-		if(pair != -2) { // pair has not already been closed
-			socketInfoClassSp des_pair{desInfoMap[pair]};
-			// See Williams 2e, 2nd half of section 3.2.4
-			scoped_lock guard(socketInfoMutex, des_pair->socketInfoMutex); // safely lock both mutexes
-			pair = -1; // this is first socket in the pair to be closed
-			des_pair->pair = -2; // paired socket will be the second of the two to close.
-         if (totalWritten > maxTotalCanRead) {
-             // by closing the socket we are throwing away any buffered data.
-             // notification will be sent immediately below to any myTcdrain waiters on paired descriptor.
-             cvDrain.notify_all();
-         }
-//         if (maxTotalCanRead > 0) {
-//             // there shouldn't be any threads waiting in myRead() or myReadcond() on des, but just in case.
-//             cvRead.notify_all();
-//         }
-
-			if (des_pair->maxTotalCanRead > 0) {
-				// no more data will be written from des
-				// notify a thread waiting on reading on paired descriptor
-				des_pair->cvRead.notify_one();
-			}
-//			if (des_pair->totalWritten > des_pair->maxTotalCanRead) {
-//				// there shouldn't be any threads waiting in myTcdrain on des, but just in case.
-//				des_pair->cvDrain.notify_all();
-//			}
-		}
-		return close (des);
-	} // .closing()
-	}; // socketInfoClass
-} // unnamed namespace
-
-/*
- * Function:	Calling the reading member function to read
- * Return:		An integer with number of bytes read, or -1 for an error.
- * see https://www.qnx.com/developers/docs/7.1/#com.qnx.doc.neutrino.lib_ref/topic/r/readcond.html
- *
- */
-int myReadcond(int des, void * buf, int n, int min, int time, int timeout) {
-   shared_lock desInfoLk(mapMutex);
-   auto desInfoP{get_or(desInfoMap, des, nullptr)}; // make a local shared pointer
-   if (desInfoP)
-	    return desInfoP->reading(des, buf, n, min, time, timeout, desInfoLk);
-    return wcsReadcond(des, buf, n, min, time, timeout);
-}
-
-/*
- * Function:	Reading directly from a file or from a socketpair descriptor)
- * Return:		the number of bytes read , or -1 for an error
- */
-ssize_t myRead(int des, void* buf, size_t nbyte) {
-   shared_lock desInfoLk(mapMutex);
-   auto desInfoP{get_or(desInfoMap, des, nullptr)}; // make a local shared pointer
-	if (desInfoP)
-	    // myRead (for sockets) usually reads a minimum of 1 byte
-	    return desInfoP->reading(des, buf, nbyte, 1, 0, 0, desInfoLk);
-	return read(des, buf, nbyte); // des is closed or not from a socketpair
-}
-
-/*
- * Return:		the number of bytes written, or -1 for an error
- */
-ssize_t myWrite(int des, const void* buf, size_t nbyte) {
-    {
-        shared_lock desInfoLk(mapMutex);
-        auto desInfoP{get_or(desInfoMap, des, nullptr)};
-        if (desInfoP) {
-           auto pair{desInfoP->pair};
-           if (-2 != pair)
-              return desInfoMap[pair]->writing(des, buf, nbyte, desInfoLk);
-        }
-    }
-    return write(des, buf, nbyte); // des is not from a pair of sockets or socket or pair closed
-}
-
-/*
- * Function:  make the calling thread wait for a reading thread to drain the data
- */
-int myTcdrain(int des) {
-    {
-        shared_lock desInfoLk(mapMutex);
-        auto desInfoP{get_or(desInfoMap, des, nullptr)};
-        if (desInfoP) {
-           auto pair{desInfoP->pair};
-           if (-2 == pair)
-              return 0; // paired descriptor is closed.
-           else {
-              auto desPairInfoSp{desInfoMap[pair]}; // make a local shared pointer
-              return desPairInfoSp->draining(desInfoLk);
-           }
-        }
-    }
-    return tcdrain(des); // des is not from a pair of sockets or socket closed
-}
-
-/*
- * Function:   Create pair of sockets and put them in desInfoMap
- * Return:     return an integer that indicate if it is successful (0) or not (-1)
- */
-int mySocketpair(int domain, int type, int protocol, int des[2]) {
-   int returnVal{socketpair(domain, type, protocol, des)};
-   if(-1 != returnVal) {
-      lock_guard desInfoLk(mapMutex);
-      desInfoMap[des[0]] = make_shared<socketInfoClass>(des[1]);
-      desInfoMap[des[1]] = make_shared<socketInfoClass>(des[0]);
-   }
-   return returnVal;
-}
-
-/*
- * Function:   close des
- *       myClose() should not be called until all other calls using the descriptor have finished.
- */
-int myClose(int des) {
-   {
-        lock_guard desInfoLk(mapMutex);
-        auto iter{desInfoMap.find(des)};
-        if (iter != desInfoMap.end()) { // if in the map
-            auto mySp{iter->second};
-            desInfoMap.erase(iter);
-            if (mySp) // if shared pointer exists (it should)
-                return mySp->closing(des);
-        }
-   }
-   return close(des);
-}
-
-/*
- * Function:	Open a file and get its file descriptor.
- * Return:		return value of open
- */
-int myOpen(const char *pathname, int flags, ...) //, mode_t mode)
-{
-   mode_t mode{0};
-   // in theory we should check here whether mode is needed.
-   va_list arg;
-   va_start (arg, flags);
-   mode = va_arg (arg, mode_t);
-   va_end (arg);
-   return open(pathname, flags, mode);
-}
-
-/*
- * Function:	Create a new file and get its file descriptor.
- * Return:		return value of creat
- */
-int myCreat(const char *pathname, mode_t mode)
-{
-   return creat(pathname, mode);
-}
-
-
+//============================================================================
+// Name        : myIO.cpp
+// Author(s)   : Craig Scratchley
+//			   :
+// Version     : November 2024 -- tcdrain for socketpairs.
+// Copyright   : Copyright 2024, W. Craig Scratchley, SFU
+// Description : An implementation of tcdrain-like behaviour for socketpairs.
+//============================================================================
+
+#include <sys/socket.h>
+#include <sys/uio.h>			// for readv/writev
+#include <poll.h>
+#include <unistd.h>				// for posix i/o functions
+#include <stdlib.h>
+#include <stdint.h>				// for uint64_t
+#include <string.h>				// for strcmp()
+#include <termios.h>			// for tcdrain()
+#include <sys/ioctl.h>			// for TIOCOUTQ
+#include <fcntl.h>				// for open/creat
+#include <errno.h>
+#include <stdarg.h>
+#include <mutex>				
+#include <condition_variable>	
+#include <atomic>
+#include <thread>				// for hardware_concurrency()
+#include <climits>				// for INT_MAX
+#include <pthread.h>			// for pthread_atfork()
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>			// for memfd_create(), mmap()
+#include <sys/eventfd.h>
+#include <signal.h>				// for kill()
+#include <time.h>
+#endif
+#include <vector>
+#include <memory>
+#include "myIO.h"
+#include "AtomicCOUT.h"
+#include "SocketReadcond.h"
+#include "VNPE.h"
+#include "RageUtil_CircularBuffer.h"
+
+using namespace std;
+using namespace std::chrono;
+
+//Unnamed namespace
+namespace{
+
+    class socketInfoClass;
+
+    /* The socketInfoClass objects are found through a table indexed by descriptor, so
+     *  that finding one is a load rather than a locked map lookup.  The table and the
+     *  objects are protected with epochs (a simple form of RCU): a thread using them
+     *  holds an EpochGuard, which only writes to the thread's own EpochRecord.  A
+     *  table or object that has been unlinked is only deleted once every thread that
+     *  might still be using it has left its guard.  See Section 7.2.3 of Williams 2e.
+     */
+    const unsigned long long QUIESCENT{~0ULL}; // the epoch of a thread with no guard
+
+    struct alignas(64) EpochRecord { // one per thread, each on its own cache line
+        atomic<unsigned long long> epoch{QUIESCENT};
+        atomic<bool> inUse{true};
+        EpochRecord* next{nullptr};
+        unsigned depth{0}; // guards held, only used by the thread itself
+    };
+
+    atomic<unsigned long long> globalEpoch{1};
+    atomic<EpochRecord*> epochRecords{nullptr}; // records are reused, never deleted
+
+    EpochRecord* takeEpochRecord()
+    {
+        for (EpochRecord* record{epochRecords.load()}; record; record = record->next) {
+            bool inUse{false};
+            if (record->inUse.compare_exchange_strong(inUse, true))
+                return record; // left by a thread that has finished
+        }
+        EpochRecord* record{new EpochRecord};
+        record->next = epochRecords.load();
+        while (!epochRecords.compare_exchange_weak(record->next, record))
+            ;
+        return record;
+    }
+
+    // gives this thread's record, and gives it up when the thread finishes
+    struct EpochRecordHolder {
+        EpochRecord* record{takeEpochRecord()};
+        ~EpochRecordHolder() { record->inUse = false; }
+    };
+
+    class EpochGuard {
+        EpochRecord& record;
+    public:
+        EpochGuard()
+        :record(*[]{ thread_local EpochRecordHolder holder; return holder.record; }())
+        {
+            if (0 == record.depth++)
+                record.epoch.store(globalEpoch.load());
+        }
+        ~EpochGuard()
+        {
+            if (0 == --record.depth)
+                record.epoch.store(QUIESCENT, memory_order_release);
+        }
+    };
+
+    struct DesTable {
+        explicit DesTable(int size)
+        :size(size), slots(new atomic<socketInfoClass*>[size]) {
+            for (int des{0}; des < size; ++des)
+                slots[des].store(nullptr, memory_order_relaxed);
+        }
+        int size;
+        unique_ptr<atomic<socketInfoClass*>[]> slots;
+    };
+
+    atomic<DesTable*> desTable{new DesTable(256)};
+
+    // a table or object that has been unlinked, and the epoch after which nobody can reach it
+    struct Retired {
+        unsigned long long epoch;
+        socketInfoClass* info;
+        DesTable* table;
+    };
+    vector<Retired> retired;
+
+    //  A mutex so only a single thread can change desTable (or its slots) at a time.  This
+    //  means that only one call to functions like mySocketpair() or myClose() can make
+    //  progress at a time.  Threads only looking up descriptors do not use it.
+    mutex tableMutex;
+
+    // the object for des, or nullptr if des is not from mySocketpair().
+    //  Hold an EpochGuard (or tableMutex) while using the object.
+    socketInfoClass* findInfo(int des)
+    {
+        DesTable* table{desTable.load()};
+        if (des < 0 || des >= table->size)
+            return nullptr;
+        return table->slots[des].load();
+    }
+
+    void freeRetired(); // delete what no thread can be using.  Hold tableMutex.
+
+    // retire an unlinked object or table.  Hold tableMutex.
+    void retire(socketInfoClass* info, DesTable* table)
+    {
+        retired.push_back({globalEpoch.fetch_add(1) + 1, info, table});
+        freeRetired();
+    }
+
+    // set the slot for des.  Hold tableMutex.
+    void setInfo(int des, socketInfoClass* info)
+    {
+        DesTable* table{desTable.load()};
+        if (des >= table->size) {
+            auto bigger{new DesTable(max(2 * table->size, des + 1))};
+            for (int i{0}; i < table->size; ++i)
+                bigger->slots[i].store(table->slots[i].load(memory_order_relaxed), memory_order_relaxed);
+            desTable.store(bigger);
+            retire(nullptr, table);
+            table = bigger;
+        }
+        table->slots[des].store(info);
+    }
+
+    enum {STATS_OFF, STATS_ON, STATS_DUMP}; // see myStatsEnable()
+
+    // the statistics mode for descriptors made from now on, initially from $MYIO_STATS
+    atomic<int> statsMode{[] {
+        const char* value{getenv("MYIO_STATS")};
+        if (!value || !strcmp(value, "0"))
+            return STATS_OFF;
+        return strcmp(value, "dump") ? STATS_ON : STATS_DUMP;
+    }()};
+
+    /* The statistics for a descriptor (see struct myIOStats), made only when they are
+     *  on, so that otherwise keeping them costs a test of a null pointer.  Threads using
+     *  the descriptor and the one paired with it update them while holding different
+     *  mutexes, so the counters are atomic.
+     */
+    struct IOStats {
+        atomic<unsigned long long> bytesIn{0}, bytesOut{0}, reads{0}, writes{0}, drains{0};
+        atomic<unsigned long long> waits{0}, waitNsecs{0}, maxWaitNsecs{0}, drainStalls{0};
+        bool dumpAtClose{false};
+
+        void waited(steady_clock::time_point since)
+        {
+            unsigned long long nsecs = duration_cast<nanoseconds>(steady_clock::now() - since).count();
+            waits.fetch_add(1, memory_order_relaxed);
+            waitNsecs.fetch_add(nsecs, memory_order_relaxed);
+            unsigned long long max{maxWaitNsecs.load(memory_order_relaxed)};
+            while (nsecs > max && !maxWaitNsecs.compare_exchange_weak(max, nsecs, memory_order_relaxed))
+                ;
+        }
+
+        void copyTo(struct myIOStats* stats) const
+        {
+            stats->bytesIn = bytesIn.load(memory_order_relaxed);
+            stats->bytesOut = bytesOut.load(memory_order_relaxed);
+            stats->reads = reads.load(memory_order_relaxed);
+            stats->writes = writes.load(memory_order_relaxed);
+            stats->drains = drains.load(memory_order_relaxed);
+            stats->waits = waits.load(memory_order_relaxed);
+            stats->waitNsecs = waitNsecs.load(memory_order_relaxed);
+            stats->maxWaitNsecs = maxWaitNsecs.load(memory_order_relaxed);
+            stats->drainStalls = drainStalls.load(memory_order_relaxed);
+        }
+
+        void dump(int des) const
+        {
+            struct myIOStats s;
+            copyTo(&s);
+            CERR << "myIO statistics for descriptor " << des << ": "
+                 << s.bytesIn << " bytes in " << s.reads << " reads, "
+                 << s.bytesOut << " bytes out in " << s.writes << " writes, "
+                 << s.drains << " drains (" << s.drainStalls << " stalled), "
+                 << s.waits << " waits totalling " << s.waitNsecs / 1000 << " us (longest "
+                 << s.maxWaitNsecs / 1000 << " us)" << endl;
+        }
+    };
+
+#ifdef __linux__
+    /* A condition variable for the waits in socketInfoClass, where a Medium hop otherwise
+     *  costs a context switch for each wait and another for each notify.  A waiter spins
+     *  for a short while (on machines with more than one CPU) watching for a notify, and
+     *  only then parks on a futex.  notify_one() and notify_all() just bump a sequence
+     *  number, and make a system call only if a thread is parked.  The waiter reads seq
+     *  while holding the mutex, so a notify after that, by a thread holding the mutex or
+     *  not, is never lost: either the notifier sees parked, or the futex sees seq change.
+     *  Like condition_variable on Linux, wait() has no spurious wakeups except notifies.
+     *  A processShared FutexCond can be in memory shared between processes (myShmpair()).
+     */
+    class FutexCond {
+        atomic<uint32_t> seq{0};
+        atomic<int> parked{0};  // threads in (or about to be in) FUTEX_WAIT
+        unsigned spinLimit{SPIN_START}; // adapted to how often spinning works.  Under the mutex.
+        const int waitOp;
+        const int wakeOp;
+
+        static const unsigned SPIN_START{64};
+        static constexpr unsigned SPIN_MAX{4096};
+
+        static void pause()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        void notify(int count)
+        {
+            seq.fetch_add(1);
+            if (parked.load() > 0)
+                syscall(SYS_futex, &seq, wakeOp, count, nullptr, nullptr, 0);
+        }
+
+    public:
+        explicit FutexCond(bool processShared = false)
+        :waitOp(processShared ? FUTEX_WAIT_BITSET : FUTEX_WAIT_BITSET_PRIVATE),
+         wakeOp(processShared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE) {}
+
+        /*
+         * Function:  wait, as condition_variable::wait_until(), for a notify or the deadline.
+         * Return:    cv_status::timeout if the deadline passed without a notify.
+         */
+        template<class Lock>
+        cv_status wait_until(Lock &lk, steady_clock::time_point deadline)
+        {
+            static const bool multiCpu{thread::hardware_concurrency() > 1};
+            const uint32_t seen{seq.load()};
+            const unsigned spins{multiCpu ? spinLimit : 0};
+            lk.unlock();
+
+            unsigned spun{0};
+            while (spun < spins && seq.load(memory_order_acquire) == seen) {
+                pause();
+                ++spun;
+            }
+            bool notified{seq.load(memory_order_acquire) != seen};
+            if (!notified) {
+                // steady_clock is CLOCK_MONOTONIC, which FUTEX_WAIT_BITSET takes as an absolute time
+                struct timespec until;
+                const bool forever{steady_clock::time_point::max() == deadline};
+                if (!forever) {
+                    auto ns{duration_cast<nanoseconds>(deadline.time_since_epoch()).count()};
+                    until.tv_sec = ns / 1000000000;
+                    until.tv_nsec = ns % 1000000000;
+                }
+                const int savedErrno{errno};
+                parked.fetch_add(1);
+                while (!notified) {
+                    long rv{syscall(SYS_futex, &seq, waitOp, seen,
+                                    forever ? nullptr : &until, nullptr, FUTEX_BITSET_MATCH_ANY)};
+                    notified = seq.load(memory_order_acquire) != seen;
+                    if (-1 == rv && ETIMEDOUT == errno)
+                        break;
+                }
+                parked.fetch_sub(1);
+                errno = savedErrno;
+            }
+
+            lk.lock();
+            if (spins) { // spin longer where a notify usually comes while spinning
+                if (spun < spins && notified)
+                    spinLimit = std::min(2 * spinLimit, SPIN_MAX);
+                else if (spinLimit > 1)
+                    spinLimit /= 2;
+            }
+            return notified ? cv_status::no_timeout : cv_status::timeout;
+        }
+
+        template<class Lock>
+        void wait(Lock &lk)
+        {
+            wait_until(lk, steady_clock::time_point::max());
+        }
+
+        template<class Lock, class Predicate>
+        void wait(Lock &lk, Predicate pred)
+        {
+            while (!pred())
+                wait(lk);
+        }
+
+        void notify_one() { notify(1); }
+        void notify_all() { notify(INT_MAX); }
+    };
+#else
+    typedef condition_variable FutexCond;
+#endif
+
+    /*
+     * Function:  wait on cvRead, as readcond() does in QNX, for min bytes to be waiting
+     *            (or for 1 byte if min is 0), as waiting() tells, while open() says that
+     *            more can come.  time is an inter-character timer, restarted whenever
+     *            more data arrives and started once there is some data (or at once if
+     *            min is 0).  timeout limits the whole wait.  If both are 0, do not wait.
+     */
+    template<class Lock, class Cond, class Waiting, class Open>
+    void waitForMin(Lock &lk, Cond &cvRead, int min, int time, int timeout,
+                    Waiting waiting, Open open, IOStats* stats)
+    {
+        if (0 == time && 0 == timeout)
+            return;
+        const unsigned target = min ? min : 1;
+        const auto start{steady_clock::now()};
+        const auto never{steady_clock::time_point::max()};
+        auto lastArrival{start};
+        unsigned seen{waiting()};
+        const bool blocked{seen < target && open()};
+        while (waiting() < target && open()) {
+            auto deadline{timeout ? start + duration<int, deci>{timeout} : never};
+            if (time && (0 == min || seen > 0))
+                deadline = std::min(deadline, lastArrival + duration<int, deci>{time});
+            if (never == deadline)
+                cvRead.wait(lk);
+            else if (cv_status::timeout == cvRead.wait_until(lk, deadline))
+                break;
+            if (waiting() > seen) { // more data has arrived
+                seen = waiting();
+                lastArrival = steady_clock::now();
+            }
+        }
+        if (stats && blocked)
+            stats->waited(start);
+    }
+
+#ifdef __linux__
+    // this process, kept up to date across fork() (see afterForkChild())
+    atomic<pid_t> thisPid{getpid()};
+
+    // how often a process waiting on a myShmpair() link checks that its peer is still running
+    const nanoseconds PEER_CHECK{milliseconds(100)};
+
+    /*
+     * Function:  has process pid ended?  A child that has ended but not been waited for
+     *            (a zombie) has ended, which kill() alone would not tell.
+     */
+    bool processEnded(pid_t pid)
+    {
+        const int savedErrno{errno};
+        bool ended;
+#ifdef SYS_pidfd_open
+        int d = syscall(SYS_pidfd_open, pid, 0);
+        if (-1 != d) {
+            struct pollfd exited{d, POLLIN, 0};
+            ended = 1 == poll(&exited, 1, 0);
+            close(d);
+        }
+        else
+#endif
+            ended = -1 == kill(pid, 0) && ESRCH == errno;
+        errno = savedErrno;
+        return ended;
+    }
+
+    /* A mutex that can be in memory shared between processes, as in Drepper's
+     *  "Futexes Are Tricky".  state is 0 if unlocked, 1 if locked, and 2 if locked and
+     *  a thread might be waiting for it.  owner is the process holding it, once it has
+     *  stored its pid, so that a waiter can take over the mutex from a process that
+     *  ended while holding it, rather than wait forever.
+     */
+    class ShmMutex {
+        atomic<uint32_t> state{0};
+        atomic<pid_t> owner{0};
+    public:
+        void lock()
+        {
+            uint32_t c{0};
+            if (!state.compare_exchange_strong(c, 1)) {
+                const int savedErrno{errno};
+                if (2 != c)
+                    c = state.exchange(2);
+                while (0 != c) {
+                    struct timespec check{0, PEER_CHECK.count()};
+                    if (-1 == syscall(SYS_futex, &state, FUTEX_WAIT, 2, &check, nullptr, 0)
+                        && ETIMEDOUT == errno) {
+                        pid_t ended{owner.load()};
+                        if (ended && processEnded(ended) && owner.compare_exchange_strong(ended, thisPid))
+                            break; // state is still 2, now for this thread
+                    }
+                    c = state.exchange(2);
+                }
+                errno = savedErrno;
+            }
+            owner.store(thisPid);
+        }
+        void unlock()
+        {
+            owner.store(0);
+            if (1 != state.fetch_sub(1)) {
+                state.store(0);
+                const int savedErrno{errno};
+                syscall(SYS_futex, &state, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+                errno = savedErrno;
+            }
+        }
+    };
+
+    // the data written to one end of a myShmpair() link and waiting to be read at the other
+    struct ShmDir {
+        ShmMutex mutex;
+        FutexCond cvRead{true};
+        FutexCond cvDrain{true};
+        FutexCond cvSpace{true};     // a writer is waiting for room
+        unsigned head{0};            // the bytes ever read ...
+        unsigned tail{0};            // ... and written.  Byte i is at data[i % size].
+        unsigned maxTotalCanRead{0}; // as in socketInfoClass
+        unsigned drainers{0};
+        unsigned drainLowWater{0};
+        bool readable{false};        // the byte for select() has been written to the socket
+        bool writerClosed{false};    // no more data will come
+        bool readerClosed{false};    // no more data will be read
+        unsigned waiting() const { return tail - head; }
+    };
+
+    // the memory shared by the ends of a myShmpair() link, followed by the data of each ShmDir
+    struct ShmLink {
+        explicit ShmLink(unsigned size) :size(size)
+        {
+            holders[0][0] = holders[1][0] = thisPid.load();
+        }
+        static const int HOLDERS{8};
+        const unsigned size;        // of the data of each ShmDir, a power of two
+        atomic<int> opens[2]{1, 1}; // the processes holding each end ...
+        atomic<pid_t> holders[2][HOLDERS]{}; // ... and their pids, 0 for none
+        atomic<bool> untracked[2]{false, false}; // more processes held an end than HOLDERS
+        ShmDir dir[2];              // dir[end] is read at that end
+        char* data(int end) { return reinterpret_cast<char*>(this + 1) + (size_t) end * size; }
+
+        void addHolder(int end)
+        {
+            for (auto& holder: holders[end]) {
+                pid_t none{0};
+                if (holder.compare_exchange_strong(none, thisPid))
+                    return;
+            }
+            untracked[end] = true;
+        }
+
+        void removeHolder(int end)
+        {
+            for (auto& holder: holders[end]) {
+                pid_t me{thisPid};
+                if (holder.compare_exchange_strong(me, 0))
+                    return;
+            }
+        }
+
+        // has every process holding end ended, without closing it?
+        bool holdersEnded(int end)
+        {
+            if (untracked[end])
+                return false;
+            for (auto& holder: holders[end])
+                if (pid_t pid{holder.load()}; pid && !processEnded(pid))
+                    return false;
+            return true;
+        }
+    };
+
+    /* One end of a myShmpair() link, as seen by this process.  It works as socketInfoClass
+     *  does for myChannelpair() descriptors, but everything shared with the other end is in
+     *  the ShmLink, and the descriptor itself is only used for select() and poll().
+     */
+    class ShmEnd {
+        shared_ptr<ShmLink> link;   // unmapped once no end in this process uses it
+        const int end;
+
+        ShmDir& in() { return link->dir[end]; }
+        ShmDir& out() { return link->dir[1 - end]; }
+
+        /* A FutexCond of dir, waited on PEER_CHECK at a time.  If the process at the other
+         *  end has ended without closing it, the wait ends as if it had (see closing()).
+         *  Only dir, whose mutex is held, is marked closed: a waiter on the other ShmDir
+         *  finds out for itself.
+         */
+        class PeerWatch {
+            ShmEnd& shmEnd;
+            ShmDir& dir;
+            FutexCond& cv;
+        public:
+            PeerWatch(ShmEnd& shmEnd, ShmDir& dir, FutexCond& cv) :shmEnd(shmEnd), dir(dir), cv(cv) {}
+
+            template<class Lock>
+            cv_status wait_until(Lock &lk, steady_clock::time_point deadline)
+            {
+                const auto check{steady_clock::now() + PEER_CHECK};
+                if (deadline <= check)
+                    return cv.wait_until(lk, deadline);
+                if (cv_status::timeout == cv.wait_until(lk, check)
+                    && shmEnd.link->holdersEnded(1 - shmEnd.end)) {
+                    if (&dir == &shmEnd.in()) {
+                        dir.writerClosed = true;
+                        dir.cvRead.notify_all();
+                    }
+                    else {
+                        dir.readerClosed = true;
+                        dir.cvSpace.notify_all();
+                        dir.cvDrain.notify_all();
+                    }
+                }
+                return cv_status::no_timeout; // the caller checks again what it is waiting for
+            }
+
+            template<class Lock>
+            void wait(Lock &lk)
+            {
+                wait_until(lk, steady_clock::time_point::max());
+            }
+
+            template<class Lock, class Predicate>
+            void wait(Lock &lk, Predicate pred)
+            {
+                while (!pred())
+                    wait(lk);
+            }
+        };
+
+        // copy n bytes between buf and the data of dir[i], at the byte numbered pos
+        void copy(int i, unsigned pos, char* buf, unsigned n, bool toLink)
+        {
+            char* data{link->data(i)};
+            unsigned offset{pos & (link->size - 1)};
+            unsigned first{std::min(n, link->size - offset)};
+            if (toLink) {
+                memcpy(data + offset, buf, first);
+                memcpy(data, buf + first, n - first);
+            }
+            else {
+                memcpy(buf, data + offset, first);
+                memcpy(buf + first, data, n - first);
+            }
+        }
+
+        // take the bytes waiting in in() into the iovcnt buffers of iov.  Hold in().mutex.
+        int take(int des, const struct iovec* iov, int iovcnt)
+        {
+            ShmDir& dir{in()};
+            int bytesRead{0};
+            for (int i = 0; i < iovcnt && dir.waiting(); ++i) {
+                unsigned n = std::min((size_t) dir.waiting(), iov[i].iov_len);
+                copy(end, dir.head, (char *) iov[i].iov_base, n, false);
+                dir.head += n;
+                bytesRead += n;
+            }
+            if (bytesRead > 0) {
+                dir.cvSpace.notify_all();
+                if (dir.waiting() <= dir.maxTotalCanRead + dir.drainLowWater)
+                    dir.cvDrain.notify_all();
+            }
+            if (dir.readable && !dir.waiting()) {
+                char ready;
+                if (1 == read(des, &ready, 1))
+                    dir.readable = false;
+            }
+            return bytesRead;
+        }
+
+    public:
+        ShmEnd(shared_ptr<ShmLink> link, int end)
+        :link(move(link)), end(end) {}
+
+        // a child from fork() holds this end too
+        void forking() { link->opens[end].fetch_add(1); }
+        // ... and this is that child
+        void forked() { link->addHolder(end); }
+
+        // as socketInfoClass::reading()
+        int reading(int des, const struct iovec* iov, int iovcnt, int min, int time, int timeout, IOStats* stats)
+        {
+            ShmDir& dir{in()};
+            int n{0};
+            for (int i = 0; i < iovcnt; ++i)
+                n += iov[i].iov_len;
+            unique_lock lk(dir.mutex);
+
+            int bytesRead;
+            if (!dir.maxTotalCanRead && (dir.waiting() >= (unsigned) min || dir.writerClosed)
+                && (dir.waiting() > 0 || dir.writerClosed || (0 == time && 0 == timeout)))
+                bytesRead = take(des, iov, iovcnt);
+            else {
+                dir.maxTotalCanRead += n;
+                dir.cvDrain.notify_all(); // dir.waiting() must be less than min
+                PeerWatch cvRead(*this, dir, dir.cvRead);
+                waitForMin(lk, cvRead, min, time, timeout,
+                           [&dir] {return dir.waiting();}, [&dir] {return !dir.writerClosed;}, stats);
+                bytesRead = take(des, iov, iovcnt);
+                dir.maxTotalCanRead -= n;
+                if (dir.waiting() > 0 || dir.writerClosed)
+                    dir.cvRead.notify_one();
+            }
+            if (stats) {
+                stats->reads.fetch_add(1, memory_order_relaxed);
+                if (bytesRead > 0)
+                    stats->bytesIn.fetch_add(bytesRead, memory_order_relaxed);
+            }
+            return bytesRead;
+        }
+
+        // as socketInfoClass::writing(), waiting for room for all of the buffers
+        int writing(int des, const struct iovec* iov, int iovcnt, IOStats* stats)
+        {
+            ShmDir& dir{out()};
+            unique_lock lk(dir.mutex);
+
+            if (stats)
+                stats->writes.fetch_add(1, memory_order_relaxed);
+            size_t written{0};
+            size_t nbyte{0};
+            for (int i = 0; i < iovcnt; ++i)
+                nbyte += iov[i].iov_len;
+            int i{0};           // the buffer being written ...
+            size_t offset{0};   // ... and how much of it has been
+            while (true) {
+                if (dir.readerClosed) {
+                    if (written)
+                        break;
+                    errno = EPIPE;
+                    return -1;
+                }
+                while (i < iovcnt && offset == iov[i].iov_len) {
+                    ++i;
+                    offset = 0;
+                }
+                if (i < iovcnt) {
+                    unsigned chunk = std::min(iov[i].iov_len - offset, (size_t) (link->size - dir.waiting()));
+                    if (chunk) {
+                        copy(1 - end, dir.tail, (char *) iov[i].iov_base + offset, chunk, true);
+                        dir.tail += chunk;
+                        offset += chunk;
+                        written += chunk;
+                        dir.cvRead.notify_one();
+                        if (!dir.readable) {
+                            char ready{0};
+                            if (1 == send(des, &ready, 1, MSG_NOSIGNAL))
+                                dir.readable = true;
+                        }
+                    }
+                }
+                if (written == nbyte)
+                    break;
+                if (offset < iov[i].iov_len) { // out of room
+                    steady_clock::time_point since;
+                    if (stats)
+                        since = steady_clock::now();
+                    PeerWatch(*this, dir, dir.cvSpace).wait(lk,
+                        [this, &dir] {return dir.waiting() < link->size || dir.readerClosed;});
+                    if (stats)
+                        stats->waited(since);
+                }
+            }
+            if (stats)
+                stats->bytesOut.fetch_add(written, memory_order_relaxed);
+            return written;
+        }
+
+        // as socketInfoClass::draining()
+        int draining(unsigned lowWater, IOStats* stats)
+        {
+            ShmDir& dir{out()};
+            unique_lock lk(dir.mutex);
+
+            if (stats)
+                stats->drains.fetch_add(1, memory_order_relaxed);
+            if (!dir.readerClosed && dir.waiting() > dir.maxTotalCanRead + lowWater) {
+                steady_clock::time_point since;
+                if (stats)
+                    since = steady_clock::now();
+                if (0 == dir.drainers++ || lowWater > dir.drainLowWater)
+                    dir.drainLowWater = lowWater;
+                PeerWatch(*this, dir, dir.cvDrain).wait(lk, [&dir, lowWater]
+                    {return dir.readerClosed || dir.waiting() <= dir.maxTotalCanRead + lowWater;});
+                if (0 == --dir.drainers)
+                    dir.drainLowWater = 0;
+                if (stats) {
+                    stats->drainStalls.fetch_add(1, memory_order_relaxed);
+                    stats->waited(since);
+                }
+            }
+            return 0;
+        }
+
+        // as socketInfoClass::drained()
+        int drained(unsigned lowWater)
+        {
+            ShmDir& dir{out()};
+            lock_guard lk(dir.mutex);
+            return dir.readerClosed || dir.waiting() <= dir.maxTotalCanRead + lowWater;
+        }
+
+        // close des, and the end once no other process holds it
+        int closing(int des)
+        {
+            link->removeHolder(end);
+            if (1 == link->opens[end].fetch_sub(1)) {
+                {
+                    lock_guard lk(in().mutex);
+                    in().readerClosed = true;
+                    in().cvSpace.notify_all(); // a writer at the other end cannot wait for room any longer
+                    in().cvDrain.notify_all();
+                }
+                {
+                    lock_guard lk(out().mutex);
+                    out().writerClosed = true;
+                    out().cvRead.notify_all();
+                }
+            }
+            return close(des);
+        }
+    };
+#else
+    // myShmpair() needs futexes, so there are no ShmEnds
+    class ShmEnd {
+    public:
+        void forking() {}
+        void forked() {}
+        int reading(int, const struct iovec*, int, int, int, int, IOStats*) { errno = ENOSYS; return -1; }
+        int writing(int, const struct iovec*, int, IOStats*) { errno = ENOSYS; return -1; }
+        int draining(unsigned, IOStats*) { errno = ENOSYS; return -1; }
+        int drained(unsigned) { errno = ENOSYS; return -1; }
+        int closing(int des) { return close(des); }
+    };
+#endif
+
+    class socketInfoClass {
+        unsigned totalWritten{0};
+        unsigned maxTotalCanRead{0};
+        FutexCond cvDrain;
+        FutexCond cvRead;
+        unsigned drainers{0};       // threads waiting in draining() ...
+        unsigned drainLowWater{0};  // ... and the largest of their low-water marks
+        // for descriptors from myChannelpair(), the data written to the paired descriptor
+        //  waits here rather than in the socket, which then only holds a single byte while
+        //  there is data in circBuffer, so that select() and poll() still see des as readable.
+        unique_ptr<SpscRing<char>> circBuffer;
+        FutexCond cvSpace;          // a writer is waiting for room in circBuffer
+        bool pollable{false};       // keep the byte for select() in the socket
+        bool readable{false};       // the paired descriptor has written the byte for select()
+        int drainEventD{-1};            // a descriptor from myDrainNotifyD() to signal once the
+        unsigned drainEventLowWater{0}; //  data written by the paired descriptor is drained to here
+        int drainNotifyD{-1};           // the descriptor myDrainNotifyD() gives for des, if any
+        mutex socketInfoMutex;
+
+        /*
+         * Function:  signal drainEventD, if armed, once the data has been drained down to
+         *            drainEventLowWater bytes.  Hold socketInfoMutex.
+         */
+        void drainEvent()
+        {
+            if (-1 != drainEventD && (pair < 0 || totalWritten <= maxTotalCanRead + drainEventLowWater)) {
+                int errnoHold{errno};
+                uint64_t one{1};
+                (void) !write(drainEventD, &one, sizeof(one));
+                errno = errnoHold;
+                drainEventD = -1;
+            }
+        }
+
+        /*
+         * Function:  take bytes written to des into the iovcnt buffers of iov.  Hold socketInfoMutex.
+         * Return:    the number of bytes, or -1 (with errno set) for an error.
+         */
+        int take(int des, const struct iovec* iov, int iovcnt)
+        {
+            if (!circBuffer)
+                return readv(des, iov, iovcnt);
+            int bytesRead = 0;
+            for (int i = 0; i < iovcnt; ++i) {
+                unsigned got = circBuffer->read((char *) iov[i].iov_base, iov[i].iov_len);
+                bytesRead += got;
+                if (got < iov[i].iov_len)
+                    break;
+            }
+            if (bytesRead > 0)
+                cvSpace.notify_all();
+            if (readable && !circBuffer->num_readable()) {
+                char ready;
+                if (1 == read(des, &ready, 1))
+                    readable = false;
+            }
+            return bytesRead;
+        }
+
+    public:
+        atomic<int> pair;   // Cannot be private because myWrite and myTcdrain using it.
+                    // -1 when descriptor closed, -2 when paired descriptor is closed
+                    // atomic because myWrite and myTcdrain read it without socketInfoMutex
+
+        // statistics for des, or nullptr if they were off when it was made
+        unique_ptr<IOStats> stats;
+
+        // for descriptors from myShmpair(), which handles everything done with des
+        unique_ptr<ShmEnd> shmEnd;
+
+        // bufSize is the size of circBuffer, or 0 for data to go through the socket
+        socketInfoClass(unsigned pairInit, unsigned bufSize = 0, bool pollable = false)
+        :pollable(pollable), pair(pairInit) {
+            if (bufSize) {
+                circBuffer = make_unique<SpscRing<char>>();
+                circBuffer->reserve(bufSize);
+            }
+            if (int mode{statsMode.load(memory_order_relaxed)}) {
+                stats = make_unique<IOStats>();
+                stats->dumpAtClose = STATS_DUMP == mode;
+            }
+        }
+
+	/*
+	 * Function:  if necessary, make the calling thread wait for a reading thread to drain the
+	 *            data, until no more than lowWater bytes are left that no reader has asked for.
+	 *            desStats are the statistics of the draining descriptor, if any.
+	 */
+	int draining(unsigned lowWater = 0, IOStats* desStats = nullptr)
+	{ // operating on object for paired descriptor of original des
+		if (shmEnd)
+			return shmEnd->draining(lowWater, desStats);
+		unique_lock socketLk(socketInfoMutex);
+
+		if (desStats)
+			desStats->drains.fetch_add(1, memory_order_relaxed);
+		if (pair >= 0 && totalWritten > maxTotalCanRead + lowWater) {
+			steady_clock::time_point since;
+			if (desStats)
+				since = steady_clock::now();
+			// readers notify once the backlog is down to the largest low-water mark,
+			//  so a drainer with a smaller one may have to wait again
+			if (0 == drainers++ || lowWater > drainLowWater)
+				drainLowWater = lowWater;
+			cvDrain.wait(socketLk, [this, lowWater]
+				{return pair < 0 || totalWritten <= maxTotalCanRead + lowWater;});
+			if (0 == --drainers)
+				drainLowWater = 0;
+			if (desStats) {
+				desStats->drainStalls.fetch_add(1, memory_order_relaxed);
+				desStats->waited(since);
+			}
+		}
+
+//		if (pair == -2) { // shouldn't normally happen
+//			errno = EBADF; // check errno
+//			return -1;
+//		}
+		return 0;
+	}
+
+	/*
+	 * Function:  signal notifyD (see myDrainNotifyD()) once a reading thread has drained the
+	 *            data down to lowWater bytes, at once if it already has.
+	 */
+	void armDrainEvent(int notifyD, unsigned lowWater)
+	{ // operating on object for paired descriptor of original des
+		lock_guard socketLk(socketInfoMutex);
+		drainEventD = notifyD;
+		drainEventLowWater = lowWater;
+		drainEvent();
+	}
+
+	/*
+	 * Function:  the descriptor for myDrainNotifyD(), made the first time it is asked for
+	 */
+	int drainNotifier()
+	{
+		lock_guard socketLk(socketInfoMutex);
+#ifdef __linux__
+		if (-1 == drainNotifyD)
+			drainNotifyD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+		errno = ENOTSUP;
+#endif
+		return drainNotifyD;
+	}
+
+	/*
+	 * Function:  has a reading thread drained the data, down to lowWater bytes?  Never waits.
+	 */
+	int drained(unsigned lowWater = 0)
+	{ // operating on object for paired descriptor of original des
+		if (shmEnd)
+			return shmEnd->drained(lowWater);
+		lock_guard socketLk(socketInfoMutex);
+		return !(pair >= 0 && totalWritten > maxTotalCanRead + lowWater);
+	}
+
+	/*
+	 * Function:  write to des from the iovcnt buffers of iov.  desStats are the statistics
+	 *            of des, if any.
+	 */
+	int writing(int des, const struct iovec* iov, int iovcnt, IOStats* desStats = nullptr)	{
+		// operating on object for paired descriptor
+		if (shmEnd)
+		   return shmEnd->writing(des, iov, iovcnt, desStats);
+		unique_lock socketLk(socketInfoMutex);
+
+		if (desStats)
+		   desStats->writes.fetch_add(1, memory_order_relaxed);
+		if (!circBuffer) {
+		   int written = writev(des, iov, iovcnt);
+		   if (written > 0) {
+		      totalWritten += written;
+		      cvRead.notify_one();
+		      if (desStats)
+		         desStats->bytesOut.fetch_add(written, memory_order_relaxed);
+		   }
+		   return written;
+		}
+
+		// like a blocking write() to a socket, wait for room for all of the buffers
+		size_t written{0};
+		size_t nbyte{0};
+		for (int i = 0; i < iovcnt; ++i)
+		   nbyte += iov[i].iov_len;
+		int i{0};			// the buffer being written ...
+		size_t offset{0};	// ... and how much of it has been
+		while (true) {
+		   if (pair < 0) { // paired descriptor (the reader) has been closed
+		      if (written)
+		         break;
+		      errno = EPIPE;
+		      return -1;
+		   }
+		   while (i < iovcnt && offset == iov[i].iov_len) {
+		      ++i;
+		      offset = 0;
+		   }
+		   unsigned chunk = (i < iovcnt) ? circBuffer->write((const char*) iov[i].iov_base + offset, iov[i].iov_len - offset) : 0;
+		   offset += chunk;
+		   if (chunk) {
+		      written += chunk;
+		      totalWritten += chunk;
+		      cvRead.notify_one();
+		      if (pollable && !readable) {
+		         char ready{0};
+		         if (1 == write(des, &ready, 1))
+		            readable = true;
+		      }
+		   }
+		   if (written == nbyte)
+		      break;
+		   if (offset < iov[i].iov_len) { // out of room
+		      steady_clock::time_point since;
+		      if (desStats)
+		         since = steady_clock::now();
+		      cvSpace.wait(socketLk, [this] {return circBuffer->num_writable() > 0 || pair < 0;});
+		      if (desStats)
+		         desStats->waited(since);
+		   }
+		}
+		if (desStats)
+		   desStats->bytesOut.fetch_add(written, memory_order_relaxed);
+		return written;
+	}
+
+	int reading(int des, const struct iovec* iov, int iovcnt, int min, int time, int timeout)
+	{ // it is assumed that des is for a socket in a socketpair created by mySocketpair
+		if (shmEnd)
+			return shmEnd->reading(des, iov, iovcnt, min, time, timeout, stats.get());
+		int bytesRead;
+		int n{0};
+		for (int i = 0; i < iovcnt; ++i)
+		   n += iov[i].iov_len;
+		unique_lock socketLk(socketInfoMutex);
+
+		// would not have got this far if pair == -1
+      if (-2 == pair)
+         bytesRead = 0; // this avoids errno == 104 (Connection Reset by Peer)
+      else if (!maxTotalCanRead && totalWritten >= (unsigned) min
+               && (totalWritten > 0 || (0 == time && 0 == timeout))) { // min 0 with a timer waits for a byte
+         if (0 == min && 0 == totalWritten)
+             bytesRead = 0;
+         else {
+		        bytesRead = take(des, iov, iovcnt); // at least min will be waiting
+		        if (bytesRead > 0) {
+		           totalWritten -= bytesRead;
+		           if (totalWritten <= maxTotalCanRead + drainLowWater) {
+		              int errnoHold{errno};
+                    cvDrain.notify_all();
+                    errno = errnoHold;
+		           }
+		           drainEvent();
+		        }
+		    }
+		}
+		else {
+			maxTotalCanRead += n;
+         int errnoHold{errno};
+         cvDrain.notify_all(); // totalWritten must be less than min
+         drainEvent();
+         waitForMin(socketLk, cvRead, min, time, timeout,
+                    [this] {return totalWritten;}, [this] {return pair >= 0;}, stats.get());
+
+         errno = errnoHold;
+//			if (pair == -1) { // shouldn't normally happen
+//			   errno = EBADF; // check errno value
+//			   return -1;
+//			}
+			// choice below could affect "Connection reset by peer" from read/wcsReadcond
+         if (totalWritten > 0)
+             bytesRead = take(des, iov, iovcnt);
+         else
+             bytesRead = 0;
+//			bytesRead = wcsReadcond(des, buf, n, 0, 0, 0);
+
+			if (-1 != bytesRead)
+            totalWritten -= bytesRead;
+			else
+			   if (ECONNRESET == errno)
+			      bytesRead = 0;
+            
+			maxTotalCanRead -= n;
+			if (0 < totalWritten || -2 == pair) {
+            int errnoHold{errno}; // debug gui not updating errnoHold very well.
+            cvRead.notify_one();
+            errno = errnoHold;
+         }
+		}
+		if (stats) {
+			stats->reads.fetch_add(1, memory_order_relaxed);
+			if (bytesRead > 0)
+				stats->bytesIn.fetch_add(bytesRead, memory_order_relaxed);
+		}
+		return bytesRead;
+	} // .reading()
+
+	/*
+	 * Function:  Closing des. Should be done only after all other operations on des have returned.
+	 */
+	int closing(int des)
+	{
+		if (shmEnd)
+			return shmEnd->closing(des);
+		// tableMutex already locked at this point, so no other myClose (or mySocketpair)
+		if(pair != -2) { // pair has not already been closed
+			socketInfoClass* des_pair{findInfo(pair)};
+			// See Williams 2e, 2nd half of section 3.2.4
+			scoped_lock guard(socketInfoMutex, des_pair->socketInfoMutex); // safely lock both mutexes
+			pair = -1; // this is first socket in the pair to be closed
+			des_pair->pair = -2; // paired socket will be the second of the two to close.
+			drainEvent(); // the paired descriptor need not wait for its data to be drained
+			des_pair->drainEventD = -1; // drainNotifyD is closed below
+			cvSpace.notify_all(); // a writer on the paired descriptor cannot wait for room any longer
+         if (totalWritten > maxTotalCanRead) {
+             // by closing the socket we are throwing away any buffered data.
+             // notification will be sent immediately below to any myTcdrain waiters on paired descriptor.
+             cvDrain.notify_all();
+         }
+//         if (maxTotalCanRead > 0) {
+//             // there shouldn't be any threads waiting in myRead() or myReadcond() on des, but just in case.
+//             cvRead.notify_all();
+//         }
+
+			if (des_pair->maxTotalCanRead > 0) {
+				// no more data will be written from des
+				// notify a thread waiting on reading on paired descriptor
+				des_pair->cvRead.notify_one();
+			}
+//			if (des_pair->totalWritten > des_pair->maxTotalCanRead) {
+//				// there shouldn't be any threads waiting in myTcdrain on des, but just in case.
+//				des_pair->cvDrain.notify_all();
+//			}
+		}
+		if (-1 != drainNotifyD)
+			close(drainNotifyD);
+		return close (des);
+	} // .closing()
+	}; // socketInfoClass
+
+    // the object to write to des and drain it through: the one for the descriptor paired with
+    //  des (or for des itself, from myShmpair()), or nullptr if that has been closed.
+    //  Hold an EpochGuard.
+    socketInfoClass* findPair(socketInfoClass* desInfoP, int des)
+    {
+        if (desInfoP->shmEnd)
+            return desInfoP; // which writes and drains through the ShmLink
+        int pair{desInfoP->pair};
+        if (pair < 0)
+            return nullptr;
+        auto desPairInfoP{findInfo(pair)};
+        // the paired descriptor might have been closed and its number reused since
+        if (desPairInfoP && desPairInfoP->pair != des)
+            return nullptr;
+        return desPairInfoP;
+    }
+
+    void freeRetired()
+    {
+        // the oldest epoch a thread might still be using a retired object from
+        unsigned long long oldest{QUIESCENT};
+        for (EpochRecord* record{epochRecords.load()}; record; record = record->next)
+            oldest = min(oldest, record->epoch.load());
+        size_t kept{0};
+        for (auto& item: retired) {
+            if (item.epoch <= oldest) {
+                delete item.info;
+                delete item.table;
+            }
+            else
+                retired[kept++] = item;
+        }
+        retired.resize(kept);
+    }
+
+    // a child from fork() holds the myShmpair() ends of its parent too.  tableMutex is held
+    //  over the fork, so the table is not being changed when it is copied.
+    void prepareFork()
+    {
+        tableMutex.lock();
+        DesTable* table{desTable.load()};
+        for (int des{0}; des < table->size; ++des)
+            if (socketInfoClass* info{table->slots[des].load()}; info && info->shmEnd)
+                info->shmEnd->forking();
+    }
+
+    void afterFork()
+    {
+        tableMutex.unlock();
+    }
+
+    // and registers its pid as holding them
+    void afterForkChild()
+    {
+#ifdef __linux__
+        thisPid = getpid();
+#endif
+        DesTable* table{desTable.load()};
+        for (int des{0}; des < table->size; ++des)
+            if (socketInfoClass* info{table->slots[des].load()}; info && info->shmEnd)
+                info->shmEnd->forked();
+        tableMutex.unlock();
+    }
+} // unnamed namespace
+
+/*
+ * Function:	Calling the reading member function to read
+ * Return:		An integer with number of bytes read, or -1 for an error.
+ * see https://www.qnx.com/developers/docs/7.1/#com.qnx.doc.neutrino.lib_ref/topic/r/readcond.html
+ *
+ */
+int myReadcond(int des, void * buf, int n, int min, int time, int timeout) {
+   EpochGuard guard;
+   auto desInfoP{findInfo(des)};
+   struct iovec iov{buf, (size_t) n};
+   if (desInfoP)
+	    return desInfoP->reading(des, &iov, 1, min, time, timeout);
+    return wcsReadcond(des, buf, n, min, time, timeout);
+}
+
+/*
+ * Function:	Reading directly from a file or from a socketpair descriptor)
+ * Return:		the number of bytes read , or -1 for an error
+ */
+ssize_t myRead(int des, void* buf, size_t nbyte) {
+   EpochGuard guard;
+   auto desInfoP{findInfo(des)};
+   struct iovec iov{buf, nbyte};
+	if (desInfoP)
+	    // myRead (for sockets) usually reads a minimum of 1 byte
+	    return desInfoP->reading(des, &iov, 1, 1, 0, 0);
+	return read(des, buf, nbyte); // des is closed or not from a socketpair
+}
+
+/*
+ * Function:	Reading into iovcnt buffers, as myRead() does into one
+ * Return:		the number of bytes read , or -1 for an error
+ */
+ssize_t myReadv(int des, const struct iovec* iov, int iovcnt) {
+   EpochGuard guard;
+   auto desInfoP{findInfo(des)};
+	if (desInfoP)
+	    return desInfoP->reading(des, iov, iovcnt, 1, 0, 0);
+	return readv(des, iov, iovcnt); // des is closed or not from a socketpair
+}
+
+/*
+ * Function:	Reading whatever has arrived, up to nbyte, without waiting
+ * Return:		the number of bytes read (0 if none have arrived), or -1 for an error
+ */
+ssize_t myReadAvailable(int des, void* buf, size_t nbyte) {
+   {
+      EpochGuard guard;
+      auto desInfoP{findInfo(des)};
+      struct iovec iov{buf, nbyte};
+      if (desInfoP)
+         return desInfoP->reading(des, &iov, 1, 0, 0, 0);
+   }
+   struct pollfd pfd{des, POLLIN, 0};
+   int ready{poll(&pfd, 1, 0)};
+   if (ready <= 0)
+      return ready; // nothing has arrived, or an error
+   if (pfd.revents & POLLNVAL) {
+      errno = EBADF;
+      return -1;
+   }
+   return read(des, buf, nbyte);
+}
+
+/*
+ * Return:		the number of bytes written, or -1 for an error
+ */
+ssize_t myWrite(int des, const void* buf, size_t nbyte) {
+    {
+        EpochGuard guard;
+        auto desInfoP{findInfo(des)};
+        if (desInfoP) {
+           auto desPairInfoP{findPair(desInfoP, des)};
+           struct iovec iov{(void*) buf, nbyte};
+           if (desPairInfoP)
+              return desPairInfoP->writing(des, &iov, 1, desInfoP->stats.get());
+        }
+    }
+    return write(des, buf, nbyte); // des is not from a pair of sockets or socket or pair closed
+}
+
+/*
+ * Function:	Writing from iovcnt buffers, as myWrite() does from one
+ * Return:		the number of bytes written, or -1 for an error
+ */
+ssize_t myWritev(int des, const struct iovec* iov, int iovcnt) {
+    {
+        EpochGuard guard;
+        auto desInfoP{findInfo(des)};
+        if (desInfoP) {
+           auto desPairInfoP{findPair(desInfoP, des)};
+           if (desPairInfoP)
+              return desPairInfoP->writing(des, iov, iovcnt, desInfoP->stats.get());
+        }
+    }
+    return writev(des, iov, iovcnt); // des is not from a pair of sockets or socket or pair closed
+}
+
+/*
+ * Function:  make the calling thread wait for a reading thread to drain the data, down to
+ *            lowWater bytes.  Other descriptors are drained completely.
+ */
+int myTcdrainTo(int des, unsigned lowWater) {
+    {
+        EpochGuard guard;
+        auto desInfoP{findInfo(des)};
+        if (desInfoP) {
+           auto desPairInfoP{findPair(desInfoP, des)};
+           if (!desPairInfoP)
+              return 0; // paired descriptor is closed.
+           else
+              return desPairInfoP->draining(lowWater, desInfoP->stats.get());
+        }
+    }
+    return tcdrain(des); // des is not from a pair of sockets or socket closed
+}
+
+/*
+ * Function:  make the calling thread wait for a reading thread to drain the data
+ */
+int myTcdrain(int des) {
+    return myTcdrainTo(des, 0);
+}
+
+/*
+ * Function:  check, without waiting, whether a reading thread has drained the data down to
+ *            lowWater bytes
+ */
+int myDrainedTo(int des, unsigned lowWater) {
+    {
+        EpochGuard guard;
+        auto desInfoP{findInfo(des)};
+        if (desInfoP) {
+           auto desPairInfoP{findPair(desInfoP, des)};
+           if (!desPairInfoP)
+              return 1; // paired descriptor is closed.
+           else
+              return desPairInfoP->drained(lowWater);
+        }
+    }
+    int queued; // des is not from a pair of sockets or socket closed
+    if (-1 == ioctl(des, TIOCOUTQ, &queued))
+        return (ENOTTY == errno) ? 1 : -1; // nothing to drain for regular files
+    return (unsigned) queued <= lowWater;
+}
+
+/*
+ * Function:  a descriptor that becomes readable once a reading thread has drained the data
+ *            down to lowWater bytes
+ */
+int myDrainNotifyD(int des, unsigned lowWater) {
+    EpochGuard guard;
+    auto desInfoP{findInfo(des)};
+    if (!desInfoP || desInfoP->shmEnd) {
+        errno = ENOTSUP; // the other process would have to signal it
+        return -1;
+    }
+    int notifyD{desInfoP->drainNotifier()};
+    if (-1 == notifyD)
+        return -1;
+    int errnoHold{errno};
+    uint64_t count;
+    (void) !read(notifyD, &count, sizeof(count)); // forget an earlier drain
+    errno = errnoHold;
+    auto desPairInfoP{findPair(desInfoP, des)};
+    if (desPairInfoP)
+        desPairInfoP->armDrainEvent(notifyD, lowWater);
+    else {
+        count = 1; // paired descriptor is closed.
+        (void) !write(notifyD, &count, sizeof(count));
+    }
+    return notifyD;
+}
+
+/*
+ * Function:  check, without waiting, whether a reading thread has drained the data
+ */
+int myDrained(int des) {
+    return myDrainedTo(des, 0);
+}
+
+/*
+ * Function:   Create pair of sockets and put them in desTable
+ * Return:     return an integer that indicate if it is successful (0) or not (-1)
+ */
+int mySocketpair(int domain, int type, int protocol, int des[2]) {
+   int returnVal{socketpair(domain, type, protocol, des)};
+   if(-1 != returnVal) {
+      lock_guard tableLk(tableMutex);
+      setInfo(des[0], new socketInfoClass(des[1]));
+      setInfo(des[1], new socketInfoClass(des[0]));
+   }
+   return returnVal;
+}
+
+/*
+ * Function:   Create a pair of descriptors like mySocketpair(AF_LOCAL, SOCK_STREAM, 0, des),
+ *             but with the data for each passed through an in-process buffer of at least bufSize bytes
+ * Return:     return an integer that indicate if it is successful (0) or not (-1)
+ */
+int myChannelpair(int des[2], unsigned bufSize, bool pollable) {
+   if (!bufSize) {
+      errno = EINVAL;
+      return -1;
+   }
+   int returnVal{socketpair(AF_LOCAL, SOCK_STREAM, 0, des)};
+   if(-1 != returnVal) {
+      lock_guard tableLk(tableMutex);
+      setInfo(des[0], new socketInfoClass(des[1], bufSize, pollable));
+      setInfo(des[1], new socketInfoClass(des[0], bufSize, pollable));
+   }
+   return returnVal;
+}
+
+/*
+ * Function:   Create a pair of descriptors like myChannelpair(des, bufSize), but with the
+ *             buffers in memory shared with the child processes made by fork() afterwards
+ * Return:     return an integer that indicate if it is successful (0) or not (-1)
+ */
+int myShmpair(int des[2], unsigned bufSize) {
+#ifdef __linux__
+   if (!bufSize || bufSize > (1u << 31)) {
+      errno = EINVAL;
+      return -1;
+   }
+   unsigned size{1};
+   while (size < bufSize)
+      size <<= 1;
+   const size_t length{sizeof(ShmLink) + 2 * (size_t) size};
+   thisPid = getpid(); // in case this process was forked before the fork handlers were set
+   int memD{memfd_create("myShmpair", MFD_CLOEXEC)};
+   if (-1 == memD)
+      return -1;
+   void* mem{MAP_FAILED};
+   if (0 == ftruncate(memD, length))
+      mem = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, memD, 0);
+   int errnoHold{errno};
+   close(memD); // the mapping keeps the memory
+   if (MAP_FAILED == mem) {
+      errno = errnoHold;
+      return -1;
+   }
+   if (-1 == socketpair(AF_LOCAL, SOCK_STREAM, 0, des)) {
+      errnoHold = errno;
+      munmap(mem, length);
+      errno = errnoHold;
+      return -1;
+   }
+   shared_ptr<ShmLink> link(new (mem) ShmLink(size), [length](ShmLink* link) {munmap(link, length);});
+
+   static once_flag forkHandlers;
+   call_once(forkHandlers, [] {pthread_atfork(prepareFork, afterFork, afterForkChild);});
+
+   lock_guard tableLk(tableMutex);
+   for (int end{0}; end < 2; ++end) {
+      auto info{new socketInfoClass(des[1 - end])};
+      info->shmEnd = make_unique<ShmEnd>(link, end);
+      setInfo(des[end], info);
+   }
+   return 0;
+#else
+   errno = ENOSYS;
+   return -1;
+#endif
+}
+
+/*
+ * Function:   close des
+ *       myClose() should not be called until all other calls using the descriptor have finished.
+ */
+int myClose(int des) {
+   {
+        lock_guard tableLk(tableMutex);
+        auto desInfoP{findInfo(des)};
+        if (desInfoP) { // if in the table
+            // unlink first, as the number can be reused as soon as des is closed
+            setInfo(des, nullptr);
+            if (desInfoP->stats && desInfoP->stats->dumpAtClose)
+                desInfoP->stats->dump(des);
+            int returnVal{desInfoP->closing(des)};
+            retire(desInfoP, nullptr);
+            return returnVal;
+        }
+   }
+   return close(des);
+}
+
+/*
+ * Function:   Turn statistics on or off for the descriptors made from now on
+ */
+void myStatsEnable(bool collect, bool dumpAtClose)
+{
+   statsMode = !collect ? STATS_OFF : dumpAtClose ? STATS_DUMP : STATS_ON;
+}
+
+/*
+ * Function:   Copy the statistics for des
+ * Return:     0, or -1 with errno set to EBADF if des is not from mySocketpair() or
+ *             myChannelpair(), or ENODATA if it was made with statistics off.
+ */
+int myStats(int des, struct myIOStats* stats)
+{
+   EpochGuard guard;
+   auto desInfoP{findInfo(des)};
+   if (!desInfoP) {
+      errno = EBADF;
+      return -1;
+   }
+   if (!desInfoP->stats) {
+      errno = ENODATA;
+      return -1;
+   }
+   desInfoP->stats->copyTo(stats);
+   return 0;
+}
+
+/*
+ * Function:	Open a file and get its file descriptor.
+ * Return:		return value of open
+ */
+int myOpen(const char *pathname, int flags, ...) //, mode_t mode)
+{
+   mode_t mode{0};
+   // in theory we should check here whether mode is needed.
+   va_list arg;
+   va_start (arg, flags);
+   mode = va_arg (arg, mode_t);
+   va_end (arg);
+   return open(pathname, flags, mode);
+}
+
+/*
+ * Function:	Create a new file and get its file descriptor.
+ * Return:		return value of creat
+ */
+int myCreat(const char *pathname, mode_t mode)
+{
+   return creat(pathname, mode);
+}
+
+namespace {
+    const struct { unsigned baud; speed_t speed; } speeds[] {
+        {50, B50}, {75, B75}, {110, B110}, {134, B134}, {150, B150}, {200, B200},
+        {300, B300}, {600, B600}, {1200, B1200}, {1800, B1800}, {2400, B2400},
+        {4800, B4800}, {9600, B9600}, {19200, B19200}, {38400, B38400},
+        {57600, B57600}, {115200, B115200}, {230400, B230400},
+#ifdef B460800
+        {460800, B460800}, {921600, B921600},
+#endif
+    };
+}
+
+/*
+ * Function:	Put a terminal device in raw mode, 8 data bits, no parity and 1 stop bit,
+ *				at baud bits per second and with the flow control asked for.
+ * Return:		0, or -1 with errno set (EINVAL if there is no such baud rate)
+ */
+int mySerialConfig(int des, unsigned baud, int flow)
+{
+   speed_t speed{B0};
+   for (auto& entry : speeds)
+      if (entry.baud == baud)
+         speed = entry.speed;
+   if (B0 == speed || flow < MY_FLOW_NONE || flow > MY_FLOW_XONXOFF) {
+      errno = EINVAL;
+      return -1;
+   }
+   struct termios termio;
+   if (-1 == tcgetattr(des, &termio))
+      return -1;
+   cfmakeraw(&termio);
+   termio.c_cflag |= CLOCAL | CREAD;
+   termio.c_cflag &= ~(CSTOPB | CRTSCTS);
+   termio.c_iflag &= ~(IXON | IXOFF | IXANY);
+   if (MY_FLOW_RTSCTS == flow)
+      termio.c_cflag |= CRTSCTS;
+   else if (MY_FLOW_XONXOFF == flow)
+      termio.c_iflag |= IXON | IXOFF;
+   termio.c_cc[VMIN] = 1;    // a read() waits for at least one byte ...
+   termio.c_cc[VTIME] = 0;   // ... for as long as it takes
+   if (-1 == cfsetispeed(&termio, speed) || -1 == cfsetospeed(&termio, speed))
+      return -1;
+   // TCSAFLUSH: nothing sent or received at the old settings is left around
+   return tcsetattr(des, TCSAFLUSH, &termio);
+}
+
+/*
+ * Function:	Open a serial device, without it becoming the controlling terminal, and
+ *				configure it with mySerialConfig().
+ * Return:		the file descriptor, or -1 with errno set
+ */
+int myOpenSerial(const char *pathname, unsigned baud, int flow)
+{
+   int des{open(pathname, O_RDWR | O_NOCTTY | O_CLOEXEC)};
+   if (-1 != des && -1 == mySerialConfig(des, baud, flow)) {
+      int savedErrno{errno};
+      close(des);
+      errno = savedErrno;
+      des = -1;
+   }
+   return des;
+}
+
+
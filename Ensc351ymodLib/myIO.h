@@ -1,34 +1,100 @@
-#ifndef MYSOCKET_H_
-#define MYSOCKET_H_
-
-#include <unistd.h> 	// for size_t
-#include <sys/stat.h>	// for mode_t
-
-int myOpen(const char *pathname, int flags, ...) //, mode_t mode)
-;
-
-int myCreat(const char *pathname, mode_t mode);
-int mySocketpair( int domain, int type, int protocol, int des_array[2] );
-ssize_t myRead( int des, void* buf, size_t nbyte );
-ssize_t myWrite( int des, const void* buf, size_t nbyte );
-int myClose(int des);
-
-// The last two are not ordinarily used with sockets
-int myTcdrain(int des); //is also included for purposes of the course.
-
-/* Arguments:
-des
-    The file descriptor associated with the terminal device that you want to read from.
-buf
-    A pointer to a buffer into which readcond() can put the data.
-n
-    The maximum number of bytes to read.
-min, time, timeout
-    When used in RAW mode, these arguments override the behavior of the MIN and TIME members of the terminal's termios structure. For more information, see...
- *
-   https://www.qnx.com/developers/docs/7.1/#com.qnx.doc.neutrino.lib_ref/topic/r/readcond.html
- *
- *  */
-int myReadcond(int des, void * buf, int n, int min, int time, int timeout);
-
-#endif /*MYSOCKET_H_*/
+#ifndef MYSOCKET_H_
+#define MYSOCKET_H_
+
+#include <unistd.h> 	// for size_t
+#include <sys/stat.h>	// for mode_t
+#include <sys/uio.h>	// for struct iovec
+
+int myOpen(const char *pathname, int flags, ...) //, mode_t mode)
+;
+
+int myCreat(const char *pathname, mode_t mode);
+
+// flow control for mySerialConfig() and myOpenSerial()
+enum { MY_FLOW_NONE, MY_FLOW_RTSCTS, MY_FLOW_XONXOFF };
+// Put the terminal device des (a serial port, or the slave side of a pty) in raw mode,
+//  8N1, at baud bits per second.  RTS/CTS needs the hardware lines (a pty ignores it).
+//  XON/XOFF takes the DC1 and DC3 bytes out of the data, so YMODEM blocks can only be
+//  sent that way over a link that escapes them.  Returns 0, or -1 with errno set.
+int mySerialConfig(int des, unsigned baud, int flow);
+// open pathname (e.g. "/dev/ttyS0") for reading and writing and mySerialConfig() it
+int myOpenSerial(const char *pathname, unsigned baud, int flow);
+int mySocketpair( int domain, int type, int protocol, int des_array[2] );
+// Like mySocketpair(AF_LOCAL, SOCK_STREAM, 0, des_array), but the data written to each
+//  descriptor is buffered in-process (bufSize bytes, rounded up to a power of two) instead
+//  of by the kernel.  If pollable, the descriptors can still be given to select() and
+//  poll(), at the cost of a one-byte write() and read() each time the buffer goes from
+//  empty to not empty.  If not, only the my...() functions know when there is data, and
+//  writes need no system calls.
+int myChannelpair( int des_array[2], unsigned bufSize, bool pollable = true );
+// Like myChannelpair(des_array, bufSize), but the buffers are in memory shared with the child
+//  processes made by fork() afterwards, so each descriptor can be used from a different
+//  process (Linux only).  A descriptor is closed for the other once every process holding
+//  it has called myClose() on it, so a process should myClose() the ones it does not use.
+//  Once every process holding one descriptor has ended without closing it, a wait at the
+//  other (for data, room or a drain) ends within about 100 ms, as if it had been closed.
+int myShmpair( int des_array[2], unsigned bufSize );
+ssize_t myRead( int des, void* buf, size_t nbyte );
+ssize_t myWrite( int des, const void* buf, size_t nbyte );
+// like readv() and writev(), but for socketpairs keeping track of the data for myTcdrain().
+//  On a pair, myReadv() does not wait for data, just as myRead() does not.
+ssize_t myReadv( int des, const struct iovec* iov, int iovcnt );
+ssize_t myWritev( int des, const struct iovec* iov, int iovcnt );
+// read whatever has arrived, up to nbyte bytes, without waiting.  Returns 0 if nothing has.
+ssize_t myReadAvailable( int des, void* buf, size_t nbyte );
+int myClose(int des);
+
+// The last two are not ordinarily used with sockets
+int myTcdrain(int des); //is also included for purposes of the course.
+
+/* Arguments:
+des
+    The file descriptor associated with the terminal device that you want to read from.
+buf
+    A pointer to a buffer into which readcond() can put the data.
+n
+    The maximum number of bytes to read.
+min, time, timeout
+    When used in RAW mode, these arguments override the behavior of the MIN and TIME members of the terminal's termios structure. For more information, see...
+ *
+   https://www.qnx.com/developers/docs/7.1/#com.qnx.doc.neutrino.lib_ref/topic/r/readcond.html
+ *
+ *  */
+int myReadcond(int des, void * buf, int n, int min, int time, int timeout);
+
+// like myTcdrain() but without waiting.  Returns 1 if des has been drained, 0 if not, or -1 for an error.
+int myDrained(int des);
+
+// like myTcdrain() and myDrained(), but des counts as drained once no more than lowWater
+//  bytes written to it are still waiting to be read, so a writer can keep the pipe from
+//  running empty.  A lowWater of 0 is myTcdrain() and myDrained().
+int myTcdrainTo(int des, unsigned lowWater);
+int myDrainedTo(int des, unsigned lowWater);
+// A descriptor for poll() or select() to wait on until myDrainedTo(des, lowWater) would return 1.
+//  Each call forgets any earlier drain and waits for the next, and the descriptor stays des's
+//  until des is closed.  Returns -1 with errno ENOTSUP unless des is from mySocketpair() or
+//  myChannelpair().
+int myDrainNotifyD(int des, unsigned lowWater);
+
+// I/O statistics for a descriptor from mySocketpair() or myChannelpair()
+struct myIOStats {
+    unsigned long long bytesIn;     // bytes read from the descriptor ...
+    unsigned long long bytesOut;    // ... and written to it
+    unsigned long long reads;       // calls reading from it (myRead(), myReadcond(), ...)
+    unsigned long long writes;      // calls writing to it
+    unsigned long long drains;      // calls draining it (myTcdrain(), myTcdrainTo())
+    unsigned long long waits;       // calls that had to wait, for data, room or a drain
+    unsigned long long waitNsecs;   // the total time waited, in nanoseconds ...
+    unsigned long long maxWaitNsecs;// ... and the longest wait
+    unsigned long long drainStalls; // drains that had to wait (included in waits)
+};
+
+// Keep statistics (or not) for the descriptors made from now on, and if dumpAtClose,
+//  write them to stderr as each is closed.  Initially off, unless the environment variable
+//  MYIO_STATS is 1 (keep them) or "dump" (and write them at myClose()).
+void myStatsEnable(bool collect, bool dumpAtClose = false);
+// copy the statistics for des into *stats.  Returns 0, or -1 with errno set to EBADF if
+//  des is not from mySocketpair() or myChannelpair(), or ENODATA if it has no statistics.
+int myStats(int des, struct myIOStats* stats);
+
+#endif /*MYSOCKET_H_*/
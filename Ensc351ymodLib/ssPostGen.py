@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# Finish the code SmartState Studio generates from ySender.smc and yReceiver.smc.
+#
+# The generator names states with strings, which the tuned ss_api.hxx no longer
+# wants at run time.  After regenerating from a model, run
+#
+#     ./ssPostGen.py ySenderSS yReceiverSS
+#
+# in this directory to redo, in <name>.h and <name>.cpp, the edits below.  Each
+# edit is skipped where it has already been made, so running it again does not
+# change the files.
+#  - an enum of state numbers, in the order the constructors build the states,
+#    and a check in the StateMgr constructor that the states got those numbers
+#  - transitions by state number rather than by name
+#  - binary trace points (SS_TRACE) rather than debugLog() text
+#  - states stored in the StateMgr's arena (new (mgr)), and named by the
+#    literal the generated code gives rather than by a copy of it
+#  - setCtx(), so that a machine can be reused by another context
+
+import re
+import sys
+
+
+def read(path):
+    with open(path, newline='') as f:
+        text = f.read()
+    crlf = '\r\n' in text
+    return text.replace('\r\n', '\n'), crlf
+
+
+def write(path, text, crlf):
+    with open(path, 'w', newline='') as f:
+        f.write(text.replace('\n', '\r\n') if crlf else text)
+
+
+def state_order(cpp, mgr):
+    """The states, in the order they are constructed and so numbered."""
+    top = re.search(r'myConcStateList\.push_back\(new (?:\(this\) )?(\w+)\(', cpp)
+    if not top:
+        sys.exit(mgr + ': no top-level state')
+    subs = {}
+    for m in re.finditer(r'^(\w+)::\1\(const (?:string&|char\*) name.*?\n\{\n(.*?)^\}', cpp, re.M | re.S):
+        subs[m.group(1)] = re.findall(r'mySubStates\.push_back\(new (?:\(mgr\) )?(\w+)\(', m.group(2))
+    order = []
+
+    def visit(state):
+        order.append(state)
+        for sub in subs.get(state, []):
+            visit(sub)
+
+    visit(top.group(1))
+    return order
+
+
+def add_enum(h, mgr, order):
+    if 'enum E%sStates' % mgr in h:
+        return h
+    lines = ''.join('\t\te%s,\n' % s for s in order)
+    enum = ('\t//State numbers, in the order the states are constructed\n'
+            '\tenum E%sStates\n\t{\n%s\t};\n\n' % (mgr, lines))
+    return h.replace('\tusing namespace smartstate;\n', '\tusing namespace smartstate;\n' + enum, 1)
+
+
+def add_check(cpp, order):
+    if 'checkStateIds(' in cpp:
+        return cpp
+    names = ''.join('\t\t"%s",\n' % s for s in order)
+    check = ('\tstatic const char* const stateNames[] =\n\t{\n%s\t};\n'
+             '\tcheckStateIds(stateNames, sizeof(stateNames) / sizeof(stateNames[0]));\n' % names)
+    return re.sub(r'(\tmyConcStateList\.push_back\(.*\);\n)', lambda m: m.group(1) + check, cpp, count=1)
+
+
+def number_transitions(cpp):
+    def state(name):
+        return 'e' + name
+
+    cpp = re.sub(r'executeExit\("(\w+)", "(\w+)"\)',
+                 lambda m: 'executeExit(%s, %s)' % (state(m.group(1)), state(m.group(2))), cpp)
+    return re.sub(r'executeEntry\(root, "(\w+)"\)',
+                  lambda m: 'executeEntry(root, %s)' % state(m.group(1)), cpp)
+
+
+TRACE_POINTS = {'onEntry': 'eTraceOnEntry', 'onExit': 'eTraceOnExit',
+                'message trapped': 'eTraceTrapped', 'executing exit': 'eTraceExecExit',
+                'executing effect': 'eTraceExecEffect', 'executing entry': 'eTraceExecEntry'}
+
+
+def trace_points(cpp):
+    def trace(m):
+        state, message, point = m.group(1), m.group(2) or '0', TRACE_POINTS[m.group(3)]
+        return 'SS_TRACE(e%s, %s, %s);' % (state, message, point)
+
+    return re.sub(r'myMgr->debugLog\("(?:[<>] )?(\w+) (?:(\w+) )?<([a-zA-Z ]+)>"\);', trace, cpp)
+
+
+def arena_states(text):
+    text = text.replace('const string& name', 'const char* name')
+    text = re.sub(r'myConcStateList\.push_back\(new (?!\()', 'myConcStateList.push_back(new (this) ', text)
+    return re.sub(r'mySubStates\.push_back\(new (?!\()', 'mySubStates.push_back(new (mgr) ', text)
+
+
+def add_set_ctx(h, cpp, mgr):
+    if 'setCtx(' in h:
+        return h, cpp
+    ctx = re.search(r'(\w+)& getCtx\(\) const;', h).group(1)
+    h = h.replace('\t\t\t%s& getCtx() const;\n' % ctx,
+                  '\t\t\t%s& getCtx() const;\n\t\t\tvoid setCtx(%s* ctx);\n' % (ctx, ctx), 1)
+    get_ctx = '%s& %s::getCtx() const\n{\n\treturn *myCtx;\n}\n' % (ctx, mgr)
+    set_ctx = '\nvoid %s::setCtx(%s* ctx)\n{\n\tmyCtx = ctx;\n}\n' % (mgr, ctx)
+    return h, cpp.replace(get_ctx, get_ctx + set_ctx, 1)
+
+
+def post_gen(mgr):
+    cpp, cpp_crlf = read(mgr + '.cpp')
+    h, h_crlf = read(mgr + '.h')
+    order = state_order(cpp, mgr)
+    h = add_enum(h, mgr, order)
+    cpp = add_check(cpp, order)
+    cpp = number_transitions(cpp)
+    cpp = trace_points(cpp)
+    h, cpp = arena_states(h), arena_states(cpp)
+    h, cpp = add_set_ctx(h, cpp, mgr)
+    write(mgr + '.h', h, h_crlf)
+    write(mgr + '.cpp', cpp, cpp_crlf)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.exit('usage: ssPostGen.py <generated StateMgr>...  e.g. ySenderSS yReceiverSS')
+    for arg in sys.argv[1:]:
+        post_gen(arg)
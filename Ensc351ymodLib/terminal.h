@@ -1,6 +1,6 @@
-#ifndef TERMINAL_H_
-#define TERMINAL_H_
-
-void Terminal(int termNum, int inD, int outD, int mediumD);		
-
-#endif /*TERMINAL_H_*/
+#ifndef TERMINAL_H_
+#define TERMINAL_H_
+
+void Terminal(int termNum, int inD, int outD, int mediumD);		
+
+#endif /*TERMINAL_H_*/
@@ -0,0 +1,220 @@
+//============================================================================
+// File Name   : yReceiverChart.cpp
+// Description : The YMODEM receiver statechart (yReceiver.smc) as tables
+//               for the StaticChart engine.  The states, the order of the
+//               rows and the actions are those of the generated
+//               yReceiverSS.cpp, which remains the reference.
+//============================================================================
+
+#include "ReceiverYCore.h"
+
+#include "StaticChart.h"
+
+using namespace std;
+using namespace staticchart;
+
+// protocol tunables come from the run-time configuration of the context
+#undef TM_SOH
+#define TM_SOH (ctx.cfg.tmSoh)
+#undef TM_2CHAR
+#define TM_2CHAR (ctx.cfg.tm2Char)
+#undef errB
+#define errB (ctx.cfg.errBound)
+
+#define GUARD(condition) [](Context& ctx, int c) -> bool { return condition; }
+#define ACTION(...) [](Context& ctx, int c, Post& post) { __VA_ARGS__ }
+#undef POST_ALL
+#define POST_ALL(event) post.post(event)
+
+namespace
+{
+struct yReceiverChart
+{
+	typedef ReceiverYCore Context;
+
+	enum State {
+		Receiver_TopLevel_yReceiverSS,
+		NON_CAN_Receiver_TopLevel,
+		FirstByteStat_NON_CAN,
+		DataCancelable_NON_CAN,
+		FirstByteData_DataCancelable,
+		EOT_DataCancelable,
+		CondTransientData_NON_CAN,
+		CondTransientCheck_NON_CAN,
+		CondTransientOpen_NON_CAN,
+		CondTransientEOT_NON_CAN,
+		CondlTransientStat_NON_CAN,
+		AreWeDone_NON_CAN,
+		CAN_Receiver_TopLevel,
+	};
+
+	static constexpr StateDef<Context> states[]{
+		{"Receiver_TopLevel_yReceiverSS", NO_STATE, true, true,
+			ACTION(ctx.sendByte(ctx.NCGbyte);
+			       ctx.closeProb = -1;
+			       ctx.errCnt = 0;
+			       ctx.tm(TM_SOH);
+			       ctx.KbCan = false;),
+			nullptr},
+		{"NON_CAN_Receiver_TopLevel", Receiver_TopLevel_yReceiverSS, true, true, nullptr, nullptr},
+		{"FirstByteStat_NON_CAN", NON_CAN_Receiver_TopLevel, false, false, nullptr, nullptr},
+		{"DataCancelable_NON_CAN", NON_CAN_Receiver_TopLevel, true, false, nullptr, nullptr},
+		{"FirstByteData_DataCancelable", DataCancelable_NON_CAN, false, false, nullptr, nullptr},
+		{"EOT_DataCancelable", DataCancelable_NON_CAN, false, false, nullptr, nullptr},
+		{"CondTransientData_NON_CAN", NON_CAN_Receiver_TopLevel, false, false,
+			ACTION(ctx.tm(0);), nullptr},
+		{"CondTransientCheck_NON_CAN", NON_CAN_Receiver_TopLevel, false, false,
+			ACTION(POST_ALL(CONT);), nullptr},
+		{"CondTransientOpen_NON_CAN", NON_CAN_Receiver_TopLevel, false, false,
+			ACTION(POST_ALL(CONT);), nullptr},
+		{"CondTransientEOT_NON_CAN", NON_CAN_Receiver_TopLevel, false, false,
+			ACTION(POST_ALL(CONT);), nullptr},
+		{"CondlTransientStat_NON_CAN", NON_CAN_Receiver_TopLevel, false, false,
+			ACTION(POST_ALL(CONT);), nullptr},
+		{"AreWeDone_NON_CAN", NON_CAN_Receiver_TopLevel, false, false, nullptr, nullptr},
+		{"CAN_Receiver_TopLevel", Receiver_TopLevel_yReceiverSS, false, false, nullptr, nullptr},
+	};
+
+	static constexpr Row<Context> rows[]{
+		{Receiver_TopLevel_yReceiverSS, KB_C, nullptr, INTERNAL,
+			ACTION(ctx.KbCan = true;)},
+		{Receiver_TopLevel_yReceiverSS, SER, nullptr, FINAL,
+			ACTION(ctx.purge();  ctx.cans();
+			       if (ctx.KbCan)
+			           ctx.result += "KbCancelled (delayed)";
+			       else
+			           ctx.result += "ExcessiveErrors";)},
+		{Receiver_TopLevel_yReceiverSS, TM, nullptr, FINAL,
+			ACTION(ctx.cans();
+			       if (ctx.KbCan)
+			            ctx.result += "KbCancelled";
+			       else
+			            ctx.result += "ExcessiveErrors";)},
+
+		{NON_CAN_Receiver_TopLevel, SER, GUARD(!ctx.KbCan  && c!=CAN), INTERNAL,
+			ACTION(ctx.purge();)},
+		{NON_CAN_Receiver_TopLevel, SER, GUARD(c==CAN), CAN_Receiver_TopLevel,
+			ACTION(ctx.tmPush(TM_2CHAR);)},
+		{NON_CAN_Receiver_TopLevel, TM, GUARD(ctx.errCnt < errB && !ctx.KbCan), INTERNAL,
+			ACTION(if (ctx.transferringFileD == -1)
+			           ctx.sendByte(ctx.NCGbyte);
+			       else
+			           ctx.sendByte(NAK);
+			       ++ ctx.errCnt;
+			       ctx.tm(TM_SOH);)},
+
+		{DataCancelable_NON_CAN, SER, GUARD(!ctx.KbCan && c==SOH), CondTransientData_NON_CAN,
+			ACTION(ctx.getRestBlk();
+			       if (ctx.goodBlk1st) {
+			            ctx.errCnt = 0;
+			            ctx.anotherFile=0;
+			       }
+			       else ++ctx.errCnt;)},
+
+		{FirstByteData_DataCancelable, SER, GUARD(!ctx.KbCan &&       c == EOT), EOT_DataCancelable,
+			ACTION(ctx.purge();  ctx.sendByte(NAK);
+			       ++ctx.errCnt;
+			       ctx.tm(TM_SOH);)},
+
+		{EOT_DataCancelable, SER, GUARD(c==EOT), CondTransientEOT_NON_CAN,
+			ACTION(ctx.closeTransferredFile();)},
+
+		{CondTransientData_NON_CAN, KB_C, nullptr, FINAL,
+			ACTION(ctx.cans();
+			       ctx.result += "kbCancelled (immediate)";)},
+		{CondTransientData_NON_CAN, TM, GUARD(!ctx.syncLoss && (ctx.errCnt < errB)), DataCancelable_NON_CAN,
+			ACTION(if (ctx.goodBlk) {
+			            ctx.sendByte(ACK);
+			            if (ctx.anotherFile) ctx.sendByte('C');
+			       }
+			       else  ctx.sendByte(NAK);
+			       if (ctx.goodBlk1st)
+			            ctx.writeChunk();
+			       ctx.tm(TM_SOH);)},
+		{CondTransientData_NON_CAN, TM, GUARD(ctx.syncLoss || ctx.errCnt >= errB), FINAL,
+			ACTION(ctx.cans();
+			       ctx.closeTransferredFile();
+			       if (ctx.syncLoss)
+			            ctx.result +="LossOfSyncronization";
+			       else
+			            ctx.result += "ExcessiveErrors";)},
+		{CondTransientData_NON_CAN, SER, nullptr, INTERNAL,
+			ACTION(ctx.purge();)},
+
+		{FirstByteStat_NON_CAN, SER, GUARD(c==EOT && !ctx.closeProb && ctx.errCnt >= errB), FINAL,
+			ACTION(ctx.cans();
+			       ctx.result += "ExcessiveEOTs";)},
+		{FirstByteStat_NON_CAN, SER, GUARD(c==EOT && !ctx.closeProb && ctx.errCnt < errB), INTERNAL,
+			ACTION(ctx.sendByte(ACK);
+			       ctx.sendByte(ctx.NCGbyte);
+			       ++ ctx.errCnt;  ctx.tm(TM_SOH);)},
+		{FirstByteStat_NON_CAN, SER, GUARD(!ctx.KbCan && c==SOH), CondlTransientStat_NON_CAN,
+			ACTION(ctx.getRestBlk();
+			       if (!ctx.closeProb) {
+			           ctx.errCnt = 0;
+			           ctx.closeProb = -1;
+			       })},
+
+		{CondTransientCheck_NON_CAN, CONT, GUARD(!ctx.anotherFile), AreWeDone_NON_CAN,
+			ACTION(ctx.sendByte(ACK);
+			       ctx.tm(TM_SOH);)},
+		{CondTransientCheck_NON_CAN, CONT, GUARD(ctx.anotherFile), CondTransientOpen_NON_CAN,
+			ACTION(ctx.openFileForTransfer();)},
+
+		{CondTransientOpen_NON_CAN, CONT, GUARD(ctx.transferringFileD != -1), FirstByteData_DataCancelable,
+			ACTION(ctx.sendByte(ACK);
+			       ctx.sendByte(
+			             ctx.NCGbyte);
+			       ctx.tm(TM_SOH);)},
+		{CondTransientOpen_NON_CAN, CONT, GUARD(ctx.transferringFileD == -1), FINAL,
+			ACTION(ctx.cans();
+			       ctx.result += "CreatError";)},
+
+		{CondTransientEOT_NON_CAN, CONT, GUARD(!ctx.closeProb), FirstByteStat_NON_CAN,
+			ACTION(ctx.sendByte(ACK);
+			       ctx.sendByte(ctx.NCGbyte);
+			       ctx.result += "Done, ";
+			       ctx.errCnt = 0;
+			       ctx.tm(TM_SOH);)},
+		{CondTransientEOT_NON_CAN, CONT, GUARD(ctx.closeProb), FINAL,
+			ACTION(ctx.cans();
+			       ctx.result += "CloseError";)},
+
+		{CondlTransientStat_NON_CAN, CONT, GUARD(!ctx.syncLoss && (ctx.errCnt < errB)  && !ctx.goodBlk), FirstByteStat_NON_CAN,
+			ACTION(ctx.sendByte(NAK);
+			       ++ ctx.errCnt;
+			       ctx.tm(TM_SOH);)},
+		{CondlTransientStat_NON_CAN, CONT, GUARD(!ctx.syncLoss && (ctx.errCnt < errB) && ctx.goodBlk), CondTransientCheck_NON_CAN,
+			ACTION(ctx.checkForAnotherFile();)},
+		{CondlTransientStat_NON_CAN, CONT, GUARD(ctx.syncLoss || ctx.errCnt >= errB), FINAL,
+			ACTION(ctx.cans();
+			       if (ctx.syncLoss)
+			            ctx.result += "LossOfSync at Stat Blk";
+			       else
+			            ctx.result += "ExcessiveErrors at Stat";)},
+
+		{AreWeDone_NON_CAN, TM, nullptr, FINAL,
+			ACTION(ctx.result += "EndOfSession";)},
+		{AreWeDone_NON_CAN, SER, GUARD(!ctx.KbCan && c==SOH), CondlTransientStat_NON_CAN,
+			ACTION(ctx.getRestBlk();
+			       ++ ctx.errCnt;)},
+
+		{CAN_Receiver_TopLevel, SER, GUARD(c != CAN && !ctx.KbCan), NON_CAN_Receiver_TopLevel,
+			ACTION(ctx.purge();
+			       ctx.tmPop();)},
+		{CAN_Receiver_TopLevel, SER, GUARD(c == CAN), FINAL,
+			ACTION(ctx.closeTransferredFile();
+			       ctx.clearCan();
+			       ctx.result += "SndCancelled";)},
+		{CAN_Receiver_TopLevel, TM, GUARD(!ctx.KbCan), NON_CAN_Receiver_TopLevel,
+			ACTION(ctx.tmPop();)},
+	};
+};
+}
+
+shared_ptr<SessionChart>
+ReceiverYCore::
+receiveFilesChart()
+{
+	return make_shared<StaticChart<yReceiverChart>>(this);
+}
@@ -0,0 +1,267 @@
+//============================================================================
+// File Name   : yReceiverCo.cpp
+// Description : The YMODEM receiver as a coroutine.  It follows the yReceiver
+//               statechart (yReceiver.smc).  Each event is offered first to
+//               the innermost state and then to the states enclosing it,
+//               as in the statechart, but the helpers that have to wait
+//               are awaited instead of blocking a thread.
+//============================================================================
+
+#include "ReceiverYCore.h"
+
+#include "AtomicCOUT.h"
+
+using namespace std;
+
+// Receive the rest of a block, as getRestBlk().  nextEvent() gave the SOH only once
+//  the rest had arrived, or stalled (see readAheadFor()).
+PeerTask
+ReceiverYCore::
+getRestBlkCo()
+{
+	int bytesRead{takeInput(rcvBlk+1, BUF_SZ - 1)};
+	if (checkRestBlk(bytesRead))
+		co_await purgeCo();
+}
+
+PeerTask
+ReceiverYCore::
+receiveFilesCo()
+{
+	// the substates of NON_CAN_Receiver_TopLevel (FirstByteData and EOTData are
+	//  in DataCancelable_NON_CAN), then its conditional transient states, which
+	//  are left as soon as they are entered.  NON_CAN_Receiver_TopLevel has
+	//  history, so state is kept while in CAN_Receiver_TopLevel (inCan).
+	enum { FirstByteStat, FirstByteData, EOTData, CondTransientData, AreWeDone,
+		CondTransientCheck, CondTransientOpen, CondTransientEOT, CondlTransientStat,
+		Final } state{FirstByteStat};
+	bool inCan{false};
+
+	// Receiver_TopLevel entry
+	sendByte(NCGbyte); closeProb = -1; errCnt = 0; tm(cfg.tmSoh);
+	KbCan = false;
+
+	for (;;) {
+		int c{co_await nextEvent()};
+
+		if (EV_KB_C == c) {
+			if (!inCan && CondTransientData == state) {
+				cans();
+				result += "kbCancelled (immediate)";
+				co_return;
+			}
+			KbCan = true;
+			continue;
+		}
+
+		if (EV_TM == c) {
+			if (inCan) {
+				if (!KbCan) {
+					tmPop();
+					inCan = false;
+					if (CondTransientData == state)
+						tm(0); // entry of CondTransientData
+					continue;
+				}
+			}
+			else if (CondTransientData == state) {
+				if (!syncLoss && (errCnt < cfg.errBound)) {
+					if (goodBlk) {
+						sendByte(ACK);
+						if (anotherFile)
+							sendByte('C');
+					}
+					else
+						sendByte(NAK);
+					if (goodBlk1st)
+						writeChunk();
+					tm(cfg.tmSoh);
+					state = FirstByteData;
+				}
+				else {
+					cans();
+					closeTransferredFile();
+					if (syncLoss)
+						result +="LossOfSyncronization";
+					else
+						result += "ExcessiveErrors";
+					co_return;
+				}
+				continue;
+			}
+			else if (AreWeDone == state) {
+				result += "EndOfSession";
+				co_return;
+			}
+			else if (errCnt < cfg.errBound && !KbCan) { // NON_CAN_Receiver_TopLevel
+				if (transferringFileD == -1)
+					sendByte(NCGbyte);
+				else
+					sendByte(NAK);
+				++ errCnt;
+				tm(cfg.tmSoh);
+				continue;
+			}
+			// Receiver_TopLevel
+			cans();
+			if (KbCan)
+				result += "KbCancelled";
+			else
+				result += "ExcessiveErrors";
+			co_return;
+		}
+
+		// c is a byte from the sender
+		bool handled{true};
+		if (inCan) { // CAN_Receiver_TopLevel
+			if (c != CAN && !KbCan) {
+				co_await purgeCo();
+				tmPop();
+				inCan = false;
+				if (CondTransientData == state)
+					tm(0); // entry of CondTransientData
+			}
+			else if (c == CAN) {
+				closeTransferredFile();
+				co_await clearCanCo(cfg.tm2Char);
+				result += "SndCancelled";
+				co_return;
+			}
+			else
+				handled = false;
+		}
+		else if (FirstByteData == state && !KbCan && c == EOT) {
+			co_await purgeCo();
+			sendByte(NAK);
+			++errCnt;
+			tm(cfg.tmSoh);
+			state = EOTData;
+		}
+		else if (EOTData == state && c == EOT) {
+			closeTransferredFile();
+			state = CondTransientEOT;
+		}
+		else if ((FirstByteData == state || EOTData == state) && !KbCan && c == SOH) { // DataCancelable_NON_CAN
+			co_await getRestBlkCo();
+			if (goodBlk1st) {
+				errCnt = 0;
+				anotherFile=0;
+			}
+			else
+				++errCnt;
+			state = CondTransientData;
+			tm(0); // entry of CondTransientData
+		}
+		else if (CondTransientData == state)
+			co_await purgeCo();
+		else if (FirstByteStat == state && c == EOT && !closeProb && errCnt >= cfg.errBound) {
+			cans();
+			result += "ExcessiveEOTs";
+			co_return;
+		}
+		else if (FirstByteStat == state && c == EOT && !closeProb && errCnt < cfg.errBound) {
+			sendByte(ACK);
+			sendByte(NCGbyte);
+			++ errCnt;
+			tm(cfg.tmSoh);
+		}
+		else if (FirstByteStat == state && !KbCan && c == SOH) {
+			co_await getRestBlkCo();
+			if (!closeProb) {
+				errCnt = 0;
+				closeProb = -1;
+			}
+			state = CondlTransientStat;
+		}
+		else if (AreWeDone == state && !KbCan && c == SOH) {
+			co_await getRestBlkCo();
+			++ errCnt;
+			state = CondlTransientStat;
+		}
+		else if (!KbCan && c != CAN) // NON_CAN_Receiver_TopLevel
+			co_await purgeCo();
+		else if (c == CAN) {
+			tmPush(cfg.tm2Char);
+			inCan = true;
+		}
+		else
+			handled = false;
+
+		if (!handled) { // Receiver_TopLevel
+			co_await purgeCo();
+			cans();
+			if (KbCan)
+				result += "KbCancelled (delayed)";
+			else
+				result += "ExcessiveErrors";
+			co_return;
+		}
+
+		// leave the conditional transient states, on the CONT event each posts on entry
+		while (state >= CondTransientCheck) {
+			switch (state) {
+			case CondlTransientStat:
+				if (syncLoss || errCnt >= cfg.errBound) {
+					cans();
+					if (syncLoss)
+						result += "LossOfSync at Stat Blk";
+					else
+						result += "ExcessiveErrors at Stat";
+					state = Final;
+				}
+				else if (!goodBlk) {
+					sendByte(NAK);
+					++ errCnt;
+					tm(cfg.tmSoh);
+					state = FirstByteStat;
+				}
+				else {
+					checkForAnotherFile();
+					state = CondTransientCheck;
+				}
+				break;
+			case CondTransientCheck:
+				if (!anotherFile) {
+					sendByte(ACK);
+					tm(cfg.tmSoh);
+					state = AreWeDone;
+				}
+				else {
+					openFileForTransfer();
+					state = CondTransientOpen;
+				}
+				break;
+			case CondTransientOpen:
+				if (transferringFileD != -1) {
+					sendByte(ACK);
+					sendByte( NCGbyte);
+					tm(cfg.tmSoh);
+					state = FirstByteData;
+				}
+				else {
+					cans();
+					result += "CreatError";
+					state = Final;
+				}
+				break;
+			case CondTransientEOT:
+				if (!closeProb) {
+					sendByte(ACK);
+					sendByte(NCGbyte);
+					result += "Done, ";
+					errCnt = 0;
+					tm(cfg.tmSoh);
+					state = FirstByteStat;
+				}
+				else {
+					cans();
+					result += "CloseError";
+					state = Final;
+				}
+				break;
+			default:
+				co_return; // Final
+			}
+		}
+	}
+}
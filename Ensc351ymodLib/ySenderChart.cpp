@@ -0,0 +1,170 @@
+//============================================================================
+// File Name   : ySenderChart.cpp
+// Description : The YMODEM sender statechart (ySender.smc) as tables for
+//               the StaticChart engine.  The states, the order of the rows
+//               and the actions are those of the generated ySenderSS.cpp,
+//               which remains the reference.
+//============================================================================
+
+#include "SenderYCore.h"
+
+#include <iostream>
+
+#include "StaticChart.h"
+
+using namespace std;
+using namespace staticchart;
+
+// protocol tunables come from the run-time configuration of the context
+#undef TM_VL
+#define TM_VL (ctx.cfg.tmVL)
+#undef TM_2CHAR
+#define TM_2CHAR (ctx.cfg.tm2Char)
+#undef TM_CHAR
+#define TM_CHAR (ctx.cfg.tmChar)
+#undef errB
+#define errB (ctx.cfg.errBound)
+
+#define GUARD(condition) [](Context& ctx, int c) -> bool { return condition; }
+#define ACTION(...) [](Context& ctx, int c, Post& post) { __VA_ARGS__ }
+
+namespace
+{
+struct ySenderChart
+{
+	typedef SenderYCore Context;
+
+	enum State {
+		Sender_TopLevel_ySenderSS,
+		NON_CAN_Sender_TopLevel,
+		StatC_NON_CAN,
+		ACKNAK_NON_CAN,
+		EOT1_NON_CAN,
+		ONE_NON_CAN,
+		EOTEOT_NON_CAN,
+		ACKNAKSTAT_NON_CAN,
+		CAN_Sender_TopLevel,
+	};
+
+	static constexpr StateDef<Context> states[]{
+		{"Sender_TopLevel_ySenderSS", NO_STATE, true, false,
+			ACTION(ctx.prepStatBlk(); ctx.errCnt=0;
+			       ctx.KbCan = false; ctx.tm(TM_VL);),
+			nullptr},
+		{"NON_CAN_Sender_TopLevel", Sender_TopLevel_ySenderSS, true, true, nullptr, nullptr},
+		{"StatC_NON_CAN", NON_CAN_Sender_TopLevel, false, false, nullptr, nullptr},
+		{"ACKNAK_NON_CAN", NON_CAN_Sender_TopLevel, false, false, nullptr, nullptr},
+		{"EOT1_NON_CAN", NON_CAN_Sender_TopLevel, false, false, nullptr, nullptr},
+		{"ONE_NON_CAN", NON_CAN_Sender_TopLevel, false, false, nullptr, nullptr},
+		{"EOTEOT_NON_CAN", NON_CAN_Sender_TopLevel, false, false, nullptr, nullptr},
+		{"ACKNAKSTAT_NON_CAN", NON_CAN_Sender_TopLevel, false, false, nullptr, nullptr},
+		{"CAN_Sender_TopLevel", Sender_TopLevel_ySenderSS, false, false, nullptr, nullptr},
+	};
+
+	static constexpr Row<Context> rows[]{
+		{Sender_TopLevel_ySenderSS, TM, nullptr, FINAL,
+			ACTION(ctx.cans();
+			       ctx.closeTransferredFile();
+			       if (ctx.KbCan)
+			            ctx.result += "KbCancelled";
+			       else
+			            ctx.result += "Timeout";)},
+		{Sender_TopLevel_ySenderSS, SER, GUARD(ctx.KbCan && (c==ACK || c==NAK || c=='C')), FINAL,
+			ACTION(ctx.cans();
+			       ctx.closeTransferredFile();
+			       ctx.result += "KbCancelled";)},
+
+		{NON_CAN_Sender_TopLevel, SER, GUARD(c==NAK && (ctx.errCnt >= errB)), FINAL,
+			ACTION(ctx.cans();
+			       ctx.closeTransferredFile();
+			       ctx.result += "ExcessiveNAKs";)},
+		{NON_CAN_Sender_TopLevel, SER, GUARD(c == CAN), CAN_Sender_TopLevel,
+			ACTION(ctx.tmPush(TM_CHAR);)},
+		{NON_CAN_Sender_TopLevel, KB_C, GUARD(!ctx.KbCan), INTERNAL,
+			ACTION(ctx.KbCan = true;
+			       ctx.tmRed(TM_VL - TM_2CHAR);)},
+
+		{ACKNAK_NON_CAN, SER, GUARD( (c==NAK || (c=='C' && ctx.firstBlk)) && (ctx.errCnt < errB) && !ctx.KbCan), INTERNAL,
+			ACTION(ctx.resendBlk();
+			       ctx.errCnt++; ctx.tm(TM_VL);)},
+		{ACKNAK_NON_CAN, SER, GUARD((c==ACK) && !ctx.bytesRd && !ctx.KbCan), EOT1_NON_CAN,
+			ACTION(ctx.sendByte(EOT);ctx.errCnt=0;
+			       ctx.closeTransferredFile();
+			       ctx.tm(TM_VL);)},
+		{ACKNAK_NON_CAN, SER, GUARD((c==ACK) && ctx.bytesRd && !ctx.KbCan), INTERNAL,
+			ACTION(ctx.sendBlkPrepNext();
+			       ctx.errCnt=0; ctx.tm(TM_VL);
+			       ctx.firstBlk=false;)},
+
+		{EOT1_NON_CAN, SER, GUARD(c=='C' && ctx.firstBlk && ctx.errCnt < errB), INTERNAL,
+			ACTION(ctx.sendByte(EOT);
+			       ++ctx.errCnt;
+			       ctx.tm(TM_VL);)},
+		{EOT1_NON_CAN, SER, GUARD(c == ACK && !ctx.KbCan), StatC_NON_CAN,
+			ACTION(cout << "1st EOT ACK'd";
+			       ctx.prepStatBlk(); ctx.tm(TM_VL);)},
+		{EOT1_NON_CAN, SER, GUARD(c==NAK && !ctx.KbCan), EOTEOT_NON_CAN,
+			ACTION(ctx.sendByte(EOT);
+			       ctx.errCnt=0;ctx.tm(TM_VL);
+			       ctx.firstBlk=false;)},
+
+		{ONE_NON_CAN, SER, GUARD(c == 'C' && !ctx.bytesRd && !ctx.KbCan), EOT1_NON_CAN,
+			ACTION(ctx.sendByte(EOT);
+			       ctx.tm(TM_VL);
+			       ctx.errCnt=0;
+			       ctx.closeTransferredFile();)},
+		{ONE_NON_CAN, SER, GUARD(c=='C' && ctx.bytesRd && !ctx.KbCan), ACKNAK_NON_CAN,
+			ACTION(ctx.sendBlkPrepNext();
+			       ctx.tm(TM_VL); ctx.errCnt=0;)},
+		{ONE_NON_CAN, SER, GUARD(c==NAK && !ctx.KbCan), ACKNAKSTAT_NON_CAN,
+			ACTION(ctx.resendBlk(); ctx.errCnt++;
+			       ctx.tm(TM_VL);)},
+
+		{EOTEOT_NON_CAN, SER, GUARD(c==NAK && !ctx.KbCan && ctx.errCnt < errB), INTERNAL,
+			ACTION(ctx.sendByte(EOT);
+			       ctx.errCnt++;
+			       ctx.tm(TM_VL);)},
+		{EOTEOT_NON_CAN, SER, GUARD(c==ACK && !ctx.KbCan), StatC_NON_CAN,
+			ACTION(ctx.result += "Done, ";
+			       ctx.prepStatBlk(); ctx.tm(TM_VL);)},
+
+		{StatC_NON_CAN, SER, GUARD(c=='C' && ctx.fileName && ctx.transferringFileD == -1), FINAL,
+			ACTION(ctx.cans();
+			       ctx.result += "OpenError";)},
+		{StatC_NON_CAN, SER, GUARD(c=='C' && ctx.transferringFileD != -1), ACKNAKSTAT_NON_CAN,
+			ACTION(ctx.sendBlkPrepNext(); ctx.errCnt=0;
+			       ctx.tm(TM_VL);)},
+		{StatC_NON_CAN, KB_C, nullptr, FINAL,
+			ACTION(if (ctx.transferringFileD == -1) ctx.result="KbCancelledOpenErr";
+			       else {ctx.closeTransferredFile(); ctx.result="KbCancelledFromStatC";})},
+
+		{ACKNAKSTAT_NON_CAN, SER, GUARD(c==ACK && ctx.fileName && !ctx.KbCan), ONE_NON_CAN,
+			ACTION(ctx.firstBlk= true;
+			       ctx.tm(TM_VL);)},
+		{ACKNAKSTAT_NON_CAN, SER, GUARD((c==NAK || c=='C') && !ctx.KbCan), INTERNAL,
+			ACTION(ctx.resendBlk();
+			       ++ ctx.errCnt;
+			       ctx.tm(TM_VL);)},
+		{ACKNAKSTAT_NON_CAN, SER, GUARD(c==ACK && !ctx.fileName), FINAL,
+			ACTION(ctx.result+="EndOfSession";)},
+
+		{CAN_Sender_TopLevel, KB_C, nullptr, INTERNAL,
+			ACTION(ctx.KbCan=true;)},
+		{CAN_Sender_TopLevel, SER, GUARD(c != CAN && !ctx.KbCan), NON_CAN_Sender_TopLevel,
+			ACTION(ctx.tmPop();)},
+		{CAN_Sender_TopLevel, SER, GUARD(c == CAN), FINAL,
+			ACTION(ctx.closeTransferredFile();
+			       ctx.clearCan();
+			       ctx.result+="RcvCancelled";)},
+		{CAN_Sender_TopLevel, TM, GUARD(!ctx.KbCan), NON_CAN_Sender_TopLevel,
+			ACTION(ctx.tmPop();)},
+	};
+};
+}
+
+shared_ptr<SessionChart>
+SenderYCore::
+sendFilesChart()
+{
+	return make_shared<StaticChart<ySenderChart>>(this);
+}
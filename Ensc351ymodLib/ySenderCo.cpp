@@ -0,0 +1,236 @@
+//============================================================================
+// File Name   : ySenderCo.cpp
+// Description : The YMODEM sender as a coroutine.  It follows the ySender
+//               statechart (ySender.smc).  Each event is offered first to
+//               the innermost state and then to the states enclosing it,
+//               as in the statechart, but the helpers that have to wait
+//               are awaited instead of blocking a thread.
+//============================================================================
+
+#include "SenderYCore.h"
+
+#include <string.h> // for memset()
+
+#include "AtomicCOUT.h"
+
+using namespace std;
+
+// Send the last byte of a block once the rest has been drained, as sendLastByte()
+PeerTask
+SenderYCore::
+sendLastByteCo(uint8_t lastByte)
+{
+	co_await drained();
+	int dumped{discardInput()}; // dump any received glitches
+	if (reportInfo)
+		COUT << "[d" << dumped << "]" << flush;
+	mediumWrite(&lastByte, sizeof(lastByte));
+}
+
+// Send cfg.canLen CAN characters in groups spaced in time, as cans()
+PeerTask
+SenderYCore::
+cansCo()
+{
+	const int CAN_BURST=2; //The number of CAN chars in a burst.
+	char buffer[CAN_BURST];
+	memset( buffer, CAN, CAN_BURST);
+
+	const int canGroups=cfg.canLen/CAN_BURST;
+	int x = 1;
+	while (mediumWrite(buffer, CAN_BURST),
+			x<canGroups) {
+		++x;
+		co_await sleepFor((int)((cfg.tm2Char + cfg.tmChar)/2 * mSECS_PER_UNIT));
+	}
+}
+
+PeerTask
+SenderYCore::
+sendFilesCo()
+{
+	// the substates of NON_CAN_Sender_TopLevel.  It has history, so state is
+	//  kept while in CAN_Sender_TopLevel (inCan).
+	enum { StatC, ACKNAKSTAT, ONE, ACKNAK, EOT1, EOTEOT } state{StatC};
+	bool inCan{false};
+
+	// Sender_TopLevel entry
+	prepStatBlk(); errCnt=0;
+	KbCan = false; tm(cfg.tmVL);
+
+	for (;;) {
+		int c{co_await nextEvent()};
+
+		if (EV_KB_C == c) {
+			if (inCan)
+				; // KbCan is set below
+			else if (StatC == state) {
+				if (transferringFileD == -1)
+					result="KbCancelledOpenErr";
+				else {
+					closeTransferredFile();
+					result="KbCancelledFromStatC";
+				}
+				co_return;
+			}
+			else if (!KbCan)
+				tmRed(cfg.tmVL - cfg.tm2Char);
+			KbCan = true;
+			continue;
+		}
+
+		if (EV_TM == c) {
+			if (inCan && !KbCan) {
+				tmPop();
+				inCan = false;
+				continue;
+			}
+			co_await cansCo();
+			closeTransferredFile();
+			if (KbCan)
+				result += "KbCancelled";
+			else
+				result += "Timeout";
+			co_return;
+		}
+
+		// c is a byte from the receiver
+		if (inCan) { // CAN_Sender_TopLevel
+			if (c != CAN && !KbCan) {
+				tmPop();
+				inCan = false;
+				continue;
+			}
+			if (c == CAN) {
+				closeTransferredFile();
+				co_await clearCanCo(cfg.tmChar);
+				result+="RcvCancelled";
+				co_return;
+			}
+		}
+		else {
+			switch (state) {
+			case StatC:
+				if (c=='C' && fileName && transferringFileD == -1) {
+					co_await cansCo();
+					result += "OpenError";
+					co_return;
+				}
+				if (c=='C' && transferringFileD != -1) {
+					co_await sendLastByteCo(sendMostBlkPrepNext());
+					errCnt=0; tm(cfg.tmVL);
+					state = ACKNAKSTAT;
+					continue;
+				}
+				break;
+			case ACKNAKSTAT:
+				if (c==ACK && fileName && !KbCan) {
+					firstBlk= true; tm(cfg.tmVL);
+					state = ONE;
+					continue;
+				}
+				if ((c==NAK || c=='C') && !KbCan) {
+					co_await sendLastByteCo(resendMostBlk());
+					++ errCnt; tm(cfg.tmVL);
+					continue;
+				}
+				if (c==ACK && !fileName) {
+					result+="EndOfSession";
+					co_return;
+				}
+				break;
+			case ONE:
+				if (c == 'C' && !bytesRd && !KbCan) {
+					sendByte(EOT); tm(cfg.tmVL); errCnt=0;
+					closeTransferredFile();
+					state = EOT1;
+					continue;
+				}
+				if (c=='C' && bytesRd && !KbCan) {
+					co_await sendLastByteCo(sendMostBlkPrepNext());
+					tm(cfg.tmVL); errCnt=0;
+					state = ACKNAK;
+					continue;
+				}
+				if (c==NAK && !KbCan) {
+					co_await sendLastByteCo(resendMostBlk());
+					errCnt++; tm(cfg.tmVL);
+					state = ACKNAKSTAT;
+					continue;
+				}
+				break;
+			case ACKNAK:
+				if ((c==NAK || (c=='C' && firstBlk)) && (errCnt < cfg.errBound) && !KbCan) {
+					co_await sendLastByteCo(resendMostBlk());
+					errCnt++; tm(cfg.tmVL);
+					continue;
+				}
+				if ((c==ACK) && !bytesRd && !KbCan) {
+					sendByte(EOT);errCnt=0;
+					closeTransferredFile();
+					tm(cfg.tmVL);
+					state = EOT1;
+					continue;
+				}
+				if ((c==ACK) && bytesRd && !KbCan) {
+					co_await sendLastByteCo(sendMostBlkPrepNext());
+					errCnt=0; tm(cfg.tmVL);
+					firstBlk=false;
+					continue;
+				}
+				break;
+			case EOT1:
+				if (c=='C' && firstBlk && errCnt < cfg.errBound) {
+					sendByte(EOT); ++errCnt; tm(cfg.tmVL);
+					continue;
+				}
+				if (c == ACK && !KbCan) {
+					COUT << "1st EOT ACK'd";
+					prepStatBlk(); tm(cfg.tmVL);
+					state = StatC;
+					continue;
+				}
+				if (c==NAK && !KbCan) {
+					sendByte(EOT); errCnt=0;tm(cfg.tmVL);
+					firstBlk=false;
+					state = EOTEOT;
+					continue;
+				}
+				break;
+			case EOTEOT:
+				if (c==NAK && !KbCan && errCnt < cfg.errBound) {
+					sendByte(EOT); errCnt++; tm(cfg.tmVL);
+					continue;
+				}
+				if (c==ACK && !KbCan) {
+					result += "Done, ";
+					prepStatBlk(); tm(cfg.tmVL);
+					state = StatC;
+					continue;
+				}
+				break;
+			}
+
+			// NON_CAN_Sender_TopLevel
+			if (c==NAK && (errCnt >= cfg.errBound)) {
+				co_await cansCo();
+				closeTransferredFile();
+				result += "ExcessiveNAKs";
+				co_return;
+			}
+			if (c == CAN) {
+				tmPush(cfg.tmChar);
+				inCan = true;
+				continue;
+			}
+		}
+
+		// Sender_TopLevel
+		if (KbCan && (c==ACK || c==NAK || c=='C')) {
+			co_await cansCo();
+			closeTransferredFile();
+			result += "KbCancelled";
+			co_return;
+		}
+	}
+}
@@ -1,222 +1,237 @@
-////////////////////////////////////////////////
-// Generated by SmartState C++ Code Generator //
-//                 DO NOT EDIT				  //
-////////////////////////////////////////////////
-
-#ifndef ySender_SS_H
-#define ySender_SS_H
-
-#include <ss_api.hxx>
-
-/*Context*/
-class SenderY;
-
-namespace ySender_SS
-{
-	using namespace smartstate;
-	//State Mgr
-	class ySenderSS : public StateMgr
-	{
-		public:
-			ySenderSS(SenderY* ctx, bool startMachine=true);
-
-			SenderY& getCtx() const;
-
-		private:
-			SenderY* myCtx;
-	};
-
-	//Base State
-	class ySenderBaseState : public BaseState
-	{
-		protected:
-			ySenderBaseState(){};
-			ySenderBaseState(const string& name, BaseState* parent, ySenderSS* mgr);
-
-		protected:
-			ySenderSS* getMgr(){return static_cast<ySenderSS*>(myMgr);}
-	};
-
-	//States
-	//------------------------------------------------------------------------
-	class Sender_TopLevel_ySenderSS : public virtual ySenderBaseState
-	{
-			typedef ySenderBaseState super;
-
-		public:
-			Sender_TopLevel_ySenderSS(){};
-			Sender_TopLevel_ySenderSS(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onTMMessage(const Mesg& mesg);
-			void onSERMessage(const Mesg& mesg);
-	};
-
-	class NON_CAN_Sender_TopLevel : public virtual Sender_TopLevel_ySenderSS
-	{
-			typedef Sender_TopLevel_ySenderSS super;
-
-		public:
-			NON_CAN_Sender_TopLevel(){};
-			NON_CAN_Sender_TopLevel(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-			void onKB_CMessage(const Mesg& mesg);
-	};
-
-	class ACKNAK_NON_CAN : public virtual NON_CAN_Sender_TopLevel
-	{
-			typedef NON_CAN_Sender_TopLevel super;
-
-		public:
-			ACKNAK_NON_CAN(){};
-			ACKNAK_NON_CAN(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-	};
-
-	class EOT1_NON_CAN : public virtual NON_CAN_Sender_TopLevel
-	{
-			typedef NON_CAN_Sender_TopLevel super;
-
-		public:
-			EOT1_NON_CAN(){};
-			EOT1_NON_CAN(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-	};
-
-	class ONE_NON_CAN : public virtual NON_CAN_Sender_TopLevel
-	{
-			typedef NON_CAN_Sender_TopLevel super;
-
-		public:
-			ONE_NON_CAN(){};
-			ONE_NON_CAN(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-	};
-
-	class EOTEOT_NON_CAN : public virtual NON_CAN_Sender_TopLevel
-	{
-			typedef NON_CAN_Sender_TopLevel super;
-
-		public:
-			EOTEOT_NON_CAN(){};
-			EOTEOT_NON_CAN(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-	};
-
-	class StatC_NON_CAN : public virtual NON_CAN_Sender_TopLevel
-	{
-			typedef NON_CAN_Sender_TopLevel super;
-
-		public:
-			StatC_NON_CAN(){};
-			StatC_NON_CAN(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-			void onKB_CMessage(const Mesg& mesg);
-	};
-
-	class ACKNAKSTAT_NON_CAN : public virtual NON_CAN_Sender_TopLevel
-	{
-			typedef NON_CAN_Sender_TopLevel super;
-
-		public:
-			ACKNAKSTAT_NON_CAN(){};
-			ACKNAKSTAT_NON_CAN(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onSERMessage(const Mesg& mesg);
-	};
-
-	class CAN_Sender_TopLevel : public virtual Sender_TopLevel_ySenderSS
-	{
-			typedef Sender_TopLevel_ySenderSS super;
-
-		public:
-			CAN_Sender_TopLevel(){};
-			CAN_Sender_TopLevel(const string& name, BaseState* parent, ySenderSS* mgr);
-
-			virtual void onMessage(const Mesg& mesg);
-
-			virtual void onEntry();
-			virtual void onExit();
-
-		//Transitions
-
-		private:
-			void onKB_CMessage(const Mesg& mesg);
-			void onSERMessage(const Mesg& mesg);
-			void onTMMessage(const Mesg& mesg);
-	};
-
-};
-
-#endif
-
-//___________________________________vv^^vv___________________________________
+////////////////////////////////////////////////
+// Generated by SmartState C++ Code Generator //
+//                 DO NOT EDIT				  //
+////////////////////////////////////////////////
+
+#ifndef ySender_SS_H
+#define ySender_SS_H
+
+#include <ss_api.hxx>
+
+/*Context*/
+class SenderYCore;
+
+namespace ySender_SS
+{
+	using namespace smartstate;
+	//State numbers, in the order the states are constructed
+	enum EySenderSSStates
+	{
+		eSender_TopLevel_ySenderSS,
+		eNON_CAN_Sender_TopLevel,
+		eStatC_NON_CAN,
+		eACKNAK_NON_CAN,
+		eEOT1_NON_CAN,
+		eONE_NON_CAN,
+		eEOTEOT_NON_CAN,
+		eACKNAKSTAT_NON_CAN,
+		eCAN_Sender_TopLevel,
+	};
+
+	//State Mgr
+	class ySenderSS : public StateMgr
+	{
+		public:
+			ySenderSS(SenderYCore* ctx, bool startMachine=true);
+
+			SenderYCore& getCtx() const;
+			void setCtx(SenderYCore* ctx);
+
+		private:
+			SenderYCore* myCtx;
+	};
+
+	//Base State
+	class ySenderBaseState : public BaseState
+	{
+		protected:
+			ySenderBaseState(){};
+			ySenderBaseState(const char* name, BaseState* parent, ySenderSS* mgr);
+
+		protected:
+			ySenderSS* getMgr(){return static_cast<ySenderSS*>(myMgr);}
+	};
+
+	//States
+	//------------------------------------------------------------------------
+	class Sender_TopLevel_ySenderSS : public virtual ySenderBaseState
+	{
+			typedef ySenderBaseState super;
+
+		public:
+			Sender_TopLevel_ySenderSS(){};
+			Sender_TopLevel_ySenderSS(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onTMMessage(const Mesg& mesg);
+			void onSERMessage(const Mesg& mesg);
+	};
+
+	class NON_CAN_Sender_TopLevel : public virtual Sender_TopLevel_ySenderSS
+	{
+			typedef Sender_TopLevel_ySenderSS super;
+
+		public:
+			NON_CAN_Sender_TopLevel(){};
+			NON_CAN_Sender_TopLevel(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+			void onKB_CMessage(const Mesg& mesg);
+	};
+
+	class ACKNAK_NON_CAN : public virtual NON_CAN_Sender_TopLevel
+	{
+			typedef NON_CAN_Sender_TopLevel super;
+
+		public:
+			ACKNAK_NON_CAN(){};
+			ACKNAK_NON_CAN(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+	};
+
+	class EOT1_NON_CAN : public virtual NON_CAN_Sender_TopLevel
+	{
+			typedef NON_CAN_Sender_TopLevel super;
+
+		public:
+			EOT1_NON_CAN(){};
+			EOT1_NON_CAN(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+	};
+
+	class ONE_NON_CAN : public virtual NON_CAN_Sender_TopLevel
+	{
+			typedef NON_CAN_Sender_TopLevel super;
+
+		public:
+			ONE_NON_CAN(){};
+			ONE_NON_CAN(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+	};
+
+	class EOTEOT_NON_CAN : public virtual NON_CAN_Sender_TopLevel
+	{
+			typedef NON_CAN_Sender_TopLevel super;
+
+		public:
+			EOTEOT_NON_CAN(){};
+			EOTEOT_NON_CAN(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+	};
+
+	class StatC_NON_CAN : public virtual NON_CAN_Sender_TopLevel
+	{
+			typedef NON_CAN_Sender_TopLevel super;
+
+		public:
+			StatC_NON_CAN(){};
+			StatC_NON_CAN(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+			void onKB_CMessage(const Mesg& mesg);
+	};
+
+	class ACKNAKSTAT_NON_CAN : public virtual NON_CAN_Sender_TopLevel
+	{
+			typedef NON_CAN_Sender_TopLevel super;
+
+		public:
+			ACKNAKSTAT_NON_CAN(){};
+			ACKNAKSTAT_NON_CAN(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onSERMessage(const Mesg& mesg);
+	};
+
+	class CAN_Sender_TopLevel : public virtual Sender_TopLevel_ySenderSS
+	{
+			typedef Sender_TopLevel_ySenderSS super;
+
+		public:
+			CAN_Sender_TopLevel(){};
+			CAN_Sender_TopLevel(const char* name, BaseState* parent, ySenderSS* mgr);
+
+			virtual void onMessage(const Mesg& mesg);
+
+			virtual void onEntry();
+			virtual void onExit();
+
+		//Transitions
+
+		private:
+			void onKB_CMessage(const Mesg& mesg);
+			void onSERMessage(const Mesg& mesg);
+			void onTMMessage(const Mesg& mesg);
+	};
+
+};
+
+#endif
+
+//___________________________________vv^^vv___________________________________
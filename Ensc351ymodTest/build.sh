@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Build the tests, benchmarks and tools in src/, one program for each .cpp file, against
+#  the sources of Ensc351 and Ensc351ymodLib, into Build/ (or $BUILD), and the simulator
+#  (Ensc351Part6) for runSim.sh.  For example:
+#    ./build.sh && ./runTests.sh
+#    OPT=-O0 ./build.sh
+# Programs ending in Test are run by runTests.sh.  The others (...Bench and tools) are run
+#  by hand, and print their usage for -h.
+
+set -e
+cd "$(dirname "$0")"
+LIB=..
+BUILD=${BUILD:-Build}
+OPT=${OPT:--O2}
+INC="-I$LIB/Ensc351 -I$LIB/Ensc351ymodLib"
+CXXFLAGS="-std=c++2a $OPT -g -Wall -Wno-unknown-pragmas -Wno-unused-variable $INC"
+mkdir -p $BUILD/obj
+
+# rebuild an object if its source, or any header, is newer
+newestHeader=$(ls -t $LIB/Ensc351/*.h* $LIB/Ensc351ymodLib/*.h $LIB/Ensc351Part6/src/*.h src/*.h 2>/dev/null | head -1)
+stale() { ! [ "$1" -nt "$2" ] || ! [ "$1" -nt "$newestHeader" ]; }
+
+objs=()
+for f in $LIB/Ensc351/*.c $LIB/Ensc351ymodLib/*.c; do
+	o=$BUILD/obj/$(basename $f).o
+	if stale $o $f; then gcc $OPT -g -Wall $INC -c $f -o $o; fi
+	objs+=($o)
+done
+for f in $LIB/Ensc351/*.cpp $LIB/Ensc351ymodLib/*.cpp; do
+	o=$BUILD/obj/$(basename $f).o
+	if stale $o $f; then g++ $CXXFLAGS -c $f -o $o; fi
+	objs+=($o)
+done
+
+for f in src/*.cpp; do
+	p=$BUILD/$(basename $f .cpp)
+	if stale $p $f || [ -n "$(find $BUILD/obj -newer $p)" ]; then
+		g++ $CXXFLAGS $f ${objs[@]} -lpthread -o $p
+	fi
+done
+
+simObjs=()
+for f in $LIB/Ensc351Part6/src/*.cpp; do
+	o=$BUILD/obj/$(basename $f).o
+	if stale $o $f; then g++ $CXXFLAGS -c $f -o $o; fi
+	simObjs+=($o)
+done
+if [ -n "$(find $BUILD/obj -newer $BUILD/Ensc351Part6 2>/dev/null)" ] || ! [ -e $BUILD/Ensc351Part6 ]; then
+	g++ ${simObjs[@]} ${objs[@]} -lpthread -o $BUILD/Ensc351Part6
+fi
@@ -0,0 +1,32 @@
+#!/bin/bash
+
+# Run one transfer on the simulator built by build.sh (Build/Ensc351Part6, or $SIM), in a
+#  scratch directory: terminal 1 receives and terminal 2 sends /etc/protocols, typed at the
+#  KVM as a user would.  The simulator's settings come from the environment as usual, e.g.
+#    ./runSim.sh
+#    YMODEM_PROCESSES=1 YMODEM_CHANNEL_BUF=256 ./runSim.sh
+#    YMODEM_SERIAL=1 YMODEM_BAUD=921600 MYIO_STATS=dump ./runSim.sh
+#  It waits for both results (at most [seconds], default 60), prints them, and exits with 0
+#  if the file arrived intact.
+
+cd "$(dirname "$0")"
+SIM=$(realpath ${SIM:-${BUILD:-Build}/Ensc351Part6})
+scratch=$(mktemp -d)
+cd $scratch
+{
+	sleep 0.3; printf '~1\n'; sleep 0.2; printf '&r\n'
+	sleep 0.2; printf '~2\n'; sleep 0.2; printf '&s\n'
+	for i in $(seq $((2 * ${1:-60}))); do
+		sleep 0.5
+		[ $(grep -ac "result was" out.txt) -ge 2 ] && break
+	done
+	printf '~q!\n'
+} | timeout $((${1:-60} + 30)) $SIM > out.txt 2>&1
+grep -a "result was" out.txt
+if cmp -s protocols /etc/protocols; then
+	echo "TRANSFER OK"
+	cd /; rm -rf $scratch
+else
+	echo "TRANSFER FAILED (files left in $scratch)"
+	exit 1
+fi
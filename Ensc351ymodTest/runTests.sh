@@ -0,0 +1,20 @@
+#!/bin/bash
+
+# Run each test program (src/...Test.cpp) built by build.sh, in a scratch directory of its
+#  own.  The exit status is the number of tests that failed.
+
+cd "$(dirname "$0")"
+BUILD=$(realpath ${BUILD:-Build})
+failed=0
+for t in $BUILD/*Test; do
+	[ -x "$t" ] || continue
+	scratch=$(mktemp -d)
+	if (cd $scratch && $t); then
+		echo "PASS $(basename $t)"
+		rm -rf $scratch
+	else
+		echo "FAIL $(basename $t) (files left in $scratch)"
+		failed=$((failed + 1))
+	fi
+done
+exit $failed
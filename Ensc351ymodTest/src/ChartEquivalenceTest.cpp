@@ -0,0 +1,122 @@
+//============================================================================
+// File Name   : ChartEquivalenceTest.cpp
+// Description : The statecharts on the StaticChart engine (ySenderChart.cpp
+//               and yReceiverChart.cpp), and the coroutine forms of the
+//               protocol (ySenderCo.cpp and yReceiverCo.cpp), against the
+//               SmartState machines.
+//
+// ChartEquivalenceTest [seeds]
+//   for each seed (default 200), transfers two files over a faulty in-memory
+//   medium (CoreLink.h) with each combination of engines (SmartState,
+//   StaticChart, coroutine) for the sender and the receiver, recording every
+//   byte that crosses the medium and when.  Every fourth seed also cancels
+//   the peers from their keyboards now and then.  The recording, the results
+//   and the files received must be the same as with SmartState at both ends.
+//============================================================================
+
+#include <sys/stat.h>		// for mkdir()
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+#include "CoreLink.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+struct Run {
+	bool finished;
+	string trace;
+	string senderResult, receiverResult;
+	string received; // the contents of the files received
+};
+
+static string contents(const char* name)
+{
+	ifstream in(name);
+	ostringstream all;
+	all << in.rdbuf();
+	return all.str();
+}
+
+enum Engine { SMART_STATE, STATIC_CHART, COROUTINE, ENGINES };
+static const char* const engineNames[ENGINES]{"SmartState", "StaticChart", "coroutine"};
+
+static Run transfer(unsigned seed, Engine senderEngine, Engine receiverEngine)
+{
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	PeerYConfig senderCfg{cfg}, receiverCfg{cfg};
+	senderCfg.staticChart = STATIC_CHART == senderEngine;
+	receiverCfg.staticChart = STATIC_CHART == receiverEngine;
+
+	remove("a");
+	remove("b");
+	SenderYCore sender({"src/a", "src/b"}, senderCfg);
+	ReceiverYCore receiver(receiverCfg);
+	if (COROUTINE == senderEngine)
+		sender.beginSendFilesCo();
+	else
+		sender.beginSendFiles();
+	if (COROUTINE == receiverEngine)
+		receiver.beginReceiveFilesCo();
+	else
+		receiver.beginReceiveFiles();
+
+	// from a perfect medium for some seeds to a poor one for others
+	LinkFaults faults;
+	faults.seed = seed;
+	faults.dropPerMil = seed % 7;
+	faults.flipPerMil = seed % 5;
+	faults.strayPerMil = seed % 3;
+	faults.cancelPerMil = seed % 4 == 0 ? 1 : 0;
+	CoreLink link(sender, receiver, faults);
+	link.recording = true;
+
+	Run run;
+	run.finished = link.run(1000000);
+	run.trace = link.trace;
+	run.senderResult = sender.result;
+	run.receiverResult = receiver.result;
+	run.received = contents("a") + '/' + contents("b");
+	return run;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [seeds]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	unsigned seeds{argc > 1 ? (unsigned) atoi(argv[1]) : 200};
+
+	testutil::scratchDir();
+	mkdir("src", 0755);
+	testutil::makeFile("src/a", 3000, 1);
+	testutil::makeFile("src/b", 700, 2);
+
+	unsigned done{0};
+	for (unsigned seed{1}; seed <= seeds; ++seed) {
+		Run reference{transfer(seed, SMART_STATE, SMART_STATE)};
+		CHECK(reference.finished);
+		if (reference.receiverResult == "Done, Done, EndOfSession")
+			++done;
+		for (int engines{1}; engines < ENGINES * ENGINES; ++engines) {
+			Engine senderEngine{Engine(engines % ENGINES)}, receiverEngine{Engine(engines / ENGINES)};
+			Run other{transfer(seed, senderEngine, receiverEngine)};
+			bool same{other.finished == reference.finished && other.trace == reference.trace
+				&& other.senderResult == reference.senderResult
+				&& other.receiverResult == reference.receiverResult
+				&& other.received == reference.received};
+			CHECK(same);
+			if (!same)
+				cerr << "seed " << seed << ", " << engineNames[senderEngine] << " sender, "
+					<< engineNames[receiverEngine] << " receiver" << endl;
+		}
+	}
+	// the medium should be good enough, often enough, for whole transfers to be checked
+	CHECK(done > seeds / 4);
+	CHECK(done < seeds);
+	printf("%u seeds, %u transferred everything\n", seeds, done);
+	return testutil::result();
+}
@@ -0,0 +1,150 @@
+/*
+ * CoreLink.h
+ *
+ * A sender core and a receiver core (see PeerYCore.h) joined by an in-memory
+ *  medium, on a simulated clock, for the tests and benchmarks in this
+ *  directory.  The medium can lose, corrupt and insert bytes, and a peer can
+ *  be cancelled from its "keyboard", all decided by a seeded generator, so a
+ *  run is repeated exactly by repeating the seed.  What crosses the medium
+ *  can be recorded, as text, to compare two runs.
+ */
+
+#ifndef CORELINK_H_
+#define CORELINK_H_
+
+#include <string>
+#include <functional>
+#include <cstdio>
+
+#include "SenderYCore.h"
+#include "ReceiverYCore.h"
+#include "PeerY.h"
+
+// what can go wrong on a CoreLink, each with a chance in a thousand
+struct LinkFaults {
+	unsigned seed{0};			// 0 for a perfect medium
+	unsigned dropPerMil{0};		// a byte is lost
+	unsigned flipPerMil{0};		// a byte is corrupted
+	unsigned strayPerMil{0};	// a stray CAN, ACK or NAK follows a byte
+	unsigned cancelPerMil{0};	// a peer is cancelled from its keyboard, at each step
+};
+
+class CoreLink {
+public:
+	CoreLink(SenderYCore& sender, ReceiverYCore& receiver, const LinkFaults& faults = LinkFaults())
+		: sender(sender), receiver(receiver), faults(faults), random(faults.seed)
+	{
+		sender.setFileHandler(PeerY::fileRequest);
+		receiver.setFileHandler(PeerY::fileRequest);
+	}
+
+	bool recording{false};	// record what crosses the medium into trace
+	std::string trace;
+	long long now{0};		// the simulated time, in microseconds
+	unsigned steps{0};
+
+	/* Called after each tick() of a core, once its output has been taken, as when
+	 *  a host could take a snapshot.  Returning true stops run(). */
+	std::function<bool(PeerYCore&)> afterTick;
+
+	// run both cores until both have finished.  Return false if they stop making
+	//  progress, or are stopped by afterTick.
+	bool run(unsigned maxSteps = 10000000)
+	{
+		while (sender.running() || receiver.running()) {
+			if (++steps > maxSteps)
+				return false;
+			bool moved{false};
+			moved |= step(sender, receiver, '[');
+			if (stopped)
+				return false;
+			moved |= step(receiver, sender, '(');
+			if (stopped)
+				return false;
+			if (moved)
+				continue;
+			long long next{-1};
+			for (PeerYCore* core: {(PeerYCore*) &sender, (PeerYCore*) &receiver}) {
+				long long deadline{core->running() ? core->deadline() : -1};
+				if (deadline >= 0 && (next < 0 || deadline < next))
+					next = deadline;
+			}
+			if (next < 0)
+				return false;
+			now = next > now ? next : now;
+			pending[0] = pending[1] = true;
+		}
+		return true;
+	}
+
+private:
+	SenderYCore& sender;
+	ReceiverYCore& receiver;
+	LinkFaults faults;
+	unsigned random;
+	bool pending[2]{true, true}; // does the core need a tick() at now?
+	bool stopped{false};
+
+	unsigned perMil()
+	{
+		random = random * 1103515245 + 12345;
+		return (random >> 16) % 1000;
+	}
+
+	// tick from, if it needs it, and pass what it sends to to.  Return true if anything happened.
+	bool step(PeerYCore& from, PeerYCore& to, char tag)
+	{
+		bool& fromPending{pending[&from == &receiver]};
+		bool& toPending{pending[&to == &receiver]};
+		if (!from.running() || !fromPending)
+			return false;
+		fromPending = false;
+		if (faults.seed && faults.cancelPerMil && perMil() < faults.cancelPerMil)
+			from.cancel();
+		from.tick(now);
+		std::string& out{from.output()};
+		if (!out.empty()) {
+			std::string sent;
+			for (char c: out) {
+				if (faults.seed && perMil() < faults.dropPerMil)
+					continue;
+				if (faults.seed && perMil() < faults.flipPerMil)
+					c ^= 1 << perMil() % 8;
+				sent += c;
+				if (faults.seed && perMil() < faults.strayPerMil)
+					sent += "\x18\x06\x15"[perMil() % 3];
+			}
+			if (recording)
+				record(tag, out, sent);
+			if (to.wantsInput() && !sent.empty()) {
+				to.input(sent.data(), sent.size());
+				toPending = true;
+			}
+			out.clear();
+		}
+		if (recording && !from.consoleOutput().empty())
+			trace += "console " + from.consoleOutput() + "\n";
+		from.consoleOutput().clear();
+		if (afterTick && afterTick(from))
+			stopped = true;
+		if (from.wantsDrain()) {
+			from.mediumDrained(); // everything sent has already arrived
+			fromPending = true;
+		}
+		return true;
+	}
+
+	void record(char tag, const std::string& out, const std::string& sent)
+	{
+		char line[32];
+		snprintf(line, sizeof(line), "%c%lld %zu", tag, now, out.size());
+		trace += line;
+		for (unsigned char c: sent) {
+			snprintf(line, sizeof(line), " %02x", c);
+			trace += line;
+		}
+		trace += '\n';
+	}
+};
+
+#endif /* CORELINK_H_ */
@@ -0,0 +1,146 @@
+//============================================================================
+// File Name   : DrainLowWaterTest.cpp
+// Description : Draining to a low-water mark (myTcdrainTo(), myDrainedTo()
+//               and myDrainNotifyD()) on socketpairs, channels and, but for
+//               myDrainNotifyD(), shared memory links: marks of 0, within
+//               and beyond the backlog, two drainers with different marks,
+//               and the notify descriptor becoming readable at the mark.
+//============================================================================
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+enum Kind { SOCKETPAIR, CHANNEL, SHM };
+static const char* kindNames[]{"socketpair", "channel", "shm"};
+
+static void makePair(Kind kind, int d[2])
+{
+	if (SOCKETPAIR == kind)
+		CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+	else if (CHANNEL == kind)
+		CHECK(0 == myChannelpair(d, 4096));
+	else
+		CHECK(0 == myShmpair(d, 4096));
+}
+
+static bool readable(int d)
+{
+	struct pollfd pfd{d, POLLIN, 0};
+	return 1 == poll(&pfd, 1, 0);
+}
+
+// wait until count threads have called a drain on d (statistics are on)
+static void drainersIn(int d, unsigned long long count)
+{
+	myIOStats stats{};
+	auto start{chrono::steady_clock::now()};
+	while (0 == myStats(d, &stats) && stats.drains < count && testutil::secondsSince(start) < 5)
+		this_thread::sleep_for(chrono::milliseconds(1));
+	CHECK(stats.drains == count);
+}
+
+// marks of 0, within the backlog and at or beyond it, with nothing read
+static void marks(Kind kind)
+{
+	int d[2];
+	makePair(kind, d);
+	char buf[100]{};
+	CHECK(1 == myDrainedTo(d[0], 0));
+	CHECK(100 == myWrite(d[0], buf, 100));
+	CHECK(0 == myDrainedTo(d[0], 0) && 0 == myDrained(d[0]));
+	CHECK(0 == myDrainedTo(d[0], 99));
+	CHECK(1 == myDrainedTo(d[0], 100) && 1 == myDrainedTo(d[0], 1000));
+	auto start{chrono::steady_clock::now()};
+	CHECK(0 == myTcdrainTo(d[0], 100) && 0 == myTcdrainTo(d[0], 1000)); // without waiting
+	CHECK(testutil::secondsSince(start) < 0.1);
+
+	// a reader taking 10 bytes every 10 ms, down to a mark of 30 and then to 0
+	thread reader([d] {
+		char in[10];
+		for (int i{0}; i < 10; ++i) {
+			this_thread::sleep_for(chrono::milliseconds(10));
+			CHECK(10 == myRead(d[1], in, sizeof(in)));
+		}
+	});
+	CHECK(0 == myTcdrainTo(d[0], 30));
+	CHECK(1 == myDrainedTo(d[0], 30) && 0 == myDrainedTo(d[0], 0)); // 30 ms of reading left
+	CHECK(0 == myTcdrainTo(d[0], 0));
+	CHECK(1 == myDrained(d[0]));
+	reader.join();
+	myClose(d[0]);
+	myClose(d[1]);
+}
+
+// readers notify at the larger mark, so the drainer with the smaller one waits again
+static void twoDrainers(Kind kind)
+{
+	int d[2];
+	makePair(kind, d);
+	char buf[100]{};
+	CHECK(100 == myWrite(d[0], buf, 100));
+	atomic<bool> fiftyDone{false}, tenDone{false};
+	thread fifty([&] { myTcdrainTo(d[0], 50); fiftyDone = true; });
+	thread ten([&] { myTcdrainTo(d[0], 10); tenDone = true; });
+	drainersIn(d[0], 2);
+
+	CHECK(40 == myRead(d[1], buf, 40)); // 60 left
+	this_thread::sleep_for(chrono::milliseconds(50));
+	CHECK(!fiftyDone && !tenDone);
+	CHECK(20 == myRead(d[1], buf, 20)); // 40 left: past 50 but not 10
+	fifty.join();
+	this_thread::sleep_for(chrono::milliseconds(50));
+	CHECK(!tenDone);
+	CHECK(20 == myRead(d[1], buf, 20)); // 20 left
+	this_thread::sleep_for(chrono::milliseconds(50));
+	CHECK(!tenDone);
+	CHECK(10 == myRead(d[1], buf, 10)); // 10 left
+	ten.join();
+	CHECK(tenDone);
+	myClose(d[0]);
+	myClose(d[1]);
+}
+
+// the notify descriptor becomes readable at the mark, and each call waits for the next drain
+static void notify(Kind kind)
+{
+	int d[2];
+	makePair(kind, d);
+	char buf[100]{};
+	CHECK(100 == myWrite(d[0], buf, 100));
+	int notifyD{myDrainNotifyD(d[0], 40)};
+	CHECK(-1 != notifyD && !readable(notifyD));
+	CHECK(50 == myRead(d[1], buf, 50)); // 50 left
+	CHECK(!readable(notifyD));
+	CHECK(10 == myRead(d[1], buf, 10)); // 40 left, the mark
+	CHECK(readable(notifyD));
+
+	CHECK(notifyD == myDrainNotifyD(d[0], 40) && readable(notifyD)); // already drained that far
+	CHECK(notifyD == myDrainNotifyD(d[0], 0) && !readable(notifyD)); // the earlier drain forgotten
+	CHECK(40 == myRead(d[1], buf, 40));
+	CHECK(readable(notifyD));
+	myClose(d[0]);
+	myClose(d[1]);
+}
+
+int main()
+{
+	myStatsEnable(true);
+	for (Kind kind: {SOCKETPAIR, CHANNEL, SHM}) {
+		int before{testutil::failures};
+		marks(kind);
+		twoDrainers(kind);
+		if (SHM != kind)
+			notify(kind);
+		if (testutil::failures != before)
+			cerr << "  with a " << kindNames[kind] << endl;
+	}
+	return testutil::result();
+}
@@ -0,0 +1,72 @@
+//============================================================================
+// File Name   : IOStatsBench.cpp
+// Description : What keeping the per-descriptor I/O statistics of myIO
+//               (myStatsEnable()) costs.
+//
+// IOStatsBench [pairs [seconds]]
+//   for pairs socketpairs (default 4), each in a thread of its own, bounces
+//   16 bytes back and forth for seconds seconds (default 1) with myWrite(),
+//   myReadcond(), myDrained() and myRead(), with statistics off, on, and off
+//   again, and reports the round trips per second for each.
+//============================================================================
+
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "myIO.h"
+
+using namespace std;
+
+// thousands of round trips per second
+static double roundTrips(int pairs, double seconds)
+{
+	atomic<bool> stop{false};
+	atomic<long long> count{0};
+	vector<thread> threads;
+	for (int i{0}; i < pairs; ++i)
+		threads.emplace_back([&] {
+			int d[2];
+			if (-1 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d))
+				return;
+			char buf[16]{};
+			long long n{0};
+			while (!stop.load(memory_order_relaxed)) {
+				myWrite(d[0], buf, sizeof(buf));
+				myReadcond(d[1], buf, sizeof(buf), sizeof(buf), 0, 0);
+				myDrained(d[0]);
+				myWrite(d[1], buf, sizeof(buf));
+				myRead(d[0], buf, sizeof(buf));
+				++n;
+			}
+			count += n;
+			myClose(d[0]);
+			myClose(d[1]);
+		});
+	this_thread::sleep_for(chrono::duration<double>(seconds));
+	stop = true;
+	for (auto& t: threads)
+		t.join();
+	return count / seconds / 1000;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [pairs [seconds]]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	int pairs{argc > 1 ? atoi(argv[1]) : 4};
+	double seconds{argc > 2 ? atof(argv[2]) : 1.0};
+
+	printf("%u CPUs, %d pairs, k round trips/s\n", thread::hardware_concurrency(), pairs);
+	for (bool collect: {false, true, false}) {
+		myStatsEnable(collect);
+		printf("statistics %-3s %8.1f\n", collect ? "on" : "off", roundTrips(pairs, seconds));
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+//============================================================================
+// File Name   : IOStatsTest.cpp
+// Description : The per-descriptor I/O statistics of myIO (myStatsEnable()
+//               and myStats()): for single calls on a socketpair, for calls
+//               that wait for data or for a drain, and for whole transfers
+//               of sessions run by a Reactor.
+//============================================================================
+
+#include <sys/socket.h>
+#include <sys/stat.h>		// for mkdir()
+#include <thread>
+#include <vector>
+#include <string>
+#include <cerrno>
+
+#include "Reactor.h"
+#include "SenderY.h"
+#include "ReceiverY.h"
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static myIOStats statsOf(int des)
+{
+	myIOStats stats{};
+	CHECK(0 == myStats(des, &stats));
+	return stats;
+}
+
+// descriptors without statistics
+static void noStats()
+{
+	myStatsEnable(false);
+	int d[2];
+	CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+	myIOStats stats;
+	CHECK(-1 == myStats(d[0], &stats) && ENODATA == errno);
+	CHECK(-1 == myStats(STDIN_FILENO, &stats) && EBADF == errno);
+	myClose(d[0]);
+	myClose(d[1]);
+}
+
+// calls that do not wait, one that waits for data and a drain that stalls
+static void counts()
+{
+	myStatsEnable(true);
+	int d[2];
+	CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+	char buf[16]{};
+	CHECK(10 == myWrite(d[0], buf, 10));
+	CHECK(10 == myReadcond(d[1], buf, 10, 10, 0, 0));
+	myIOStats out{statsOf(d[0])}, in{statsOf(d[1])};
+	CHECK(10 == out.bytesOut && 1 == out.writes && 0 == out.reads && 0 == out.waits);
+	CHECK(10 == in.bytesIn && 1 == in.reads && 0 == in.writes && 0 == in.waits);
+
+	// a read waiting about 50 ms for a byte
+	thread writer([&] {
+		this_thread::sleep_for(chrono::milliseconds(50));
+		myWrite(d[0], buf, 1);
+	});
+	CHECK(1 == myReadcond(d[1], buf, 1, 1, 0, 20));
+	writer.join();
+	in = statsOf(d[1]);
+	CHECK(11 == in.bytesIn && 2 == in.reads && 1 == in.waits);
+	CHECK(in.waitNsecs >= 40000000 && in.maxWaitNsecs == in.waitNsecs);
+
+	// a drain waiting about 50 ms for its byte to be read
+	CHECK(1 == myWrite(d[0], buf, 1));
+	thread reader([&] {
+		this_thread::sleep_for(chrono::milliseconds(50));
+		myReadcond(d[1], buf, 1, 1, 0, 0);
+	});
+	CHECK(0 == myTcdrain(d[0]));
+	reader.join();
+	out = statsOf(d[0]);
+	CHECK(12 == out.bytesOut && 3 == out.writes && 1 == out.drains);
+	CHECK(1 == out.drainStalls && 1 == out.waits && out.waitNsecs >= 40000000);
+	myClose(d[0]);
+	myClose(d[1]);
+	myStatsEnable(false);
+}
+
+// what each end of a transfer wrote, the other end read
+static void transfers(int pairs)
+{
+	myStatsEnable(true);
+	mkdir("src", 0755);
+	vector<string> names;
+	vector<int> senderDs, receiverDs;
+	Reactor reactor;
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	int done{0};
+	for (int i{0}; i < pairs; ++i) {
+		names.push_back("src/f" + to_string(i));
+		testutil::makeFile(names.back(), 1000 + 700 * i, i + 1);
+	}
+	for (auto& name: names) {
+		int d[2];
+		CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+		senderDs.push_back(d[0]);
+		receiverDs.push_back(d[1]);
+		auto sender{make_shared<SenderY>(vector<const char*>{name.c_str()}, d[0], -1, 1, cfg)};
+		auto receiver{make_shared<ReceiverY>(d[1], -1, 1, cfg)};
+		sender->beginSendFiles();
+		receiver->beginReceiveFiles();
+		auto count{[&done](PeerY& peer) {
+			if (peer.result == "Done, EndOfSession")
+				++done;
+		}};
+		reactor.add(sender, count);
+		reactor.add(receiver, count);
+	}
+	CHECK(0 == reactor.run());
+	CHECK(2 * pairs == done);
+	for (int i{0}; i < pairs; ++i) {
+		myIOStats sender{statsOf(senderDs[i])}, receiver{statsOf(receiverDs[i])};
+		CHECK(sender.bytesOut == receiver.bytesIn && receiver.bytesOut == sender.bytesIn);
+		CHECK(sender.bytesOut > 1000u + 700 * i);
+		CHECK(sender.writes > 0 && sender.reads > 0 && receiver.writes > 0 && receiver.reads > 0);
+		CHECK(sender.maxWaitNsecs <= sender.waitNsecs && receiver.maxWaitNsecs <= receiver.waitNsecs);
+		myClose(senderDs[i]);
+		myClose(receiverDs[i]);
+	}
+	myStatsEnable(false);
+}
+
+int main()
+{
+	testutil::scratchDir();
+	noStats();
+	counts();
+	transfers(4);
+	return testutil::result();
+}
@@ -0,0 +1,179 @@
+//============================================================================
+// File Name   : InjectTest.cpp
+// Description : Events injected by other threads into the statechart of a
+//               running session (PeerYCore::session()): they wake a Reactor
+//               waiting for the session's timeout, those from several threads
+//               at once are each delivered once and in the order each thread
+//               injected them, and those that did not fit in the inbox are
+//               the ones inject() reported as dropped.
+//============================================================================
+
+#include <sys/socket.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+
+#include "Reactor.h"
+#include "ReceiverYCore.h"
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// a chart that runs another, but records the injected events instead of posting them
+class Recorder : public SessionChart {
+public:
+	explicit Recorder(shared_ptr<SessionChart> chart) : chart(move(chart)) {}
+	void start() override { chart->start(); }
+	void postEvent(unsigned int event, int wParam) override { chart->postEvent(event, wParam); }
+	bool isRunning() const override { return chart->isRunning(); }
+	int drainInjected() override
+	{
+		int n{0};
+		unsigned int event;
+		int wParam;
+		while (inbox.pop(event, wParam)) {
+			delivered.push_back(wParam);
+			++n;
+		}
+		deliveredCount = delivered.size();
+		return n;
+	}
+	bool hasInjected() const override { return !inbox.empty(); }
+	size_t snapshot(uint8_t* buf, size_t n) const override { return chart->snapshot(buf, n); }
+	bool restore(const uint8_t* buf, size_t n) override { return chart->restore(buf, n); }
+
+	vector<int> delivered; // the wParam of each injected event, in the order delivered
+	atomic<size_t> deliveredCount{0}; // delivered.size(), for other threads
+
+protected:
+	bool pushInjected(unsigned int event, int wParam) override { return inbox.push(event, wParam); }
+
+private:
+	shared_ptr<SessionChart> chart;
+	smartstate::EventInbox inbox;
+};
+
+// a receiver whose statechart is wrapped in a Recorder
+class RecordingReceiver : public ReceiverYCore {
+public:
+	using ReceiverYCore::ReceiverYCore;
+	shared_ptr<Recorder> begin()
+	{
+		auto recorder{make_shared<Recorder>(receiveFilesChart())};
+		beginSession(recorder, false);
+		return recorder;
+	}
+};
+
+// a receiver on a socketpair with no sender, so that it waits seconds between its 'C's
+struct Session {
+	Session()
+	{
+		cfg.senderReportInfo = cfg.receiverReportInfo = false;
+		cfg.fastSim(false);
+		CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+		receiver = make_unique<RecordingReceiver>(cfg);
+		receiver->setFileHandler(PeerY::fileRequest);
+		recorder = receiver->begin();
+		reactor.add(make_shared<PeerY>(*receiver, d[0], -1, -1));
+		reactor.runOnce(0); // start it
+	}
+	~Session()
+	{
+		myClose(d[0]);
+		myClose(d[1]);
+	}
+
+	PeerYConfig cfg;
+	int d[2];
+	unique_ptr<RecordingReceiver> receiver;
+	shared_ptr<Recorder> recorder;
+	Reactor reactor;
+};
+
+// a Reactor blocked until the receiver's next timeout is woken by an injected event
+static void wake()
+{
+	Session s;
+	auto chart{s.receiver->session()};
+	thread injector([chart] {
+		this_thread::sleep_for(chrono::milliseconds(100));
+		CHECK(chart->inject(0, 7));
+	});
+	auto start{chrono::steady_clock::now()};
+	while (s.recorder->delivered.empty() && testutil::secondsSince(start) < 5)
+		CHECK(0 == s.reactor.runOnce());
+	injector.join();
+	CHECK(testutil::secondsSince(start) < 1);
+	CHECK(s.recorder->delivered == vector<int>{7});
+	CHECK(s.receiver->running());
+}
+
+// several threads inject at once while the Reactor runs the session
+static void concurrent(int threads, int each)
+{
+	Session s;
+	auto chart{s.receiver->session()};
+	atomic<int> accepted{0}, dropped{0}, finished{0};
+	vector<thread> injectors;
+	for (int t{0}; t < threads; ++t)
+		injectors.emplace_back([&, t] {
+			for (int i{0}; i < each; ++i) {
+				if (chart->inject(0, t * each + i))
+					++accepted;
+				else {
+					++dropped;
+					this_thread::yield();
+				}
+			}
+			++finished;
+		});
+	auto start{chrono::steady_clock::now()};
+	while ((finished < threads || s.recorder->deliveredCount < (size_t) accepted)
+			&& testutil::secondsSince(start) < 10)
+		CHECK(0 == s.reactor.runOnce(100000));
+	for (auto& t: injectors)
+		t.join();
+
+	auto& delivered{s.recorder->delivered};
+	CHECK(accepted + dropped == threads * each);
+	CHECK(delivered.size() == (size_t) accepted);
+	vector<int> last(threads, -1);
+	for (int wParam: delivered) {
+		int t{wParam / each};
+		CHECK(t >= 0 && t < threads && wParam > last[t]); // once each, in order
+		last[t] = wParam;
+	}
+	CHECK(!chart->hasInjected());
+}
+
+// with no one draining the inbox, what does not fit is dropped, and the rest still delivered
+static void overflow()
+{
+	Session s;
+	auto chart{s.receiver->session()};
+	const int extra{5};
+	int dropped{0};
+	thread injector([&] {
+		for (int i{0}; i < SS_INBOX_SIZE + extra; ++i)
+			dropped += !chart->inject(0, i);
+	});
+	injector.join();
+	CHECK(extra == dropped);
+	CHECK(0 == s.reactor.runOnce(1000000));
+	vector<int> expected;
+	for (int i{0}; i < SS_INBOX_SIZE; ++i)
+		expected.push_back(i);
+	CHECK(s.recorder->delivered == expected);
+}
+
+int main()
+{
+	testutil::scratchDir();
+	wake();
+	concurrent(4, 5000);
+	overflow();
+	return testutil::result();
+}
@@ -0,0 +1,99 @@
+//============================================================================
+// File Name   : MyReadcondTest.cpp
+// Description : myReadcond() on a socketpair, a channel and a shared memory
+//               link, as readcond() in QNX: time is an inter-character timer,
+//               restarted whenever bytes arrive, timeout limits the whole
+//               read, and with min 0 the timer starts at once.
+//============================================================================
+
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+enum Kind { SOCKETPAIR, CHANNEL, SHM };
+static const char* kindNames[]{"socketpair", "channel", "shm"};
+
+static void makePair(Kind kind, int d[2])
+{
+	if (SOCKETPAIR == kind)
+		CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+	else if (CHANNEL == kind)
+		CHECK(0 == myChannelpair(d, 4096));
+	else
+		CHECK(0 == myShmpair(d, 4096));
+}
+
+// write a byte to des after each of the gaps (in milliseconds)
+static thread trickle(int des, vector<int> gaps)
+{
+	return thread([des, gaps] {
+		for (int gap: gaps) {
+			this_thread::sleep_for(chrono::milliseconds(gap));
+			CHECK(1 == myWrite(des, "x", 1));
+		}
+	});
+}
+
+static void timing(Kind kind)
+{
+	int d[2];
+	makePair(kind, d);
+	char buf[16];
+
+	// bytes 100 ms apart, 500 ms in all, are read within a time of 3 deciseconds
+	auto start{chrono::steady_clock::now()};
+	thread writer{trickle(d[0], {100, 100, 100, 100, 100})};
+	CHECK(5 == myReadcond(d[1], buf, sizeof(buf), 5, 3, 0));
+	CHECK(testutil::secondsSince(start) > 0.45);
+	writer.join();
+
+	// a gap longer than time ends the read with what has come
+	start = chrono::steady_clock::now();
+	writer = trickle(d[0], {50, 50, 800});
+	CHECK(2 == myReadcond(d[1], buf, sizeof(buf), 5, 3, 0));
+	double secs{testutil::secondsSince(start)};
+	CHECK(secs > 0.35 && secs < 0.7); // 0.1 for the bytes, then 0.3 with nothing
+	writer.join();
+	CHECK(1 == myReadcond(d[1], buf, sizeof(buf), 0, 0, 0));
+
+	// timeout cuts off a read whose bytes keep coming within time
+	start = chrono::steady_clock::now();
+	writer = trickle(d[0], {100, 100, 100, 100, 100});
+	int n{myReadcond(d[1], buf, sizeof(buf), 5, 3, 3)};
+	secs = testutil::secondsSince(start);
+	CHECK(n >= 2 && n < 5);
+	CHECK(secs > 0.25 && secs < 0.45);
+	writer.join();
+	CHECK(5 - n == myReadcond(d[1], buf, sizeof(buf), 0, 0, 0));
+
+	// with min 0 the timer starts at once, and a byte ends the wait
+	start = chrono::steady_clock::now();
+	CHECK(0 == myReadcond(d[1], buf, sizeof(buf), 0, 2, 0));
+	secs = testutil::secondsSince(start);
+	CHECK(secs > 0.15 && secs < 0.4);
+	start = chrono::steady_clock::now();
+	writer = trickle(d[0], {50});
+	CHECK(1 == myReadcond(d[1], buf, sizeof(buf), 0, 5, 0));
+	CHECK(testutil::secondsSince(start) < 0.3);
+	writer.join();
+
+	myClose(d[0]);
+	myClose(d[1]);
+}
+
+int main()
+{
+	for (Kind kind: {SOCKETPAIR, CHANNEL, SHM}) {
+		int before{testutil::failures};
+		timing(kind);
+		if (testutil::failures != before)
+			cerr << "  with a " << kindNames[kind] << endl;
+	}
+	return testutil::result();
+}
@@ -0,0 +1,88 @@
+//============================================================================
+// File Name   : PostEventBench.cpp
+// Description : Events per second through StateMgr::postEvent() of the real
+//               ySenderSS and yReceiverSS machines.
+//
+// PostEventBench [transfers [fileKiB]]
+//   runs transfers (default 200) of a file of fileKiB KiB (default 16) between
+//   a sender and a receiver core over a perfect in-memory medium (CoreLink.h),
+//   each on machines constructed once and reused.  It reports the events
+//   given to the machines, and the events per second while inside
+//   postEvent() (including the actions), for each machine.
+//============================================================================
+
+#include <sys/stat.h>		// for mkdir()
+#include <chrono>
+#include <memory>
+#include <cstdio>
+
+#include "ySenderSS.h"
+#include "yReceiverSS.h"
+#include "CoreLink.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// a machine whose postEvent() counts the events, and the time spent in them
+template<class Machine>
+class Timed: public Machine {
+public:
+	Timed(): Machine(nullptr, false) {}
+
+	void postEvent(unsigned int message, int wParam, int lParam) override
+	{
+		auto start{chrono::steady_clock::now()};
+		Machine::postEvent(message, wParam, lParam);
+		secs += testutil::secondsSince(start);
+		++events;
+	}
+
+	unsigned long events{0};
+	double secs{0};
+};
+
+typedef Timed<ySender_SS::ySenderSS> TimedSender;
+typedef Timed<yReceiver_SS::yReceiverSS> TimedReceiver;
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [transfers [fileKiB]]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	int transfers{argc > 1 ? atoi(argv[1]) : 200};
+	size_t fileKiB{argc > 2 ? (size_t) atoi(argv[2]) : 16};
+
+	testutil::scratchDir();
+	mkdir("src", 0755);
+	testutil::makeFile("src/file", fileKiB * 1024);
+
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	auto timedSender{make_shared<TimedSender>()};
+	auto timedReceiver{make_shared<TimedReceiver>()};
+	shared_ptr<ySender_SS::ySenderSS> senderSS{timedSender};
+	shared_ptr<yReceiver_SS::yReceiverSS> receiverSS{timedReceiver};
+
+	int ok{0};
+	auto start{chrono::steady_clock::now()};
+	for (int i{0}; i < transfers; ++i) {
+		SenderYCore sender({"src/file"}, cfg);
+		ReceiverYCore receiver(cfg);
+		sender.shareChart(senderSS);
+		receiver.shareChart(receiverSS);
+		sender.beginSendFiles();
+		receiver.beginReceiveFiles();
+		CoreLink link(sender, receiver);
+		if (link.run() && sender.result == "Done, EndOfSession" && receiver.result == "Done, EndOfSession")
+			++ok;
+	}
+	double secs{testutil::secondsSince(start)};
+
+	printf("%d/%d transfers ok, %.3f s\n", ok, transfers, secs);
+	printf("sender:   %lu events, %.0f events/s in postEvent()\n",
+		timedSender->events, timedSender->events / timedSender->secs);
+	printf("receiver: %lu events, %.0f events/s in postEvent()\n",
+		timedReceiver->events, timedReceiver->events / timedReceiver->secs);
+	return ok == transfers ? EXIT_SUCCESS : EXIT_FAILURE;
+}
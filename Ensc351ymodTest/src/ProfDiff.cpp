@@ -0,0 +1,34 @@
+//============================================================================
+// File Name   : ProfDiff.cpp
+// Description : Compare two files of SmartState statechart profiles.
+//
+// ProfDiff before after
+//   sums the profiles in each file, as written with YMODEM_SM_PROFILE=1 (to
+//   SenderSS.prof and ReceiverSS.prof in YMODEM_SM_DIR, /tmp by default),
+//   and prints the states and transitions whose counts or times changed.
+//   See StateProfile::diff() in ss_api.hxx.
+//============================================================================
+
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ss_api.hxx"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+	if (argc != 3 || argv[1][0] == '-') {
+		printf("usage: %s before after\n", argv[0]);
+		return argc == 2 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	ifstream before(argv[1]), after(argv[2]);
+	if (!before.is_open() || !after.is_open()) {
+		cerr << "Cannot read the profile files" << endl;
+		return EXIT_FAILURE;
+	}
+	smartstate::StateProfile::diff(before, after, cout);
+	return EXIT_SUCCESS;
+}
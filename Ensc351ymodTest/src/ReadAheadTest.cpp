@@ -0,0 +1,76 @@
+//============================================================================
+// File Name   : ReadAheadTest.cpp
+// Description : How long a receiver core waits for the rest of a block after
+//               its SOH:  a character time (TM_CHAR) with nothing arriving,
+//               restarted by each byte that arrives, but no more than TM_BLK
+//               in all.  The statechart and the coroutine form must agree.
+//============================================================================
+
+#include <cstdio>
+
+#include "ReceiverYCore.h"
+#include "PeerY.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static const long long USECS_PER_UNIT{uSECS_PER_UNIT};
+
+// give core an SOH and then a byte every gapUnits, and return when it stops
+//  waiting for the rest of the block (when the SOH is handled), relative to the SOH
+static long long waited(bool coroutine, int gapUnits, int bytes)
+{
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	ReceiverYCore core(cfg);
+	core.setFileHandler(PeerY::fileRequest);
+	if (coroutine)
+		core.beginReceiveFilesCo();
+	else
+		core.beginReceiveFiles();
+	core.tick(0); // sends 'C'
+	core.output().clear();
+
+	const long long soh{USECS_PER_UNIT};
+	const uint8_t sohByte{SOH}, other{0};
+	core.input(&sohByte, 1);
+	core.tick(soh);
+	long long now{soh};
+	for (int i{0}; i < bytes; ++i) {
+		long long next{now + gapUnits * USECS_PER_UNIT};
+		// while waiting for the block, the core wakes no later than the earlier timer
+		if (core.deadline() <= next)
+			break;
+		now = next;
+		core.input(&other, 1);
+		core.tick(now);
+	}
+	// run to the deadline; the SOH is handled then (and the short block is NAKed)
+	while (core.output().empty() && core.running()) {
+		long long deadline{core.deadline()};
+		if (deadline < 0)
+			return -1;
+		now = deadline > now ? deadline : now;
+		core.tick(now);
+	}
+	return now - soh;
+}
+
+int main()
+{
+	testutil::scratchDir();
+	PeerYConfig cfg;
+	const long long tmChar{cfg.tmChar * USECS_PER_UNIT}, tmBlk{cfg.tmBlk * USECS_PER_UNIT};
+	CHECK(tmChar < tmBlk);
+
+	for (bool coroutine: {false, true}) {
+		// nothing after the SOH:  a character time
+		CHECK(waited(coroutine, 1, 0) == tmChar);
+		// bytes arriving faster than the character time keep it waiting, but only up to TM_BLK
+		CHECK(waited(coroutine, cfg.tmChar / 2, 5) == 5 * cfg.tmChar / 2 * USECS_PER_UNIT + tmChar);
+		CHECK(waited(coroutine, cfg.tmChar / 2, 100) == tmBlk);
+		// a gap of more than the character time ends it
+		CHECK(waited(coroutine, cfg.tmChar * 2, 5) == tmChar);
+	}
+	return testutil::result();
+}
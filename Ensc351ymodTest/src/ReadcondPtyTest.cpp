@@ -0,0 +1,118 @@
+//============================================================================
+// File Name   : ReadcondPtyTest.cpp
+// Description : readcond() (readcond.h) on the slave side of a pty, with its
+//               termios settings changed on each call and within a
+//               readcondBegin()/readcondEnd() session.  Both must give the
+//               same counts and timings.
+//============================================================================
+
+#include <unistd.h>
+#include <termios.h>
+#include <pty.h>			// for openpty()
+#include <thread>
+#include <cstdio>
+
+#include "readcond.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static int master, slave;
+
+// write a byte to the master side every 50 ms, 5 times
+static thread trickle()
+{
+	return thread([] {
+		for (int i{0}; i < 5; ++i) {
+			this_thread::sleep_for(chrono::milliseconds(50));
+			CHECK(1 == write(master, "x", 1));
+		}
+	});
+}
+
+// wait for the trickle to end, and discard what is left of it
+static void finish(thread& writer)
+{
+	writer.join();
+	this_thread::sleep_for(chrono::milliseconds(50));
+	char buf[100];
+	readcond(slave, buf, sizeof(buf), 0, 0, 0);
+}
+
+static double deciseconds(chrono::steady_clock::time_point start)
+{
+	return testutil::secondsSince(start) * 10;
+}
+
+static void cases(const char* label)
+{
+	char buf[100];
+	int failuresBefore{testutil::failures};
+
+	// min 0 returns at once, with or without data
+	CHECK(0 == readcond(slave, buf, sizeof(buf), 0, 0, 0));
+	CHECK(3 == write(master, "abc", 3));
+	this_thread::sleep_for(chrono::milliseconds(10));
+	CHECK(3 == readcond(slave, buf, sizeof(buf), 0, 0, 0));
+
+	// a timeout with nothing arriving
+	auto start{chrono::steady_clock::now()};
+	CHECK(0 == readcond(slave, buf, sizeof(buf), 1, 0, 3));
+	double ds{deciseconds(start)};
+	CHECK(ds > 2.5 && ds < 5);
+
+	// a timeout with characters trickling in (all 5 by 2.5 ds):  it limits the whole call
+	start = chrono::steady_clock::now();
+	thread writer{trickle()};
+	CHECK(5 == readcond(slave, buf, sizeof(buf), 10, 0, 4));
+	ds = deciseconds(start);
+	CHECK(ds > 3.5 && ds < 6);
+	finish(writer);
+
+	// min 3 with no time blocks until it has 3
+	start = chrono::steady_clock::now();
+	writer = trickle();
+	CHECK(3 == readcond(slave, buf, sizeof(buf), 3, 0, 0));
+	ds = deciseconds(start);
+	CHECK(ds > 1.2 && ds < 3);
+	finish(writer);
+
+	// time is an inter-character timer:  bytes 50 ms apart keep a time of 1 going
+	start = chrono::steady_clock::now();
+	writer = trickle();
+	CHECK(5 == readcond(slave, buf, sizeof(buf), 10, 1, 20));
+	ds = deciseconds(start);
+	CHECK(ds > 3 && ds < 6);
+	finish(writer);
+
+	// min 0 with a time waits that long for a byte
+	start = chrono::steady_clock::now();
+	CHECK(0 == readcond(slave, buf, sizeof(buf), 0, 2, 0));
+	ds = deciseconds(start);
+	CHECK(ds > 1.5 && ds < 4);
+
+	if (testutil::failures != failuresBefore)
+		cerr << "with " << label << endl;
+}
+
+int main()
+{
+	if (-1 == openpty(&master, &slave, nullptr, nullptr, nullptr)) {
+		perror("openpty");
+		return EXIT_FAILURE;
+	}
+	// the master side passes bytes as they are
+	struct termios raw;
+	CHECK(0 == tcgetattr(master, &raw));
+	cfmakeraw(&raw);
+	CHECK(0 == tcsetattr(master, TCSANOW, &raw));
+
+	cases("the settings changed on each call");
+	CHECK(0 == readcondBegin(slave));
+	cases("readcondBegin()");
+	CHECK(0 == readcondEnd(slave));
+
+	close(slave);
+	close(master);
+	return testutil::result();
+}
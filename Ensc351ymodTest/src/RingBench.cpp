@@ -0,0 +1,85 @@
+//============================================================================
+// File Name   : RingBench.cpp
+// Description : Throughput of SpscRing against CircBuf (both in
+//               RageUtil_CircularBuffer.h), one writer and one reader.
+//
+// RingBench [MiB [chunk ...]]
+//   for each chunk size (default 1, 16, 64 and 1024 bytes), moves MiB MiB
+//   (default 64) through a 64 KiB buffer of each kind, written by one thread
+//   and read by another, chunk bytes at a time.  It reports MB/s, and checks
+//   that the bytes arrive in order.
+//============================================================================
+
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "RageUtil_CircularBuffer.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// MB/s through ring, or 0 if the bytes are not those written
+template<class Ring>
+static double throughput(Ring& ring, unsigned chunk, unsigned long long total)
+{
+	// byte i of the stream is i % 256, so a chunk from position i is pattern + i % 256
+	vector<char> pattern(chunk + 256);
+	for (size_t i{0}; i < pattern.size(); ++i)
+		pattern[i] = (char) i;
+
+	auto start{chrono::steady_clock::now()};
+	thread writer([&] {
+		unsigned long long written{0};
+		while (written < total) {
+			unsigned n{ring.write(pattern.data() + written % 256, (unsigned) min<unsigned long long>(chunk, total - written))};
+			if (!n)
+				this_thread::yield();
+			written += n;
+		}
+	});
+	vector<char> buf(chunk);
+	unsigned long long got{0};
+	bool inOrder{true};
+	while (got < total) {
+		unsigned n{ring.read(buf.data(), (unsigned) min<unsigned long long>(chunk, total - got))};
+		if (!n)
+			this_thread::yield();
+		else if (memcmp(buf.data(), pattern.data() + got % 256, n))
+			inOrder = false;
+		got += n;
+	}
+	writer.join();
+	double secs{testutil::secondsSince(start)};
+	return inOrder ? total / secs / 1e6 : 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [MiB [chunk ...]]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	unsigned long long total{(argc > 1 ? strtoull(argv[1], nullptr, 10) : 64) << 20};
+	vector<unsigned> chunks;
+	for (int i{2}; i < argc; ++i)
+		chunks.push_back(atoi(argv[i]));
+	if (chunks.empty())
+		chunks = {1, 16, 64, 1024};
+
+	printf("%u CPUs, %llu MiB through 64 KiB buffers, MB/s\n", thread::hardware_concurrency(), total >> 20);
+	bool ok{true};
+	for (unsigned chunk: chunks) {
+		CircBuf<char> circBuf;
+		circBuf.reserve(65536 - 1); // CircBuf keeps one byte free
+		SpscRing<char> spscRing;
+		spscRing.reserve(65536);
+		double circ{throughput(circBuf, chunk, total)};
+		double spsc{throughput(spscRing, chunk, total)};
+		ok &= circ && spsc;
+		printf("%5u-byte chunks: CircBuf %6.0f  SpscRing %6.0f\n", chunk, circ, spsc);
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
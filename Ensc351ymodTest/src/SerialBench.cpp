@@ -0,0 +1,122 @@
+//============================================================================
+// File Name   : SerialBench.cpp
+// Description : YMODEM throughput over the serial transport of myIO at
+//               realistic baud rates, on openpty() pairs.
+//
+// SerialBench [fileKiB [baud ...]]
+//   sends a file of fileKiB KiB (default 64) from a sender on one pty to a
+//   receiver on another, through a bridge between the master sides that
+//   paces each direction to baud/10 bytes per second, as the simulator's
+//   Medium does with YMODEM_SERIAL=1 (a pty itself ignores its baud rate).
+//   Baud 0 is unpaced.  The default rates are 57600, 115200, 230400 and 0.
+//   It reports the time and the bytes per second against the line's rate.
+//============================================================================
+
+#include <sys/stat.h>		// for mkdir()
+#include <pty.h>
+#include <poll.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Reactor.h"
+#include "SenderY.h"
+#include "ReceiverY.h"
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// copy what each master reads to the other, at most baud/10 bytes per second each way
+static void bridge(int master[2], unsigned baud)
+{
+	const nanoseconds perByte{baud ? 10000000000LL / baud : 0};
+	steady_clock::time_point sent[2]{steady_clock::now(), steady_clock::now()};
+	char buf[256];
+	while (true) {
+		struct pollfd ready[2]{{master[0], POLLIN, 0}, {master[1], POLLIN, 0}};
+		if (-1 == poll(ready, 2, -1))
+			return;
+		for (int i{0}; i < 2; ++i)
+			if (ready[i].revents) {
+				ssize_t n{read(master[i], buf, sizeof(buf))};
+				if (n <= 0)
+					return;
+				if (baud) {
+					sent[i] = max(sent[i], steady_clock::now()) + n * perByte;
+					this_thread::sleep_until(sent[i]);
+				}
+				if (n != write(master[1 - i], buf, n))
+					return;
+			}
+	}
+}
+
+// seconds for the transfer, or -1 if it failed
+static double transfer(unsigned baud)
+{
+	int master[2], slave[2];
+	for (int i{0}; i < 2; ++i)
+		if (-1 == openpty(&master[i], &slave[i], nullptr, nullptr, nullptr)
+			|| -1 == mySerialConfig(slave[i], baud ? baud : 230400, MY_FLOW_NONE))
+			return -1;
+	thread medium(bridge, master, baud);
+
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	auto sender{make_shared<SenderY>(vector<const char*>{"src/file"}, slave[0], -1, 1, cfg)};
+	auto receiver{make_shared<ReceiverY>(slave[1], -1, 1, cfg)};
+	sender->beginSendFiles();
+	receiver->beginReceiveFiles();
+	Reactor reactor;
+	reactor.add(sender);
+	reactor.add(receiver);
+	auto start{steady_clock::now()};
+	bool ok{0 == reactor.run() && receiver->result == "Done, EndOfSession"};
+	double secs{testutil::secondsSince(start)};
+
+	close(slave[0]);
+	close(slave[1]);
+	medium.join();
+	close(master[0]);
+	close(master[1]);
+	return ok ? secs : -1;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [fileKiB [baud ...]]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	size_t bytes{(argc > 1 ? (size_t) atoi(argv[1]) : 64) * 1024};
+	vector<unsigned> bauds{57600, 115200, 230400, 0};
+	if (argc > 2) {
+		bauds.clear();
+		for (int i{2}; i < argc; ++i)
+			bauds.push_back(atoi(argv[i]));
+	}
+
+	testutil::scratchDir();
+	mkdir("src", 0755);
+	testutil::makeFile("src/file", bytes);
+
+	bool ok{true};
+	for (unsigned baud: bauds) {
+		double secs{transfer(baud)};
+		if (secs < 0) {
+			printf("%6u baud: failed\n", baud);
+			ok = false;
+		}
+		else if (baud)
+			printf("%6u baud: %6.2f s, %6.0f B/s, %3.0f%% of the line's %u B/s\n",
+				baud, secs, bytes / secs, 100 * bytes / secs / (baud / 10), baud / 10);
+		else
+			printf("unpaced     : %6.2f s, %6.0f B/s\n", secs, bytes / secs);
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,120 @@
+//============================================================================
+// File Name   : SerialPtyTest.cpp
+// Description : The serial transport of myIO (mySerialConfig() and
+//               myOpenSerial()) on openpty() pairs: the termios settings,
+//               bad baud rates and devices, and a YMODEM transfer between
+//               two ptys joined by a bridge, as the simulator's Medium joins
+//               them with YMODEM_SERIAL=1.
+//============================================================================
+
+#include <sys/stat.h>		// for mkdir()
+#include <pty.h>
+#include <poll.h>
+#include <termios.h>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <cerrno>
+
+#include "Reactor.h"
+#include "SenderY.h"
+#include "ReceiverY.h"
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static string contents(const char* name)
+{
+	ifstream in(name);
+	ostringstream all;
+	all << in.rdbuf();
+	return all.str();
+}
+
+static void settings()
+{
+	int master, slave;
+	char name[64];
+	CHECK(0 == openpty(&master, &slave, name, nullptr, nullptr));
+	for (int flow: {MY_FLOW_NONE, MY_FLOW_RTSCTS, MY_FLOW_XONXOFF}) {
+		int d{myOpenSerial(name, 9600, flow)};
+		CHECK(d >= 0);
+		struct termios termio;
+		CHECK(0 == tcgetattr(d, &termio));
+		CHECK(B9600 == cfgetospeed(&termio) && B9600 == cfgetispeed(&termio));
+		CHECK(!(termio.c_lflag & (ICANON | ECHO | ISIG)) && !(termio.c_oflag & OPOST));
+		CHECK(CS8 == (termio.c_cflag & CSIZE) && !(termio.c_cflag & (PARENB | CSTOPB)));
+		CHECK(!!(termio.c_cflag & CRTSCTS) == (MY_FLOW_RTSCTS == flow));
+		CHECK(!!(termio.c_iflag & IXON) == (MY_FLOW_XONXOFF == flow));
+		CHECK(1 == termio.c_cc[VMIN] && 0 == termio.c_cc[VTIME]);
+		close(d);
+	}
+
+	for (unsigned baud: {0u, 12345u}) {
+		errno = 0;
+		CHECK(-1 == mySerialConfig(slave, baud, MY_FLOW_NONE) && EINVAL == errno);
+	}
+	errno = 0;
+	CHECK(-1 == mySerialConfig(slave, 9600, MY_FLOW_XONXOFF + 1) && EINVAL == errno);
+	CHECK(-1 == myOpenSerial("/nonexistent", 9600, MY_FLOW_NONE) && ENOENT == errno);
+	close(slave);
+	close(master);
+}
+
+// copy what each master reads to the other, until one is closed
+static void bridge(int master[2])
+{
+	char buf[256];
+	while (true) {
+		struct pollfd ready[2]{{master[0], POLLIN, 0}, {master[1], POLLIN, 0}};
+		if (-1 == poll(ready, 2, -1))
+			return;
+		for (int i{0}; i < 2; ++i)
+			if (ready[i].revents) {
+				ssize_t n{read(master[i], buf, sizeof(buf))};
+				if (n <= 0 || n != write(master[1 - i], buf, n))
+					return; // EIO once the terminal's side is closed
+			}
+	}
+}
+
+static void transfer()
+{
+	mkdir("src", 0755);
+	testutil::makeFile("src/file", 20000);
+	int master[2], slave[2];
+	for (int i{0}; i < 2; ++i) {
+		CHECK(0 == openpty(&master[i], &slave[i], nullptr, nullptr, nullptr));
+		CHECK(0 == mySerialConfig(slave[i], 115200, MY_FLOW_NONE));
+	}
+	thread medium(bridge, master);
+
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	auto sender{make_shared<SenderY>(vector<const char*>{"src/file"}, slave[0], -1, 1, cfg)};
+	auto receiver{make_shared<ReceiverY>(slave[1], -1, 1, cfg)};
+	sender->beginSendFiles();
+	receiver->beginReceiveFiles();
+	Reactor reactor;
+	reactor.add(sender);
+	reactor.add(receiver);
+	CHECK(0 == reactor.run());
+	CHECK(sender->result == "Done, EndOfSession");
+	CHECK(receiver->result == "Done, EndOfSession");
+	CHECK(contents("file") == contents("src/file"));
+
+	close(slave[0]);
+	close(slave[1]);
+	medium.join();
+	close(master[0]);
+	close(master[1]);
+}
+
+int main()
+{
+	testutil::scratchDir();
+	settings();
+	transfer();
+	return testutil::result();
+}
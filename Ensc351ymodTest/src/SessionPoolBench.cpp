@@ -0,0 +1,85 @@
+//============================================================================
+// File Name   : SessionPoolBench.cpp
+// Description : How SessionPool scales: the same set of transfers on 1 to N
+//               threads.
+//
+// SessionPoolBench [pairs [maxThreads [fileKiB]]]
+//   runs pairs sender/receiver sessions over socket pairs, each sending a
+//   file of fileKiB KiB (default 64 pairs, one thread per core, 16 KiB),
+//   and reports the time and the speedup over one thread.
+//============================================================================
+
+#include <sys/socket.h>
+#include <sys/stat.h>		// for mkdir()
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#include "SessionPool.h"
+#include "SenderY.h"
+#include "ReceiverY.h"
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static double runPool(unsigned threads, const vector<string>& names, int& done)
+{
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	atomic<int> ok{0};
+	auto start{chrono::steady_clock::now()};
+	{
+		SessionPool pool(threads);
+		for (auto& name: names) {
+			int d[2];
+			mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d);
+			auto sender{make_shared<SenderY>(vector<const char*>{name.c_str()}, d[0], -1, 1, cfg)};
+			auto receiver{make_shared<ReceiverY>(d[1], -1, 1, cfg)};
+			sender->beginSendFiles();
+			receiver->beginReceiveFiles();
+			auto count{[&ok](PeerY& peer) {
+				if (peer.result == "Done, EndOfSession")
+					++ok;
+			}};
+			pool.add(sender, count);
+			pool.add(receiver, count);
+		}
+		pool.wait();
+	}
+	done = ok;
+	return testutil::secondsSince(start);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [pairs [maxThreads [fileKiB]]]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	int pairs{argc > 1 ? atoi(argv[1]) : 64};
+	unsigned maxThreads{argc > 2 ? (unsigned) atoi(argv[2]) : thread::hardware_concurrency()};
+	size_t fileKiB{argc > 3 ? (size_t) atoi(argv[3]) : 16};
+
+	// the receivers write into the scratch directory, so the files sent are in src/
+	testutil::scratchDir();
+	mkdir("src", 0755);
+	vector<string> names;
+	for (int i{0}; i < pairs; ++i) {
+		names.push_back("src/f" + to_string(i));
+		testutil::makeFile(names.back(), fileKiB * 1024, i + 1);
+	}
+
+	double oneThread{0};
+	for (unsigned threads{1}; threads <= maxThreads; ++threads) {
+		int ok;
+		double secs{runPool(threads, names, ok)};
+		if (threads == 1)
+			oneThread = secs;
+		printf("%2u threads: %d/%d sessions ok, %.3f s, %.0f KiB/s, speedup %.2f\n",
+			threads, ok, 2 * pairs, secs, pairs * fileKiB / secs, oneThread / secs);
+	}
+	return EXIT_SUCCESS;
+}
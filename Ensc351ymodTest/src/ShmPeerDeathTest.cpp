@@ -0,0 +1,97 @@
+//============================================================================
+// File Name   : ShmPeerDeathTest.cpp
+// Description : A myShmpair() link whose peer process ends without closing
+//               its end: a read, a write and a drain waiting at the other end
+//               must end as if it had been closed, including when the peer
+//               was killed while holding the link's mutex.
+//============================================================================
+
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// fork a child that holds only d[1], and runs child() before ending without closing it
+template<class Child>
+static pid_t peer(int d[2], Child child)
+{
+	pid_t pid{fork()};
+	if (0 == pid) {
+		myClose(d[0]);
+		child();
+		_exit(0);
+	}
+	myClose(d[1]);
+	return pid;
+}
+
+// the child is not waited for until afterwards, so it ends as a zombie
+static void readWriteDrain()
+{
+	int d[2];
+	char buf[10000]{};
+	CHECK(0 == myShmpair(d, 4096));
+	pid_t pid{peer(d, [] {usleep(100000);})};
+	auto start{chrono::steady_clock::now()};
+	CHECK(0 == myReadcond(d[0], buf, 1, 1, 0, 50)); // at most 5 s
+	CHECK(testutil::secondsSince(start) < 1);
+	myClose(d[0]);
+	waitpid(pid, nullptr, 0);
+
+	CHECK(0 == myShmpair(d, 4096));
+	pid = peer(d, [] {usleep(100000);});
+	start = chrono::steady_clock::now();
+	CHECK(4096 == myWrite(d[0], buf, sizeof(buf))); // only what fitted
+	CHECK(testutil::secondsSince(start) < 1);
+	myClose(d[0]);
+	waitpid(pid, nullptr, 0);
+
+	CHECK(0 == myShmpair(d, 4096));
+	pid = peer(d, [] {usleep(100000);});
+	CHECK(100 == myWrite(d[0], buf, 100));
+	start = chrono::steady_clock::now();
+	CHECK(0 == myTcdrain(d[0]));
+	CHECK(testutil::secondsSince(start) < 1);
+	myClose(d[0]);
+	waitpid(pid, nullptr, 0);
+}
+
+// a writer killed at different moments, sometimes while it holds the mutex that the reader needs
+static void killedWriter(int kills)
+{
+	for (int i{0}; i < kills; ++i) {
+		int d[2];
+		CHECK(0 == myShmpair(d, 256));
+		pid_t pid{peer(d, [d] {
+			char buf[64]{};
+			while (true)
+				myWrite(d[1], buf, sizeof(buf));
+		})};
+		auto start{chrono::steady_clock::now()};
+		thread reader([d] {
+			char buf[48];
+			while (myReadcond(d[0], buf, sizeof(buf), 1, 0, 50) > 0)
+				;
+		});
+		usleep(1000 + 500 * i);
+		kill(pid, SIGKILL);
+		reader.join();
+		CHECK(testutil::secondsSince(start) < 2);
+		myClose(d[0]);
+		waitpid(pid, nullptr, 0);
+	}
+}
+
+int main()
+{
+	readWriteDrain();
+	killedWriter(20);
+	return testutil::result();
+}
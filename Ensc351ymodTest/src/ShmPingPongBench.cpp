@@ -0,0 +1,91 @@
+//============================================================================
+// File Name   : ShmPingPongBench.cpp
+// Description : Round trips between two processes over a myShmpair() link,
+//               and over a plain socketpair for comparison.
+//
+// ShmPingPongBench [round trips]
+//   forks a child that echoes a byte round trips times (default 20000).
+//   Each side waits with select() on the descriptor, as the simulator's
+//   Medium and terminals do, then reads the byte with myRead().  It reports
+//   the round trips per second, and that a myReadcond() timeout of 2
+//   deciseconds in the child takes about 200 ms.
+//============================================================================
+
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static void waitIn(int d)
+{
+	fd_set in;
+	FD_ZERO(&in);
+	FD_SET(d, &in);
+	select(d + 1, &in, nullptr, nullptr, nullptr);
+}
+
+// thousands of round trips per second, or -1 on an error
+static double roundTrips(bool shm, int count)
+{
+	int d[2];
+	if (-1 == (shm ? myShmpair(d, 4096) : socketpair(AF_LOCAL, SOCK_STREAM, 0, d)))
+		return -1;
+	char c{0};
+	pid_t pid{fork()};
+	if (0 == pid) {
+		myClose(d[0]);
+		for (int i{0}; i < count; ++i) {
+			waitIn(d[1]);
+			if (1 != myRead(d[1], &c, 1) || 1 != myWrite(d[1], &c, 1))
+				_exit(EXIT_FAILURE);
+		}
+		if (shm) {
+			auto start{chrono::steady_clock::now()};
+			int r{myReadcond(d[1], &c, 1, 1, 0, 2)};
+			printf("  readcond timeout of 2 ds in the child: %d after %.0f ms\n", r,
+				testutil::secondsSince(start) * 1000);
+			fflush(stdout);
+		}
+		myClose(d[1]);
+		_exit(EXIT_SUCCESS);
+	}
+	myClose(d[1]);
+	auto start{chrono::steady_clock::now()};
+	bool ok{true};
+	for (int i{0}; ok && i < count; ++i) {
+		ok = 1 == myWrite(d[0], &c, 1);
+		waitIn(d[0]);
+		ok = ok && 1 == myRead(d[0], &c, 1);
+	}
+	double secs{testutil::secondsSince(start)};
+	int status;
+	waitpid(pid, &status, 0);
+	myClose(d[0]);
+	return ok && WIFEXITED(status) && EXIT_SUCCESS == WEXITSTATUS(status) ? count / secs / 1000 : -1;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [round trips]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	int count{argc > 1 ? atoi(argv[1]) : 20000};
+
+	bool ok{true};
+	for (bool shm: {true, false}) {
+		fflush(stdout);
+		double rate{roundTrips(shm, count)};
+		printf("%-10s %6.1f k round trips/s\n", shm ? "myShmpair" : "socketpair", rate);
+		ok &= rate > 0;
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
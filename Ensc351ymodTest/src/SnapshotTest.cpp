@@ -0,0 +1,126 @@
+//============================================================================
+// File Name   : SnapshotTest.cpp
+// Description : Continuing a transfer from a SessionSnapshot, and restoring
+//               a SmartState machine from a bad snapshot.
+//============================================================================
+
+#include <sys/stat.h>		// for mkdir()
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "yReceiverSS.h"
+#include "CoreLink.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static string contents(const char* name)
+{
+	ifstream in(name);
+	ostringstream all;
+	all << in.rdbuf();
+	return all.str();
+}
+
+// the steps of a CoreLink for a whole transfer of src/a
+static unsigned transferSteps()
+{
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	remove("a");
+	SenderYCore sender({"src/a"}, cfg);
+	ReceiverYCore receiver(cfg);
+	sender.beginSendFiles();
+	receiver.beginReceiveFiles();
+	CoreLink link(sender, receiver);
+	CHECK(link.run());
+	return link.steps;
+}
+
+// run a transfer until the sender can be snapshotted after afterSteps steps, then
+//  continue it with a new sender core restored from the snapshot
+static void continueSender(unsigned afterSteps)
+{
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	remove("a");
+	SenderYCore sender({"src/a"}, cfg);
+	ReceiverYCore receiver(cfg);
+	sender.beginSendFiles();
+	receiver.beginReceiveFiles();
+	CoreLink link(sender, receiver);
+	SessionSnapshot snap;
+	memset(&snap, 0, sizeof(snap));
+	link.afterTick = [&](PeerYCore& core) {
+		return &core == &sender && link.steps >= afterSteps && sender.snapshot(snap);
+	};
+	CHECK(!link.run());
+	CHECK(snap.seq == 2);
+
+	SessionSnapshot copy;
+	CHECK(snap.read(copy));
+
+	// a snapshot that was being taken when its taker died is not used
+	SessionSnapshot torn{snap};
+	torn.seq |= 1;
+	SenderYCore tornSender({"src/a"}, cfg);
+	CHECK(!tornSender.restoreSendFiles(torn, link.now));
+
+	SenderYCore standby({"src/a"}, cfg);
+	standby.setFileHandler(PeerY::fileRequest);
+	CHECK(standby.restoreSendFiles(snap, link.now));
+	CoreLink rest(standby, receiver);
+	rest.now = link.now;
+	CHECK(rest.run());
+	CHECK(standby.result == "Done, EndOfSession");
+	CHECK(receiver.result == "Done, EndOfSession");
+	CHECK(contents("a") == contents("src/a"));
+}
+
+// a bad snapshot leaves a machine as it was
+static void badChartSnapshot()
+{
+	yReceiver_SS::yReceiverSS machine(nullptr, false);
+	int16_t good[64], before[64], after[64];
+	good[0] = 13; // states
+	for (int i{1}; i <= 13; ++i)
+		good[i] = smartstate::eNoState; // no history
+	good[14] = 2; // active states
+	good[15] = yReceiver_SS::eReceiver_TopLevel_yReceiverSS;
+	good[16] = yReceiver_SS::eCAN_Receiver_TopLevel;
+	size_t n{17 * sizeof(int16_t)};
+	machine.restore(good, n);
+	CHECK(machine.isRunning());
+	size_t beforeN{machine.snapshot(before, sizeof(before))};
+
+	int16_t bad[64];
+	memcpy(bad, good, n);
+	bad[3] = 5; // history, valid
+	bad[16] = 99; // but no such state
+	bool threw{false};
+	try {
+		machine.restore(bad, n);
+	}
+	catch (const string&) {
+		threw = true;
+	}
+	CHECK(threw);
+	CHECK(machine.isRunning());
+	size_t afterN{machine.snapshot(after, sizeof(after))};
+	CHECK(afterN == beforeN && !memcmp(before, after, beforeN));
+}
+
+int main()
+{
+	testutil::scratchDir();
+	mkdir("src", 0755);
+	testutil::makeFile("src/a", 5000);
+
+	// from the start of the transfer to near its end
+	unsigned steps{transferSteps()};
+	for (unsigned afterSteps: {1u, steps / 4, steps / 2, steps * 3 / 4})
+		continueSender(afterSteps);
+	badChartSnapshot();
+	return testutil::result();
+}
@@ -0,0 +1,60 @@
+//============================================================================
+// File Name   : SocketReadcondTest.cpp
+// Description : wcsReadcond() on a socketpair:  time is an inter-character
+//               timer, restarted whenever bytes arrive.
+//============================================================================
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+#include "SocketReadcond.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// write a byte to des after each of the gaps (in milliseconds)
+static thread trickle(int des, vector<int> gaps)
+{
+	return thread([des, gaps] {
+		for (int gap: gaps) {
+			this_thread::sleep_for(chrono::milliseconds(gap));
+			CHECK(1 == write(des, "x", 1));
+		}
+	});
+}
+
+int main()
+{
+	int d[2];
+	CHECK(0 == socketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+	char buf[16];
+
+	// bytes 100 ms apart, 500 ms in all, are read within a time of 3 deciseconds
+	auto start{chrono::steady_clock::now()};
+	thread writer{trickle(d[0], {100, 100, 100, 100, 100})};
+	CHECK(5 == wcsReadcond(d[1], buf, sizeof(buf), 5, 3, 3));
+	CHECK(testutil::secondsSince(start) > 0.45);
+	writer.join();
+
+	// a gap longer than time ends the read with what has come
+	start = chrono::steady_clock::now();
+	writer = trickle(d[0], {50, 50, 800});
+	CHECK(2 == wcsReadcond(d[1], buf, sizeof(buf), 5, 3, 3));
+	double secs{testutil::secondsSince(start)};
+	CHECK(secs > 0.35 && secs < 0.7); // 0.1 for the bytes, then 0.3 with nothing
+	writer.join();
+	CHECK(1 == wcsReadcond(d[1], buf, sizeof(buf), 0, 0, 0));
+
+	// with nothing at all, time is waited once
+	start = chrono::steady_clock::now();
+	CHECK(0 == wcsReadcond(d[1], buf, sizeof(buf), 1, 2, 2));
+	secs = testutil::secondsSince(start);
+	CHECK(secs > 0.15 && secs < 0.5);
+
+	close(d[0]);
+	close(d[1]);
+	return testutil::result();
+}
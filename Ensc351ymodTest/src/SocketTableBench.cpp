@@ -0,0 +1,99 @@
+//============================================================================
+// File Name   : SocketTableBench.cpp
+// Description : How the lookup of paired sockets in myIO.cpp holds up as
+//               more threads use it at once.
+//
+// SocketTableBench [seconds [churn]]
+//   for 1, 8 and 64 socket pairs, each used by its own thread, does
+//   myWrite/myReadcond/myDrained/myWrite/myRead round trips for seconds
+//   (default 1) and reports the round trips per second.  With churn
+//   (default 0), another thread keeps making and closing pairs meanwhile,
+//   so that the table changes (and grows) under the readers.
+//============================================================================
+
+#include <sys/socket.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// round trips per second on pairs socket pairs
+static double roundTrips(int pairs, double secs, bool churn, bool& ok)
+{
+	atomic<bool> stop{false};
+	atomic<long long> trips{0};
+	atomic<int> bad{0};
+	vector<thread> threads;
+	for (int p{0}; p < pairs; ++p)
+		threads.emplace_back([&] {
+			int d[2];
+			if (-1 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d)) {
+				++bad;
+				return;
+			}
+			char buf[16]{};
+			long long n{0};
+			while (!stop.load(memory_order_relaxed)) {
+				if (16 != myWrite(d[0], buf, 16) || 16 != myReadcond(d[1], buf, 16, 16, 0, 0)
+						|| -1 == myDrained(d[0]) || 16 != myWrite(d[1], buf, 16)
+						|| 16 != myRead(d[0], buf, 16)) {
+					++bad;
+					break;
+				}
+				++n;
+			}
+			trips += n;
+			myClose(d[0]);
+			myClose(d[1]);
+		});
+	if (churn)
+		threads.emplace_back([&] {
+			vector<int> open;
+			while (!stop.load(memory_order_relaxed)) {
+				int d[2];
+				if (open.size() < 256 && -1 != mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d)) {
+					open.push_back(d[0]);
+					open.push_back(d[1]);
+				}
+				else {
+					for (int des: open)
+						myClose(des);
+					open.clear();
+				}
+			}
+			for (int des: open)
+				myClose(des);
+		});
+
+	auto start{chrono::steady_clock::now()};
+	this_thread::sleep_for(chrono::duration<double>(secs));
+	stop = true;
+	for (auto& t: threads)
+		t.join();
+	ok &= !bad;
+	return trips / testutil::secondsSince(start);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [seconds [churn]]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	double secs{argc > 1 ? atof(argv[1]) : 1.0};
+	bool churn{argc > 2 && atoi(argv[2])};
+
+	printf("%u CPUs%s\n", thread::hardware_concurrency(), churn ? ", pairs made and closed meanwhile" : "");
+	bool ok{true};
+	for (int pairs: {1, 8, 64}) {
+		double rate{roundTrips(pairs, secs, churn, ok)};
+		printf("%2d pairs: %7.0f round trips/s\n", pairs, rate);
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+//============================================================================
+// File Name   : StartupBench.cpp
+// Description : What it costs to set up and tear down the SmartState
+//               machines, and how much reusing one saves.
+//
+// StartupBench [cycles]
+//   constructs and destroys a ySenderSS and a yReceiverSS cycles times
+//   (default 20000), then runs cycles/10 transfers of a small file over
+//   the in-memory medium of CoreLink.h, first with new machines for each
+//   transfer and then with a pair of machines reused (shareChart()).
+//   It reports the time and the heap allocations for each.
+//============================================================================
+
+#include <sys/stat.h>		// for mkdir()
+#include <new>
+#include <chrono>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ySenderSS.h"
+#include "yReceiverSS.h"
+#include "CoreLink.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+static unsigned long allocations{0};
+
+void* operator new(size_t size)
+{
+	++allocations;
+	if (void* p = malloc(size ? size : 1))
+		return p;
+	throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+template<class Machine>
+static void constructions(const char* name, int cycles)
+{
+	unsigned long before{allocations};
+	auto start{chrono::steady_clock::now()};
+	for (int i{0}; i < cycles; ++i)
+		Machine machine(nullptr, false);
+	double secs{testutil::secondsSince(start)};
+	printf("%-12s constructed and destroyed: %6.2f us, %5.1f allocations each\n",
+		name, secs * 1e6 / cycles, (double) (allocations - before) / cycles);
+}
+
+static bool transfers(int count, bool reuse, double& secs, unsigned long& allocs)
+{
+	PeerYConfig cfg;
+	cfg.senderReportInfo = cfg.receiverReportInfo = false;
+	shared_ptr<ySender_SS::ySenderSS> senderSS;
+	shared_ptr<yReceiver_SS::yReceiverSS> receiverSS;
+	bool ok{true};
+	unsigned long before{allocations};
+	auto start{chrono::steady_clock::now()};
+	for (int i{0}; i < count; ++i) {
+		SenderYCore sender({"src/file"}, cfg);
+		ReceiverYCore receiver(cfg);
+		if (reuse) {
+			sender.shareChart(senderSS);
+			receiver.shareChart(receiverSS);
+		}
+		sender.beginSendFiles();
+		receiver.beginReceiveFiles();
+		CoreLink link(sender, receiver);
+		ok &= link.run() && receiver.result == "Done, EndOfSession";
+	}
+	secs = testutil::secondsSince(start);
+	allocs = allocations - before;
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [cycles]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	int cycles{argc > 1 ? atoi(argv[1]) : 20000};
+
+	testutil::scratchDir();
+	mkdir("src", 0755);
+	testutil::makeFile("src/file", 100);
+
+	constructions<ySender_SS::ySenderSS>("ySenderSS", cycles);
+	constructions<yReceiver_SS::yReceiverSS>("yReceiverSS", cycles);
+
+	int count{cycles / 10};
+	bool ok{true};
+	for (bool reuse: {false, true}) {
+		double secs;
+		unsigned long allocs;
+		ok &= transfers(count, reuse, secs, allocs);
+		printf("transfers with %s machines: %6.2f us, %5.1f allocations each\n",
+			reuse ? "reused" : "new   ", secs * 1e6 / count, (double) allocs / count);
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
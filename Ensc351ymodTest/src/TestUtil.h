@@ -0,0 +1,64 @@
+/*
+ * TestUtil.h
+ *
+ * Small helpers shared by the tests and benchmarks in this directory.
+ */
+
+#ifndef TESTUTIL_H_
+#define TESTUTIL_H_
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+// count (and report) a failed check, and carry on
+#define CHECK(condition) \
+	((condition) ? (void) 0 : (void) (++testutil::failures, \
+		std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl))
+
+namespace testutil
+{
+	inline int failures{0};
+
+	// the exit status of a test: 0 if no CHECK() failed
+	inline int result() { return failures ? EXIT_FAILURE : EXIT_SUCCESS; }
+
+	// make a scratch directory and change to it, to be removed at exit.  Returns its name.
+	inline std::string scratchDir()
+	{
+		static char name[]{"/tmp/ymodemXXXXXX"};
+		if (!mkdtemp(name) || -1 == chdir(name)) {
+			perror("scratch directory");
+			exit(EXIT_FAILURE);
+		}
+		atexit([] {
+			std::error_code ignored;
+			std::filesystem::remove_all(name, ignored);
+		});
+		return name;
+	}
+
+	// write a file of size pseudo-random bytes, the same for the same seed
+	inline void makeFile(const std::string& name, size_t size, unsigned seed = 1)
+	{
+		int d{open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+		std::string data(size, '\0');
+		for (auto& c: data)
+			c = (char) ((seed = seed * 1103515245 + 12345) >> 16);
+		if (-1 == d || (ssize_t) size != write(d, data.data(), size) || -1 == close(d)) {
+			perror(name.c_str());
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	inline double secondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+#endif /* TESTUTIL_H_ */
@@ -0,0 +1,144 @@
+//============================================================================
+// File Name   : VectoredIOTest.cpp
+// Description : myWritev(), myReadv() and myReadAvailable() on a socketpair,
+//               on a channel whose ring is smaller than one writev(), and on
+//               a plain pipe: a 4-part writev() read back with 2-part readv()s
+//               and myReadAvailable(), and myTcdrain() and myDrained() still
+//               keeping count of what has been read.
+//============================================================================
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <unistd.h>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <cstring>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+enum Kind { SOCKETPAIR, CHANNEL, PIPE };
+static const char* kindNames[]{"socketpair", "channel", "pipe"};
+
+// d[0] is written to and d[1] read from
+static void makePair(Kind kind, int d[2])
+{
+	if (SOCKETPAIR == kind)
+		CHECK(0 == mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d));
+	else if (CHANNEL == kind)
+		CHECK(0 == myChannelpair(d, 8)); // much smaller than the writev()
+	else {
+		CHECK(0 == pipe(d));
+		swap(d[0], d[1]);
+	}
+}
+
+// wait (at most a second) for d to be readable
+static void waitIn(int d)
+{
+	struct pollfd pfd{d, POLLIN, 0};
+	CHECK(1 == poll(&pfd, 1, 1000));
+}
+
+// read from d into a 2-part iovec, until n bytes have come
+static string readv2(int d, size_t n)
+{
+	string got;
+	while (got.size() < n) {
+		char first[7], second[13];
+		struct iovec iov[]{{first, sizeof(first)}, {second, sizeof(second)}};
+		ssize_t r{myReadv(d, iov, 2)};
+		CHECK(r >= 0);
+		if (r < 0)
+			break;
+		if (0 == r) { // myReadv(), like myRead(), does not wait for data on a pair
+			waitIn(d);
+			continue;
+		}
+		got.append(first, min<size_t>(r, sizeof(first)));
+		if (r > (ssize_t) sizeof(first))
+			got.append(second, r - sizeof(first));
+	}
+	return got;
+}
+
+static void scenario(Kind kind)
+{
+	int d[2];
+	makePair(kind, d);
+	const bool pair{PIPE != kind};
+	char buf[128];
+	CHECK(0 == myReadAvailable(d[1], buf, sizeof(buf))); // nothing yet, without waiting
+	if (pair) {
+		struct iovec iov[]{{buf, 7}, {buf + 7, 13}};
+		CHECK(0 == myReadv(d[1], iov, 2));
+	}
+
+	string data;
+	for (int i{0}; i < 100; ++i)
+		data += (char) ('a' + i % 26);
+	// the writer waits for room in the channel, so it has a thread of its own
+	atomic<bool> drained{false};
+	thread writer([&] {
+		struct iovec iov[]{{&data[0], 10}, {&data[10], 0}, {&data[10], 30}, {&data[40], 60}};
+		CHECK(100 == myWritev(d[0], iov, 4));
+		if (pair)
+			CHECK(0 == myTcdrain(d[0]));
+		drained = true;
+	});
+	this_thread::sleep_for(chrono::milliseconds(50));
+	if (pair)
+		CHECK(!drained && 0 == myDrained(d[0])); // nothing has been read
+
+	string got{readv2(d[1], 20)};
+	while (got.size() < data.size()) {
+		ssize_t r{myReadAvailable(d[1], buf, sizeof(buf))};
+		CHECK(r >= 0);
+		if (r < 0)
+			break;
+		got.append(buf, r);
+		if (!r)
+			waitIn(d[1]); // for the writer
+	}
+	writer.join();
+	CHECK(got == data);
+	CHECK(0 == myReadAvailable(d[1], buf, sizeof(buf)));
+
+	if (pair) {
+		CHECK(1 == myDrained(d[0]));
+		// a drain after a writev() waits for a readv()
+		struct iovec iov[]{{&data[0], 3}, {&data[3], 2}};
+		CHECK(5 == myWritev(d[0], iov, 2));
+		CHECK(0 == myDrained(d[0]));
+		thread reader([&] {
+			this_thread::sleep_for(chrono::milliseconds(50));
+			CHECK(readv2(d[1], 5) == data.substr(0, 5));
+		});
+		auto start{chrono::steady_clock::now()};
+		CHECK(0 == myTcdrain(d[0]));
+		CHECK(testutil::secondsSince(start) > 0.03);
+		reader.join();
+		CHECK(1 == myDrained(d[0]));
+		myClose(d[0]);
+		myClose(d[1]);
+	}
+	else {
+		close(d[0]);
+		close(d[1]);
+	}
+}
+
+int main()
+{
+	for (Kind kind: {SOCKETPAIR, CHANNEL, PIPE}) {
+		int before{testutil::failures};
+		scenario(kind);
+		if (testutil::failures != before)
+			cerr << "  with a " << kindNames[kind] << endl;
+	}
+	return testutil::result();
+}
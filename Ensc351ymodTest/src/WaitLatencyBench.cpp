@@ -0,0 +1,98 @@
+//============================================================================
+// File Name   : WaitLatencyBench.cpp
+// Description : How long a thread blocked in myIO takes to be woken, through
+//               the FutexCond waits (spin, then park on a futex) of myIO.cpp.
+//
+// WaitLatencyBench [round trips]
+//   for a socketpair (mySocketpair), a channel (myChannelpair) and a shared
+//   memory channel (myShmpair), bounces a byte between two threads, round
+//   trips times (default 20000).  Each side blocks in myReadcond() for the
+//   byte (with a timer, as myReadcond() does not wait when time and timeout
+//   are both 0), and the sender then waits in myTcdrain() until it has been read.
+//   It reports the median and 99th percentile of the round trips.
+//============================================================================
+
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+
+#include "myIO.h"
+#include "TestUtil.h"
+
+using namespace std;
+
+// wait for a byte on d.  Return false on an error.
+static bool readByte(int d, char& c)
+{
+	int r;
+	while (0 == (r = myReadcond(d, &c, 1, 1, 10, 10)))
+		;
+	return 1 == r;
+}
+
+// microseconds for each round trip over a pair made by makePair, or an empty vector on an error
+static vector<double> roundTrips(const function<int(int[2])>& makePair, int count)
+{
+	int d[2];
+	if (-1 == makePair(d))
+		return {};
+	bool ok{true};
+	thread echo([&] {
+		char c;
+		for (int i{0}; i < count; ++i)
+			if (!readByte(d[1], c) || 1 != myWrite(d[1], &c, 1) || -1 == myTcdrain(d[1]))
+				ok = false;
+	});
+	vector<double> usecs;
+	usecs.reserve(count);
+	char c{'x'};
+	for (int i{0}; i < count; ++i) {
+		auto start{chrono::steady_clock::now()};
+		if (1 != myWrite(d[0], &c, 1) || -1 == myTcdrain(d[0]) || !readByte(d[0], c)) {
+			ok = false;
+			break;
+		}
+		usecs.push_back(testutil::secondsSince(start) * 1e6);
+	}
+	echo.join();
+	myClose(d[0]);
+	myClose(d[1]);
+	if (!ok)
+		usecs.clear();
+	sort(usecs.begin(), usecs.end());
+	return usecs;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && argv[1][0] == '-') {
+		printf("usage: %s [round trips]\n", argv[0]);
+		return EXIT_SUCCESS;
+	}
+	int count{argc > 1 ? atoi(argv[1]) : 20000};
+
+	struct {
+		const char* name;
+		function<int(int[2])> makePair;
+	} kinds[]{
+		{"socketpair", [](int d[2]) {return mySocketpair(AF_LOCAL, SOCK_STREAM, 0, d);}},
+		{"channel", [](int d[2]) {return myChannelpair(d, 4096);}},
+		{"shm channel", [](int d[2]) {return myShmpair(d, 4096);}},
+	};
+	printf("%u CPUs, %d round trips, in us\n", thread::hardware_concurrency(), count);
+	bool ok{true};
+	for (auto& kind: kinds) {
+		vector<double> usecs{roundTrips(kind.makePair, count)};
+		if (usecs.empty()) {
+			printf("%-12s failed\n", kind.name);
+			ok = false;
+			continue;
+		}
+		printf("%-12s median %6.1f  p99 %6.1f\n", kind.name, usecs[usecs.size() / 2], usecs[usecs.size() * 99 / 100]);
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}